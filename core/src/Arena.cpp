@@ -0,0 +1,243 @@
+/*!
+ * @file Arena.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/Arena.hpp"
+
+#include "include/Logged.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Nextsim {
+
+Arena Arena::main;
+
+Arena& Arena::local()
+{
+    thread_local Arena arena;
+    return arena;
+}
+
+const int Arena::fields;
+const int Arena::physics;
+const int Arena::scratch;
+const std::size_t Arena::hugePageSize;
+
+// Rounds up to a multiple of a power of two
+static std::size_t roundUp(std::size_t size, std::size_t multiple)
+{
+    return (size + multiple - 1) & ~(multiple - 1);
+}
+
+// The first offset in a chunk after its current offset with the given alignment
+std::size_t Arena::alignedOffset(const Chunk& chunk, std::size_t alignment)
+{
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(chunk.base) + chunk.offset;
+    return roundUp(address, alignment) - reinterpret_cast<std::uintptr_t>(chunk.base);
+}
+
+// Allocations are made from the most recent chunk, or from a new chunk
+Arena::Chunk& Arena::chunkFor(Group& grp, std::size_t bytes, std::size_t alignment)
+{
+    if (grp.chunks.empty()
+        || alignedOffset(grp.chunks.back(), alignment) + bytes > grp.chunks.back().size) {
+        grp.chunks.push_back(newChunk(bytes + alignment));
+    }
+    return grp.chunks.back();
+}
+
+Arena::Arena()
+    : m_hugePages(HugePages::NONE)
+    , m_chunkSize(hugePageSize)
+{
+    group("fields");
+    group("physics");
+    group("scratch");
+}
+
+Arena::~Arena()
+{
+    for (auto& grp : m_groups) {
+        for (auto& chunk : grp.chunks) {
+            freeChunk(chunk);
+        }
+    }
+}
+
+void Arena::setChunkSize(std::size_t chunkSize)
+{
+    if (chunkSize == 0) {
+        throw std::invalid_argument("Arena: the chunk size must be greater than zero");
+    }
+    m_chunkSize = chunkSize;
+}
+
+int Arena::group(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < m_groups.size(); ++i) {
+        if (m_groups[i].name == name)
+            return i;
+    }
+    m_groups.push_back({ name, 0, {} });
+    return m_groups.size() - 1;
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment, int group)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Group& grp = m_groups.at(group);
+    if (bytes == 0)
+        bytes = 1;
+
+    Chunk& chunk = chunkFor(grp, bytes, alignment);
+    std::size_t start = alignedOffset(chunk, alignment);
+    chunk.offset = start + bytes;
+    chunk.live += bytes;
+    grp.bytes += bytes;
+    return chunk.base + start;
+}
+
+void Arena::deallocate(void* p, std::size_t bytes, int group)
+{
+    if (!p)
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Group& grp = m_groups.at(group);
+    if (bytes == 0)
+        bytes = 1;
+    char* c = static_cast<char*>(p);
+    // Search from the most recent chunk, which usually holds the memory
+    for (auto iter = grp.chunks.rbegin(); iter != grp.chunks.rend(); ++iter) {
+        Chunk& chunk = *iter;
+        if (c < chunk.base || c >= chunk.base + chunk.size)
+            continue;
+        chunk.live -= bytes;
+        grp.bytes -= bytes;
+        if (chunk.live == 0) {
+            // Reuse the most recent chunk, and return the others to the system
+            if (iter == grp.chunks.rbegin()) {
+                chunk.offset = 0;
+            } else {
+                freeChunk(chunk);
+                grp.chunks.erase(std::next(iter).base());
+            }
+        } else if (c + bytes == chunk.base + chunk.offset) {
+            // The most recent allocation of the chunk
+            chunk.offset = c - chunk.base;
+        }
+        return;
+    }
+    throw std::invalid_argument("Arena: deallocating memory not allocated from the "
+        + grp.name + " group");
+}
+
+void* Arena::reserve(std::size_t bytes, std::size_t alignment, int group)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Chunk& chunk = chunkFor(m_groups.at(group), bytes, alignment);
+    return chunk.base + alignedOffset(chunk, alignment);
+}
+
+std::size_t Arena::bytes(const std::string& group) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& grp : m_groups) {
+        if (grp.name == group)
+            return grp.bytes;
+    }
+    return 0;
+}
+
+std::map<std::string, std::size_t> Arena::report() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::map<std::string, std::size_t> bytesByGroup;
+    for (auto& grp : m_groups) {
+        bytesByGroup[grp.name] = grp.bytes;
+    }
+    return bytesByGroup;
+}
+
+std::size_t Arena::reservedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::size_t total = 0;
+    for (auto& grp : m_groups) {
+        for (auto& chunk : grp.chunks) {
+            total += chunk.size;
+        }
+    }
+    return total;
+}
+
+Arena::Chunk Arena::newChunk(std::size_t minimumSize)
+{
+    std::size_t size = std::max(minimumSize, m_chunkSize);
+#ifdef __linux__
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    HugePages hugePages = m_hugePages;
+#ifdef MAP_HUGETLB
+    if (hugePages == HugePages::EXPLICIT) {
+        std::size_t hugeSize = roundUp(size, hugePageSize);
+        void* mapping = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mapping != MAP_FAILED) {
+            return { static_cast<char*>(mapping), hugeSize, 0, 0, mapping, hugeSize };
+        }
+        Logged::warning("Arena: no explicit huge pages are available. Using transparent huge "
+                        "pages instead.");
+        m_hugePages = hugePages = HugePages::TRANSPARENT;
+    }
+#endif
+    if (hugePages == HugePages::TRANSPARENT) {
+        // Map an extra huge page, so that the chunk can start on a huge page boundary
+        size = roundUp(size, hugePageSize);
+        std::size_t mappedSize = size + hugePageSize;
+        void* mapping = mmap(
+            nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+            throw std::bad_alloc();
+        char* base = reinterpret_cast<char*>(
+            roundUp(reinterpret_cast<std::uintptr_t>(mapping), hugePageSize));
+#ifdef MADV_HUGEPAGE
+        madvise(base, size, MADV_HUGEPAGE);
+#endif
+        return { base, size, 0, 0, mapping, mappedSize };
+    }
+    size = roundUp(size, pageSize);
+    void* mapping
+        = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::bad_alloc();
+    return { static_cast<char*>(mapping), size, 0, 0, mapping, size };
+#else
+    void* mapping = std::malloc(size);
+    if (!mapping)
+        throw std::bad_alloc();
+    return { static_cast<char*>(mapping), size, 0, 0, mapping, size };
+#endif
+}
+
+void Arena::freeChunk(const Chunk& chunk)
+{
+#ifdef __linux__
+    munmap(chunk.mapping, chunk.mappedSize);
+#else
+    std::free(chunk.mapping);
+#endif
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,70 @@
+/*!
+ * @file BitRounding.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/BitRounding.hpp"
+
+#include "include/ThreadTeam.hpp"
+
+#include <stdexcept>
+
+namespace Nextsim {
+
+const int BitRounding::allBits;
+
+BitRounding::BitRounding(int defaultBits)
+    : m_defaultBits(checkBits(defaultBits))
+{
+}
+
+int BitRounding::checkBits(int bits)
+{
+    if (bits < 0 || bits > allBits) {
+        throw std::invalid_argument("BitRounding: the number of bits kept must be between 0 and "
+            + std::to_string(allBits));
+    }
+    return bits;
+}
+
+void BitRounding::setKeepBits(const std::string& variable, int bits)
+{
+    // Checked before the map entry is created, so that a failure leaves no entry
+    const int checked = checkBits(bits);
+    m_bits[variable] = checked;
+}
+
+int BitRounding::keepBits(const std::string& variable) const
+{
+    auto iter = m_bits.find(variable);
+    return (iter == m_bits.end()) ? m_defaultBits : iter->second;
+}
+
+bool BitRounding::isLossless() const
+{
+    if (m_defaultBits < allBits)
+        return false;
+    for (auto& variable : m_bits) {
+        if (variable.second < allBits)
+            return false;
+    }
+    return true;
+}
+
+void BitRounding::round(
+    const std::string& variable, double* values, std::size_t n, ThreadTeam& team) const
+{
+    const int bits = keepBits(variable);
+    if (bits >= allBits)
+        return;
+    team.run([values, n, bits, &team](int thread) {
+        auto range = ThreadTeam::block(n, thread, team.nThreads());
+        for (std::size_t i = range.first; i < range.second; ++i) {
+            values[i] = round(values[i], bits);
+        }
+    });
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,117 @@
+/*!
+ * @file Coarsening.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/Coarsening.hpp"
+
+#include "include/ThreadTeam.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nextsim {
+
+Coarsening::Coarsening(int factor, Method method)
+    : m_factor(factor)
+    , m_method(method)
+    , m_xStart(0)
+    , m_nxLocal(0)
+    , m_nx(0)
+    , m_ny(0)
+{
+    if (factor < 1) {
+        throw std::invalid_argument("Coarsening: the factor must be at least one");
+    }
+}
+
+Coarsening::Method Coarsening::methodFromString(const std::string& name)
+{
+    if (name == "mean") {
+        return Method::MEAN;
+    } else if (name == "subsample") {
+        return Method::SUBSAMPLE;
+    }
+    throw std::invalid_argument("Coarsening: unknown method " + name);
+}
+
+void Coarsening::coarsen(const ElementVector& data, int xStart, int nxLocal, int nx, int ny,
+    const LandMask* mask, ThreadTeam& team)
+{
+    const int xEnd = xStart + nxLocal;
+    if (xStart % m_factor != 0 || (xEnd % m_factor != 0 && xEnd != nx)) {
+        throw std::invalid_argument(
+            "Coarsening: the rows held by this process are not whole blocks of "
+            + std::to_string(m_factor) + " rows");
+    }
+    if (mask && (mask->nxLocal() != nxLocal || mask->ny() != ny)) {
+        throw std::invalid_argument("Coarsening: the land mask is not that of the rows held");
+    }
+    m_xStart = xStart / m_factor;
+    m_nxLocal = coarseSize(nxLocal);
+    m_nx = coarseSize(nx);
+    m_ny = coarseSize(ny);
+
+    if (m_fields.empty()) {
+        for (auto& field : FieldRegistry::fields()) {
+            if (field.group != FieldRegistry::Group::EXTERNAL)
+                m_fields.push_back({ &field, 1, {} });
+        }
+    }
+    for (auto& field : m_fields) {
+        field.nLayers = FieldRegistry::view(data, field.description->name).nLayers();
+        field.values.resize(std::size_t(m_nxLocal) * m_ny * field.nLayers);
+    }
+
+    // Each thread reduces whole coarse rows, reading the elements of its own
+    // block of fine rows
+    team.run([this, &data, nxLocal, ny, mask, &team](int thread) {
+        auto rows = ThreadTeam::block(m_nxLocal, thread, team.nThreads());
+        for (auto& field : m_fields) {
+            FieldView<const double> view = FieldRegistry::view(data, field.description->name);
+            for (std::size_t cx = rows.first; cx < rows.second; ++cx) {
+                const int x0 = cx * m_factor;
+                const int x1 = std::min(x0 + m_factor, nxLocal);
+                for (int cy = 0; cy < m_ny; ++cy) {
+                    const int y0 = cy * m_factor;
+                    const int y1 = std::min(y0 + m_factor, ny);
+                    double* coarse = &field.values[(cx * m_ny + cy) * field.nLayers];
+                    for (int layer = 0; layer < field.nLayers; ++layer) {
+                        if (m_method == Method::SUBSAMPLE) {
+                            const std::size_t cell = std::size_t(x0) * ny + y0;
+                            if (mask && !mask->isOcean(cell)) {
+                                coarse[layer] = LandMask::fillValue();
+                            } else {
+                                coarse[layer] = view(mask ? mask->element(cell) : cell, layer);
+                            }
+                            continue;
+                        }
+                        double sum = 0.;
+                        int nOcean = 0;
+                        for (int x = x0; x < x1; ++x) {
+                            for (int y = y0; y < y1; ++y) {
+                                const std::size_t cell = std::size_t(x) * ny + y;
+                                if (mask && !mask->isOcean(cell))
+                                    continue;
+                                sum += view(mask ? mask->element(cell) : cell, layer);
+                                ++nOcean;
+                            }
+                        }
+                        coarse[layer] = (nOcean > 0) ? sum / nOcean : LandMask::fillValue();
+                    }
+                }
+            }
+        }
+    });
+}
+
+void Coarsening::round(const BitRounding& rounding, ThreadTeam& team)
+{
+    for (auto& field : m_fields) {
+        rounding.round(field.description->name, field.values.data(), field.values.size(), team);
+    }
+}
+
+} /* namespace Nextsim */
@@ -7,17 +7,32 @@
 
 #include "include/DevGridIO.hpp"
 
+#include "include/Coarsening.hpp"
 #include "include/DevGrid.hpp"
 #include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
 #include "include/IStructure.hpp"
+#include "include/LandMask.hpp"
+#include "include/RestartSnapshot.hpp"
+#include "include/Statistics.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <ncDim.h>
 #include <ncDouble.h>
 #include <ncFile.h>
+#include <ncInt.h>
+#include <ncUint.h>
 #include <ncVar.h>
 
+#ifdef USE_MPI
+#include <mpi.h>
+#include <netcdf.h>
+#include <netcdf_par.h>
+#endif
+
 #include <map>
+#include <stdexcept>
 #include <vector>
 
 namespace Nextsim {
@@ -32,38 +47,121 @@ enum class StringName {
     Z_DIM,
 };
 
-std::string hiceName = "hice";
-std::string ciceName = "cice";
-std::string hsnowName = "hsnow";
-std::string ticeName = "tice";
-std::string sstName = "sst";
-std::string sssName = "sss";
-
 typedef std::map<StringName, std::string> NameMap;
 
-void initGroup(std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap);
-void dumpGroup(const std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap);
+void initGroup(ElementVector& data, ModelContext& context, LandMask& mask, netCDF::NcGroup& grp,
+    const NameMap& nameMap);
+void dumpGroup(const ElementVector& data, const LandMask& mask, netCDF::NcGroup& grp,
+    const NameMap& nameMap);
+
+static const std::string unitsAttributeName = "units";
+static const std::string ticeName = "tice";
+static const std::string maskName = "mask";
+static const std::string windowStartName = "window_start";
+static const std::string windowEndName = "window_end";
+static const std::string samplesName = "samples";
+static const std::string lowerName = "lower_bound";
+static const std::string upperName = "upper_bound";
+static const std::string factorName = "coarsening_factor";
+static const std::string methodName = "coarsening_method";
+
+static std::string methodString(Coarsening::Method method)
+{
+    return (method == Coarsening::Method::MEAN) ? "mean" : "subsample";
+}
+
+// Compresses an output variable, shuffling the bytes of the values so that
+// the zero bits left by bit rounding are contiguous
+static void compress(netCDF::NcVar& var, int deflateLevel)
+{
+    if (deflateLevel > 0)
+        var.setCompression(true, true, deflateLevel);
+}
+
+// Gives the land cells of an output variable the fill value
+static void fillLand(netCDF::NcVar& var, const LandMask& mask)
+{
+    if (!mask.allOcean())
+        var.setFill(true, LandMask::fillValue());
+}
 
-// See https://isocpp.org/wiki/faq/pointers-to-members#macro-for-ptr-to-memfn
-#define CALL_MEMBER_FN(object, ptrToMember) ((object).*(ptrToMember))
+// Writes the land mask of a grid with land
+static void dumpMask(
+    netCDF::NcGroup& group, const std::vector<netCDF::NcDim>& dims, const LandMask& mask)
+{
+    if (mask.allOcean())
+        return;
+    netCDF::NcVar var(group.addVar(maskName, netCDF::ncInt, dims));
+    var.putAtt(unitsAttributeName, "1");
+    var.putVar(mask.values().data());
+}
 
-// pointer to a member of PrognosticData that takes no arguments and returns a
-// double. See https://isocpp.org/wiki/faq/pointers-to-members#typedef-for-ptr-to-memfn
-typedef double (PrognosticData::*ProgDoubleFn)() const;
+// Returns the values of the cells of the rows held, from the contiguous values
+// of the elements, nValues for each. Land cells are given the fill value.
+template <typename T>
+static const T* cellValues(
+    const LandMask& mask, const T* elements, int nValues, std::vector<T>& cells, T fill)
+{
+    if (mask.allOcean())
+        return elements;
+    cells.resize(mask.nCells() * nValues);
+    mask.scatter(elements, nValues, nValues, cells.data(), fill);
+    return cells.data();
+}
+
+// The names and units of the variables of the statistics of a field
+struct StatisticsNames {
+    StatisticsNames(const FieldStatistics& statistics)
+        : mean(statistics.name() + "_mean")
+        , variance(statistics.name() + "_variance")
+        , minimum(statistics.name() + "_min")
+        , maximum(statistics.name() + "_max")
+        , histogram(statistics.name() + "_histogram")
+        , bins(statistics.name() + "_bins")
+        , units(FieldRegistry::field(statistics.name()).units)
+        , varianceUnits((units == "1") ? units : "(" + units + ")2")
+        , layered(FieldRegistry::field(statistics.name()).dimensions
+              == FieldRegistry::Dimensions::LAYERED)
+    {
+    }
+    std::string mean;
+    std::string variance;
+    std::string minimum;
+    std::string maximum;
+    std::string histogram;
+    std::string bins;
+    std::string units;
+    std::string varianceUnits;
+    bool layered;
+};
 
-// Map between variable names and retrieval functions
-// See https://isocpp.org/wiki/faq/pointers-to-members#array-memfnptrs
-// clang-format off
-static const std::map<std::string, ProgDoubleFn> variableFunctions
-= {    { hiceName, &PrognosticData::iceThickness },
-       { ciceName, &PrognosticData::iceConcentration },
-       { hsnowName, &PrognosticData::snowThickness },
-       { sstName, &PrognosticData::seaSurfaceTemperature },
-       { sssName, &PrognosticData::seaSurfaceSalinity } };
-// clang-format on
+// The netCDF start, count, stride and memory map vectors which read or write
+// a field in place in an array of nxLocal × nx ElementData, which holds the x
+// indices starting from xStart.
+struct StridedAccess {
+    StridedAccess(int xStart, int nxLocal, int nLayers, bool layered)
+        : start({ std::size_t(xStart), 0 })
+        , count({ std::size_t(nxLocal), std::size_t(DevGrid::nx) })
+        , stride(layered ? 3 : 2, 1)
+        , imap({ DevGrid::nx * FieldView<double>::elementStride, FieldView<double>::elementStride })
+    {
+        if (layered) {
+            start.push_back(0);
+            count.push_back(nLayers);
+            imap.push_back(1);
+        }
+    }
+    std::vector<std::size_t> start;
+    std::vector<std::size_t> count;
+    std::vector<std::ptrdiff_t> stride;
+    std::vector<std::ptrdiff_t> imap;
+};
 
-void DevGridIO::init(std::vector<ElementData>& data, const std::string& filePath) const
+void DevGridIO::init(ElementVector& data, const std::string& filePath) const
 {
+#ifdef USE_MPI
+    initParallel(data, filePath);
+#else
     NameMap nameMap = {
         { StringName::METADATA_NODE, IStructure::metadataNodeName() },
         { StringName::DATA_NODE, IStructure::dataNodeName() },
@@ -73,12 +171,16 @@ void DevGridIO::init(std::vector<ElementData>& data, const std::string& filePath
         { StringName::Z_DIM, DevGrid::nIceLayersName },
     };
     netCDF::NcFile ncFile(filePath, netCDF::NcFile::read);
-    initGroup(data, ncFile, nameMap);
+    initGroup(data, grid->context(), grid->m_mask, ncFile, nameMap);
     ncFile.close();
+#endif
 }
 
-void DevGridIO::dump(const std::vector<ElementData>& data, const std::string& filePath) const
+void DevGridIO::dump(const ElementVector& data, const std::string& filePath) const
 {
+#ifdef USE_MPI
+    dumpParallel(data, filePath);
+#else
     NameMap nameMap = {
         { StringName::METADATA_NODE, IStructure::metadataNodeName() },
         { StringName::DATA_NODE, IStructure::dataNodeName() },
@@ -88,125 +190,673 @@ void DevGridIO::dump(const std::vector<ElementData>& data, const std::string& fi
         { StringName::Z_DIM, DevGrid::nIceLayersName },
     };
     netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
-    dumpGroup(data, ncFile, nameMap);
+    dumpGroup(data, grid->landMask(), ncFile, nameMap);
     ncFile.close();
+#endif
 }
 
-void initMeta(std::vector<ElementData>& data, const netCDF::NcGroup& metaGroup)
+void DevGridIO::dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const
 {
+#ifdef USE_MPI
+    dumpSnapshotParallel(snapshot, filePath);
+#else
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
+    netCDF::NcGroup metaGroup = ncFile.addGroup(IStructure::metadataNodeName());
+    netCDF::NcGroup dataGroup = ncFile.addGroup(IStructure::dataNodeName());
+    metaGroup.putAtt(IStructure::typeNodeName(), DevGrid::structureName);
+
     int nx = DevGrid::nx;
-    data.resize(nx * nx);
+    netCDF::NcDim xDim = dataGroup.addDim(DevGrid::xDimName, nx);
+    netCDF::NcDim yDim = dataGroup.addDim(DevGrid::yDimName, nx);
+    netCDF::NcDim zDim = dataGroup.addDim(DevGrid::nIceLayersName, grid->nIceLayers());
+    const LandMask& mask = grid->landMask();
+    dumpMask(dataGroup, { xDim, yDim }, mask);
+
+    // The snapshot fields are held contiguously in the element order of the grid
+    std::vector<double> cells;
+    for (auto& field : snapshot.fields()) {
+        std::vector<netCDF::NcDim> dims = { xDim, yDim };
+        if (field.description->dimensions == FieldRegistry::Dimensions::LAYERED)
+            dims.push_back(zDim);
+        netCDF::NcVar var(dataGroup.addVar(field.description->name, netCDF::ncDouble, dims));
+        fillLand(var, mask);
+        var.putAtt(unitsAttributeName, field.description->units);
+        var.putVar(cellValues(
+            mask, field.values.data(), field.nLayers, cells, LandMask::fillValue()));
+    }
+    ncFile.close();
+#endif
 }
 
-void initData(std::vector<ElementData>& data, const netCDF::NcGroup& dataGroup)
+void DevGridIO::dumpStatistics(
+    const Statistics& statistics, const std::string& filePath, int deflateLevel) const
 {
-    // Get the number of ice layers from the ice temperature data
-    const int layersDim = 2;
-    int nLayers = dataGroup.getVar(ticeName).getDim(layersDim).getSize();
+#ifdef USE_MPI
+    dumpStatisticsParallel(statistics, filePath, deflateLevel);
+#else
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
+    ncFile.putAtt(windowStartName, netCDF::ncInt, statistics.completedStart());
+    ncFile.putAtt(windowEndName, netCDF::ncInt, statistics.completedEnd());
+
     int nx = DevGrid::nx;
-    for (int i = 0; i < nx; ++i) {
-        for (int j = 0; j < nx; ++j) {
-            int linearIndex = i * nx + j;
-            double hice;
-            double cice;
-            double hsnow;
-            double sst;
-            double sss;
-            std::vector<std::size_t> loc = { std::size_t(i), std::size_t(j) };
-            dataGroup.getVar(hiceName).getVar(loc, &hice);
-            dataGroup.getVar(ciceName).getVar(loc, &cice);
-            dataGroup.getVar(hsnowName).getVar(loc, &hsnow);
-            dataGroup.getVar(sstName).getVar(loc, &sst);
-            dataGroup.getVar(sssName).getVar(loc, &sss);
-            // Retrieve ice temperature data
-
-            std::vector<double> tice(nLayers);
-            for (int l = 0; l < nLayers; ++l) {
-                std::vector<std::size_t> loc3 = { loc[0], loc[1], std::size_t(l) };
-                dataGroup.getVar(ticeName).getVar(loc3, &tice[l]);
-            }
-            data[linearIndex]
-                = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(hsnow).tice(
-                    tice);
+    netCDF::NcDim xDim = ncFile.addDim(DevGrid::xDimName, nx);
+    netCDF::NcDim yDim = ncFile.addDim(DevGrid::yDimName, nx);
+    netCDF::NcDim zDim = ncFile.addDim(DevGrid::nIceLayersName, grid->nIceLayers());
+    const LandMask& mask = grid->landMask();
+
+    // The statistics are held contiguously in the element order of the grid
+    std::vector<double> cells;
+    std::vector<std::uint32_t> counts;
+    for (auto& field : statistics.completed()) {
+        if (field.count() == 0)
+            continue;
+        StatisticsNames names(field);
+        std::vector<netCDF::NcDim> dims = { xDim, yDim };
+        if (names.layered)
+            dims.push_back(zDim);
+
+        const std::vector<std::pair<std::string, const double*>> moments = {
+            { names.mean, field.meanData() },
+            { names.variance, field.varianceData() },
+            { names.minimum, field.minimumData() },
+            { names.maximum, field.maximumData() },
+        };
+        for (auto& moment : moments) {
+            netCDF::NcVar var(ncFile.addVar(moment.first, netCDF::ncDouble, dims));
+            compress(var, deflateLevel);
+            fillLand(var, mask);
+            var.putAtt(unitsAttributeName,
+                (moment.first == names.variance) ? names.varianceUnits : names.units);
+            var.putAtt(samplesName, netCDF::ncInt, int(field.count()));
+            var.putVar(
+                cellValues(mask, moment.second, field.nLayers(), cells, LandMask::fillValue()));
+        }
+        if (field.hasHistogram()) {
+            dims.push_back(ncFile.addDim(names.bins, field.bins().nBins));
+            netCDF::NcVar var(ncFile.addVar(names.histogram, netCDF::ncUint, dims));
+            compress(var, deflateLevel);
+            var.putAtt(unitsAttributeName, "1");
+            var.putAtt(lowerName, netCDF::ncDouble, field.bins().lower);
+            var.putAtt(upperName, netCDF::ncDouble, field.bins().upper);
+            // Land cells have no counts
+            var.putVar(cellValues(mask, field.histogramData(),
+                field.nLayers() * field.bins().nBins, counts, std::uint32_t(0)));
         }
     }
+    ncFile.close();
+#endif
+}
+
+void DevGridIO::coarsen(const ElementVector& data, Coarsening& coarsening) const
+{
+    coarsening.coarsen(data, grid->xStart(), grid->nxLocal(), DevGrid::nx, DevGrid::nx,
+        &grid->landMask(), grid->context().threadTeam());
+}
+
+void DevGridIO::dumpCoarsened(
+    const Coarsening& coarsening, const std::string& filePath, int deflateLevel) const
+{
+#ifdef USE_MPI
+    dumpCoarsenedParallel(coarsening, filePath, deflateLevel);
+#else
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
+    ncFile.putAtt(factorName, netCDF::ncInt, coarsening.factor());
+    ncFile.putAtt(methodName, methodString(coarsening.method()));
 
-    for (auto fnNamePair : variableFunctions) {
-        const std::string& name = fnNamePair.first;
-        netCDF::NcVar var(dataGroup.getVar(name));
+    netCDF::NcDim xDim = ncFile.addDim(DevGrid::xDimName, coarsening.nx());
+    netCDF::NcDim yDim = ncFile.addDim(DevGrid::yDimName, coarsening.ny());
+    netCDF::NcDim zDim = ncFile.addDim(DevGrid::nIceLayersName, grid->nIceLayers());
+
+    // The coarsened fields are held contiguously in the order of the dimensions
+    for (auto& field : coarsening.fields()) {
+        std::vector<netCDF::NcDim> dims = { xDim, yDim };
+        if (field.description->dimensions == FieldRegistry::Dimensions::LAYERED)
+            dims.push_back(zDim);
+        netCDF::NcVar var(ncFile.addVar(field.description->name, netCDF::ncDouble, dims));
+        compress(var, deflateLevel);
+        fillLand(var, grid->landMask());
+        var.putAtt(unitsAttributeName, field.description->units);
+        var.putVar(field.values.data());
     }
+    ncFile.close();
+#endif
 }
 
-void initGroup(std::vector<ElementData>& data, netCDF::NcGroup& grp, const NameMap& nameMap)
+// Get the number of ice layers from the ice temperature data
+int nIceLayers(const netCDF::NcGroup& dataGroup)
 {
-    netCDF::NcGroup metaGroup(grp.getGroup(nameMap.at(StringName::METADATA_NODE)));
-    netCDF::NcGroup dataGroup(grp.getGroup(nameMap.at(StringName::DATA_NODE)));
+    const int layersDim = 2;
+    return dataGroup.getVar(ticeName).getDim(layersDim).getSize();
+}
 
-    initMeta(data, metaGroup);
-    initData(data, dataGroup);
+// Reads the land mask of the grid, which has no land if the file has no mask
+LandMask initMask(const netCDF::NcGroup& dataGroup)
+{
+    int nx = DevGrid::nx;
+    netCDF::NcVar var = dataGroup.getVar(maskName);
+    if (var.isNull())
+        return LandMask(nx, nx);
+    std::vector<int> ocean(nx * nx);
+    var.getVar(ocean.data());
+    return LandMask(nx, nx, ocean);
 }
 
-void dumpMeta(
-    const std::vector<ElementData>& data, netCDF::NcGroup& metaGroup, const NameMap& nameMap)
+void initMeta(ElementVector& data, ModelContext& context, const LandMask& mask,
+    const netCDF::NcGroup& metaGroup, int nLayers)
 {
-    metaGroup.putAtt(IStructure::typeNodeName(), nameMap.at(StringName::STRUCTURE));
+    allocateElements(data, mask.nOcean(), nLayers, context);
 }
 
-/*
- * Uses a pointer-to-member-function to access the data in PrognosticData
- * element by element. Please see the references in the comments associated
- * with ProgDoubleFn and CALL_MEMBER_FN for more details.
- */
-std::vector<double> gather(const std::vector<ElementData>& data, ProgDoubleFn pFunc)
+// Reads the prognostic fields into the element data, directly if the grid
+// has no land
+void initData(ElementVector& data, const LandMask& mask, const netCDF::NcGroup& dataGroup)
 {
-    std::vector<double> gathered(data.size());
-    for (int i = 0; i < data.size(); ++i) {
-        gathered[i] = CALL_MEMBER_FN(data[i], pFunc)();
+    int nx = DevGrid::nx;
+    std::vector<double> cells;
+    for (auto& field : FieldRegistry::fields()) {
+        if (field.group != FieldRegistry::Group::PROGNOSTIC)
+            continue;
+        FieldView<double> view = FieldRegistry::mutableView(data, field.name);
+        bool layered = field.dimensions == FieldRegistry::Dimensions::LAYERED;
+        if (mask.allOcean()) {
+            StridedAccess access(0, nx, view.nLayers(), layered);
+            dataGroup.getVar(field.name).getVar(
+                access.start, access.count, access.stride, access.imap, view.data());
+        } else {
+            int nValues = layered ? view.nLayers() : 1;
+            cells.resize(mask.nCells() * nValues);
+            dataGroup.getVar(field.name).getVar(cells.data());
+            mask.gather(cells.data(), nValues, view.data(), FieldView<double>::elementStride);
+        }
     }
-    return gathered;
 }
 
-void dumpData(
-    const std::vector<ElementData>& data, netCDF::NcGroup& dataGroup, const NameMap& nameMap)
+void initGroup(ElementVector& data, ModelContext& context, LandMask& mask, netCDF::NcGroup& grp,
+    const NameMap& nameMap)
+{
+    netCDF::NcGroup metaGroup(grp.getGroup(nameMap.at(StringName::METADATA_NODE)));
+    netCDF::NcGroup dataGroup(grp.getGroup(nameMap.at(StringName::DATA_NODE)));
+
+    mask = initMask(dataGroup);
+    initMeta(data, context, mask, metaGroup, nIceLayers(dataGroup));
+    initData(data, mask, dataGroup);
+}
+
+void dumpMeta(const ElementVector& data, netCDF::NcGroup& metaGroup, const NameMap& nameMap)
+{
+    metaGroup.putAtt(IStructure::typeNodeName(), nameMap.at(StringName::STRUCTURE));
+}
+
+// Writes the prognostic and diagnostic fields from the element data, directly
+// if the grid has no land
+void dumpData(const ElementVector& data, const LandMask& mask, netCDF::NcGroup& dataGroup,
+    const NameMap& nameMap)
 {
     int nx = DevGrid::nx;
     // Create the dimension data, since it has to be in the same group as the
     // data or the parent group
     netCDF::NcDim xDim = dataGroup.addDim(nameMap.at(StringName::X_DIM), nx);
     netCDF::NcDim yDim = dataGroup.addDim(nameMap.at(StringName::Y_DIM), nx);
+    // A grid entirely of land has no elements from which to take the layers
+    int nLayers = data.empty() ? 1 : data[0].nIceLayers();
+    netCDF::NcDim zDim = dataGroup.addDim(nameMap.at(StringName::Z_DIM), nLayers);
 
     std::vector<netCDF::NcDim> dims2 = { xDim, yDim };
-    for (auto fnNamePair : variableFunctions) {
-        const std::string& name = fnNamePair.first;
-        netCDF::NcVar var(dataGroup.addVar(name, netCDF::ncDouble, dims2));
-        std::vector<double> gathered = gather(data, variableFunctions.at(name));
-        var.putVar(gathered.data());
-    }
-
-    int nLayers = data[0].nIceLayers();
-    netCDF::NcDim zDim = dataGroup.addDim(nameMap.at(StringName::Z_DIM), nLayers);
     std::vector<netCDF::NcDim> dims3 = { xDim, yDim, zDim };
-    netCDF::NcVar iceT(dataGroup.addVar(ticeName, netCDF::ncDouble, dims3));
-
-    // Gather the three dimensional data explicitly (until there is more than
-    // one three dimensional dataset).
-    std::vector<double> tice(data.size() * nLayers);
-    for (int i = 0; i < data.size(); ++i) {
-        int ii = nLayers * i;
-        for (int l = 0; l < nLayers; ++l) {
-            tice[ii + l] = data[i].iceTemperature(l);
+    dumpMask(dataGroup, dims2, mask);
+    std::vector<double> cells;
+    for (auto& field : FieldRegistry::fields()) {
+        if (field.group != FieldRegistry::Group::PROGNOSTIC)
+            continue;
+        bool layered = field.dimensions == FieldRegistry::Dimensions::LAYERED;
+        netCDF::NcVar var(dataGroup.addVar(field.name, netCDF::ncDouble, layered ? dims3 : dims2));
+        fillLand(var, mask);
+        var.putAtt(unitsAttributeName, field.units);
+        FieldView<const double> view = FieldRegistry::view(data, field.name);
+        if (mask.allOcean()) {
+            StridedAccess access(0, nx, view.nLayers(), layered);
+            var.putVar(access.start, access.count, access.stride, access.imap, view.data());
+        } else {
+            int nValues = layered ? nLayers : 1;
+            cells.resize(mask.nCells() * nValues);
+            mask.scatter(view.data(), FieldView<const double>::elementStride, nValues,
+                cells.data(), LandMask::fillValue());
+            var.putVar(cells.data());
         }
     }
-    iceT.putVar(tice.data());
 }
 
-void dumpGroup(
-    const std::vector<ElementData>& data, netCDF::NcGroup& headGroup, const NameMap& nameMap)
+void dumpGroup(const ElementVector& data, const LandMask& mask, netCDF::NcGroup& headGroup,
+    const NameMap& nameMap)
 {
     netCDF::NcGroup metaGroup = headGroup.addGroup(nameMap.at(StringName::METADATA_NODE));
     netCDF::NcGroup dataGroup = headGroup.addGroup(nameMap.at(StringName::DATA_NODE));
     dumpMeta(data, metaGroup, nameMap);
-    dumpData(data, dataGroup, nameMap);
+    dumpData(data, mask, dataGroup, nameMap);
+}
+
+#ifdef USE_MPI
+// Throws if a netCDF C library call has failed
+static void checkNC(int status, const std::string& what)
+{
+    if (status != NC_NOERR) {
+        throw std::runtime_error("DevGridIO: " + what + ": " + nc_strerror(status));
+    }
+}
+
+// Compresses an output variable, as compress() does for serial output
+static void compressParallel(int ncid, int varId, int deflateLevel, const std::string& name)
+{
+    if (deflateLevel > 0)
+        checkNC(nc_def_var_deflate(ncid, varId, 1, 1, deflateLevel), "compressing " + name);
+}
+
+// Returns whether the rows of any rank include land
+static bool anyLand(const LandMask& mask)
+{
+    int localLand = mask.allOcean() ? 0 : 1;
+    int land;
+    MPI_Allreduce(&localLand, &land, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    return land != 0;
+}
+
+// Gives the land cells of an output variable the fill value, as fillLand() does
+static void fillLandParallel(int ncid, int varId, bool hasLand, const std::string& name)
+{
+    if (!hasLand)
+        return;
+    double fill = LandMask::fillValue();
+    checkNC(nc_def_var_fill(ncid, varId, NC_FILL, &fill), "filling " + name);
+}
+
+// Defines the land mask variable of a grid with land
+static int defineMaskParallel(int ncid, const int* dims)
+{
+    int varId;
+    checkNC(nc_def_var(ncid, maskName.c_str(), NC_INT, 2, dims, &varId), maskName);
+    checkNC(nc_put_att_text(ncid, varId, unitsAttributeName.c_str(), 1, "1"), maskName);
+    return varId;
+}
+
+// Writes the land mask of this rank's rows, collectively
+static void dumpMaskParallel(int ncid, int varId, const DevGrid& grid)
+{
+    const std::size_t start[2] = { std::size_t(grid.xStart()), 0 };
+    const std::size_t count[2] = { std::size_t(grid.nxLocal()), std::size_t(DevGrid::nx) };
+    checkNC(nc_var_par_access(ncid, varId, NC_COLLECTIVE), maskName);
+    checkNC(nc_put_vara_int(ncid, varId, start, count, grid.landMask().values().data()),
+        "writing " + maskName);
+}
+
+// Reads the prognostic fields of this rank's rows of the grid, collectively
+void DevGridIO::initParallel(ElementVector& data, const std::string& filePath) const
+{
+    int ncid;
+    checkNC(nc_open_par(filePath.c_str(), NC_NOWRITE, MPI_COMM_WORLD, MPI_INFO_NULL, &ncid),
+        "opening " + filePath);
+    int dataGrp;
+    checkNC(nc_inq_grp_ncid(ncid, IStructure::dataNodeName().c_str(), &dataGrp), "data group");
+
+    // The number of ice layers from the ice temperature data
+    int ticeId;
+    checkNC(nc_inq_varid(dataGrp, ticeName.c_str(), &ticeId), ticeName);
+    int dimIds[3];
+    checkNC(nc_inq_vardimid(dataGrp, ticeId, dimIds), ticeName);
+    std::size_t nLayers;
+    checkNC(nc_inq_dimlen(dataGrp, dimIds[2], &nLayers), ticeName);
+
+    // The land mask of this rank's rows, without land if the file has no mask
+    const std::size_t start[3] = { std::size_t(grid->xStart()), 0, 0 };
+    std::size_t count[3] = { std::size_t(grid->nxLocal()), std::size_t(DevGrid::nx), 1 };
+    int maskId;
+    if (nc_inq_varid(dataGrp, maskName.c_str(), &maskId) == NC_NOERR) {
+        std::vector<int> ocean(count[0] * count[1]);
+        checkNC(nc_var_par_access(dataGrp, maskId, NC_COLLECTIVE), maskName);
+        checkNC(nc_get_vara_int(dataGrp, maskId, start, count, ocean.data()),
+            "reading " + maskName);
+        grid->m_mask = LandMask(grid->nxLocal(), DevGrid::nx, ocean);
+    } else {
+        grid->m_mask = LandMask(grid->nxLocal(), DevGrid::nx);
+    }
+    const LandMask& mask = grid->m_mask;
+
+    allocateElements(data, mask.nOcean(), nLayers, grid->context());
+
+    std::vector<double> cells;
+    for (auto& field : FieldRegistry::fields()) {
+        if (field.group != FieldRegistry::Group::PROGNOSTIC)
+            continue;
+        FieldView<double> view = FieldRegistry::mutableView(data, field.name);
+        bool layered = field.dimensions == FieldRegistry::Dimensions::LAYERED;
+        int varId;
+        checkNC(nc_inq_varid(dataGrp, field.name.c_str(), &varId), field.name);
+        checkNC(nc_var_par_access(dataGrp, varId, NC_COLLECTIVE), field.name);
+        if (mask.allOcean()) {
+            StridedAccess access(grid->xStart(), grid->nxLocal(), layered ? nLayers : 1, layered);
+            checkNC(nc_get_varm_double(dataGrp, varId, access.start.data(), access.count.data(),
+                        access.stride.data(), access.imap.data(), view.data()),
+                "reading " + field.name);
+        } else {
+            count[2] = layered ? nLayers : 1;
+            cells.resize(mask.nCells() * count[2]);
+            checkNC(nc_get_vara_double(dataGrp, varId, start, count, cells.data()),
+                "reading " + field.name);
+            mask.gather(cells.data(), int(count[2]), view.data(), FieldView<double>::elementStride);
+        }
+    }
+    checkNC(nc_close(ncid), "closing " + filePath);
+}
+
+// Writes the fields of this rank's rows of the grid, collectively
+void DevGridIO::dumpParallel(const ElementVector& data, const std::string& filePath) const
+{
+    int ncid;
+    checkNC(nc_create_par(filePath.c_str(), NC_CLOBBER | NC_NETCDF4, MPI_COMM_WORLD,
+                MPI_INFO_NULL, &ncid),
+        "creating " + filePath);
+    int metaGrp;
+    int dataGrp;
+    checkNC(nc_def_grp(ncid, IStructure::metadataNodeName().c_str(), &metaGrp), "metadata group");
+    checkNC(nc_def_grp(ncid, IStructure::dataNodeName().c_str(), &dataGrp), "data group");
+
+    const std::string& typeName = DevGrid::structureName;
+    checkNC(nc_put_att_text(metaGrp, NC_GLOBAL, IStructure::typeNodeName().c_str(),
+                typeName.size(), typeName.c_str()),
+        "structure type");
+
+    // Ranks holding no rows have no layer information of their own
+    int localLayers = data.empty() ? 0 : data.front().nIceLayers();
+    int nLayers;
+    MPI_Allreduce(&localLayers, &nLayers, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    int xDim;
+    int yDim;
+    int zDim;
+    checkNC(nc_def_dim(dataGrp, DevGrid::xDimName.c_str(), DevGrid::nx, &xDim), "x dimension");
+    checkNC(nc_def_dim(dataGrp, DevGrid::yDimName.c_str(), DevGrid::nx, &yDim), "y dimension");
+    checkNC(nc_def_dim(dataGrp, DevGrid::nIceLayersName.c_str(), nLayers, &zDim), "z dimension");
+    const int dims[3] = { xDim, yDim, zDim };
+
+    const LandMask& mask = grid->landMask();
+    const bool hasLand = anyLand(mask);
+    int maskId = hasLand ? defineMaskParallel(dataGrp, dims) : 0;
+
+    std::vector<const FieldRegistry::Field*> fields;
+    std::vector<int> varIds;
+    for (auto& field : FieldRegistry::fields()) {
+        if (field.group != FieldRegistry::Group::PROGNOSTIC)
+            continue;
+        bool layered = field.dimensions == FieldRegistry::Dimensions::LAYERED;
+        int varId;
+        checkNC(nc_def_var(dataGrp, field.name.c_str(), NC_DOUBLE, layered ? 3 : 2, dims, &varId),
+            field.name);
+        fillLandParallel(dataGrp, varId, hasLand, field.name);
+        checkNC(nc_put_att_text(dataGrp, varId, unitsAttributeName.c_str(), field.units.size(),
+                    field.units.c_str()),
+            field.name);
+        fields.push_back(&field);
+        varIds.push_back(varId);
+    }
+    checkNC(nc_enddef(ncid), "defining " + filePath);
+
+    if (hasLand)
+        dumpMaskParallel(dataGrp, maskId, *grid);
+    std::vector<double> cells;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        const FieldRegistry::Field& field = *fields[i];
+        FieldView<const double> view = FieldRegistry::view(data, field.name);
+        bool layered = field.dimensions == FieldRegistry::Dimensions::LAYERED;
+        checkNC(nc_var_par_access(dataGrp, varIds[i], NC_COLLECTIVE), field.name);
+        if (mask.allOcean()) {
+            StridedAccess access(grid->xStart(), grid->nxLocal(), layered ? nLayers : 1, layered);
+            checkNC(nc_put_varm_double(dataGrp, varIds[i], access.start.data(),
+                        access.count.data(), access.stride.data(), access.imap.data(),
+                        view.data()),
+                "writing " + field.name);
+        } else {
+            const std::size_t start[3] = { std::size_t(grid->xStart()), 0, 0 };
+            const std::size_t count[3] = { std::size_t(grid->nxLocal()),
+                std::size_t(DevGrid::nx), std::size_t(layered ? nLayers : 1) };
+            cells.resize(mask.nCells() * count[2]);
+            mask.scatter(view.data(), FieldView<const double>::elementStride, int(count[2]),
+                cells.data(), LandMask::fillValue());
+            checkNC(nc_put_vara_double(dataGrp, varIds[i], start, count, cells.data()),
+                "writing " + field.name);
+        }
+    }
+    checkNC(nc_close(ncid), "closing " + filePath);
+}
+
+// Writes a snapshot of the fields of this rank's rows of the grid, collectively
+void DevGridIO::dumpSnapshotParallel(
+    const RestartSnapshot& snapshot, const std::string& filePath) const
+{
+    int ncid;
+    checkNC(nc_create_par(filePath.c_str(), NC_CLOBBER | NC_NETCDF4, MPI_COMM_WORLD,
+                MPI_INFO_NULL, &ncid),
+        "creating " + filePath);
+    int metaGrp;
+    int dataGrp;
+    checkNC(nc_def_grp(ncid, IStructure::metadataNodeName().c_str(), &metaGrp), "metadata group");
+    checkNC(nc_def_grp(ncid, IStructure::dataNodeName().c_str(), &dataGrp), "data group");
+
+    const std::string& typeName = DevGrid::structureName;
+    checkNC(nc_put_att_text(metaGrp, NC_GLOBAL, IStructure::typeNodeName().c_str(),
+                typeName.size(), typeName.c_str()),
+        "structure type");
+
+    int localLayers = grid->nIceLayers();
+    int nLayers;
+    MPI_Allreduce(&localLayers, &nLayers, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    int dims[3];
+    checkNC(nc_def_dim(dataGrp, DevGrid::xDimName.c_str(), DevGrid::nx, &dims[0]), "x dimension");
+    checkNC(nc_def_dim(dataGrp, DevGrid::yDimName.c_str(), DevGrid::nx, &dims[1]), "y dimension");
+    checkNC(nc_def_dim(dataGrp, DevGrid::nIceLayersName.c_str(), nLayers, &dims[2]), "z dimension");
+
+    const LandMask& mask = grid->landMask();
+    const bool hasLand = anyLand(mask);
+    int maskId = hasLand ? defineMaskParallel(dataGrp, dims) : 0;
+
+    std::vector<int> varIds;
+    for (auto& field : snapshot.fields()) {
+        const std::string& name = field.description->name;
+        const std::string& units = field.description->units;
+        bool layered = field.description->dimensions == FieldRegistry::Dimensions::LAYERED;
+        int varId;
+        checkNC(nc_def_var(dataGrp, name.c_str(), NC_DOUBLE, layered ? 3 : 2, dims, &varId), name);
+        fillLandParallel(dataGrp, varId, hasLand, name);
+        checkNC(nc_put_att_text(
+                    dataGrp, varId, unitsAttributeName.c_str(), units.size(), units.c_str()),
+            name);
+        varIds.push_back(varId);
+    }
+    checkNC(nc_enddef(ncid), "defining " + filePath);
+
+    if (hasLand)
+        dumpMaskParallel(dataGrp, maskId, *grid);
+    std::vector<double> cells;
+    for (std::size_t i = 0; i < varIds.size(); ++i) {
+        const RestartSnapshot::Field& field = snapshot.fields()[i];
+        bool layered = field.description->dimensions == FieldRegistry::Dimensions::LAYERED;
+        std::vector<std::size_t> start = { std::size_t(grid->xStart()), 0, 0 };
+        std::vector<std::size_t> count = { std::size_t(grid->nxLocal()),
+            std::size_t(DevGrid::nx), std::size_t(layered ? field.nLayers : 1) };
+        checkNC(nc_var_par_access(dataGrp, varIds[i], NC_COLLECTIVE), field.description->name);
+        checkNC(nc_put_vara_double(dataGrp, varIds[i], start.data(), count.data(),
+                    cellValues(mask, field.values.data(), field.nLayers, cells,
+                        LandMask::fillValue())),
+            "writing " + field.description->name);
+    }
+    checkNC(nc_close(ncid), "closing " + filePath);
+}
+
+// Writes the statistics of this rank's rows of the grid, collectively
+void DevGridIO::dumpStatisticsParallel(
+    const Statistics& statistics, const std::string& filePath, int deflateLevel) const
+{
+    int ncid;
+    checkNC(nc_create_par(filePath.c_str(), NC_CLOBBER | NC_NETCDF4, MPI_COMM_WORLD,
+                MPI_INFO_NULL, &ncid),
+        "creating " + filePath);
+    int windowStart = statistics.completedStart();
+    int windowEnd = statistics.completedEnd();
+    checkNC(nc_put_att_int(ncid, NC_GLOBAL, windowStartName.c_str(), NC_INT, 1, &windowStart),
+        windowStartName);
+    checkNC(nc_put_att_int(ncid, NC_GLOBAL, windowEndName.c_str(), NC_INT, 1, &windowEnd),
+        windowEndName);
+
+    int localLayers = grid->nIceLayers();
+    int nLayers;
+    MPI_Allreduce(&localLayers, &nLayers, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    int dims[4];
+    checkNC(nc_def_dim(ncid, DevGrid::xDimName.c_str(), DevGrid::nx, &dims[0]), "x dimension");
+    checkNC(nc_def_dim(ncid, DevGrid::yDimName.c_str(), DevGrid::nx, &dims[1]), "y dimension");
+    checkNC(nc_def_dim(ncid, DevGrid::nIceLayersName.c_str(), nLayers, &dims[2]), "z dimension");
+
+    const LandMask& mask = grid->landMask();
+    const bool hasLand = anyLand(mask);
+
+    // The variables of each field: mean, variance, minimum, maximum, histogram
+    const int nMoments = 4;
+    std::vector<const FieldStatistics*> fields;
+    std::vector<std::vector<int>> varIds;
+    for (auto& field : statistics.completed()) {
+        if (field.count() == 0)
+            continue;
+        StatisticsNames names(field);
+        int nDims = names.layered ? 3 : 2;
+        int fieldDims[4] = { dims[0], dims[1], dims[2], dims[2] };
+        const std::string varNames[nMoments]
+            = { names.mean, names.variance, names.minimum, names.maximum };
+        const int samples = field.count();
+        std::vector<int> ids;
+        for (int m = 0; m < nMoments; ++m) {
+            int varId;
+            checkNC(nc_def_var(ncid, varNames[m].c_str(), NC_DOUBLE, nDims, fieldDims, &varId),
+                varNames[m]);
+            compressParallel(ncid, varId, deflateLevel, varNames[m]);
+            fillLandParallel(ncid, varId, hasLand, varNames[m]);
+            const std::string& units = (m == 1) ? names.varianceUnits : names.units;
+            checkNC(nc_put_att_text(
+                        ncid, varId, unitsAttributeName.c_str(), units.size(), units.c_str()),
+                varNames[m]);
+            checkNC(nc_put_att_int(ncid, varId, samplesName.c_str(), NC_INT, 1, &samples),
+                varNames[m]);
+            ids.push_back(varId);
+        }
+        if (field.hasHistogram()) {
+            checkNC(nc_def_dim(ncid, names.bins.c_str(), field.bins().nBins, &fieldDims[nDims]),
+                names.bins);
+            int varId;
+            checkNC(nc_def_var(
+                        ncid, names.histogram.c_str(), NC_UINT, nDims + 1, fieldDims, &varId),
+                names.histogram);
+            compressParallel(ncid, varId, deflateLevel, names.histogram);
+            checkNC(nc_put_att_text(ncid, varId, unitsAttributeName.c_str(), 1, "1"),
+                names.histogram);
+            checkNC(nc_put_att_double(
+                        ncid, varId, lowerName.c_str(), NC_DOUBLE, 1, &field.bins().lower),
+                names.histogram);
+            checkNC(nc_put_att_double(
+                        ncid, varId, upperName.c_str(), NC_DOUBLE, 1, &field.bins().upper),
+                names.histogram);
+            ids.push_back(varId);
+        }
+        fields.push_back(&field);
+        varIds.push_back(ids);
+    }
+    checkNC(nc_enddef(ncid), "defining " + filePath);
+
+    std::vector<double> cells;
+    std::vector<std::uint32_t> counts;
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        const FieldStatistics& field = *fields[i];
+        // The statistics are held contiguously in the element order of the grid
+        std::vector<std::size_t> start = { std::size_t(grid->xStart()), 0, 0, 0 };
+        std::vector<std::size_t> count
+            = { std::size_t(grid->nxLocal()), std::size_t(DevGrid::nx),
+                  std::size_t(field.nLayers()), std::size_t(field.bins().nBins) };
+        if (!StatisticsNames(field).layered) {
+            start.erase(start.begin() + 2);
+            count.erase(count.begin() + 2);
+        }
+        const double* moments[nMoments] = { field.meanData(), field.varianceData(),
+            field.minimumData(), field.maximumData() };
+        for (int m = 0; m < nMoments; ++m) {
+            checkNC(nc_var_par_access(ncid, varIds[i][m], NC_COLLECTIVE), field.name());
+            checkNC(nc_put_vara_double(ncid, varIds[i][m], start.data(), count.data(),
+                        cellValues(mask, moments[m], field.nLayers(), cells,
+                            LandMask::fillValue())),
+                "writing " + field.name());
+        }
+        if (field.hasHistogram()) {
+            checkNC(nc_var_par_access(ncid, varIds[i][nMoments], NC_COLLECTIVE), field.name());
+            // Land cells have no counts
+            checkNC(nc_put_vara_uint(ncid, varIds[i][nMoments], start.data(), count.data(),
+                        cellValues(mask, field.histogramData(),
+                            field.nLayers() * field.bins().nBins, counts, std::uint32_t(0))),
+                "writing " + field.name());
+        }
+    }
+    checkNC(nc_close(ncid), "closing " + filePath);
+}
+
+// Writes the coarsened fields of this rank's rows of the grid, collectively
+void DevGridIO::dumpCoarsenedParallel(
+    const Coarsening& coarsening, const std::string& filePath, int deflateLevel) const
+{
+    int ncid;
+    checkNC(nc_create_par(filePath.c_str(), NC_CLOBBER | NC_NETCDF4, MPI_COMM_WORLD,
+                MPI_INFO_NULL, &ncid),
+        "creating " + filePath);
+    int factor = coarsening.factor();
+    checkNC(nc_put_att_int(ncid, NC_GLOBAL, factorName.c_str(), NC_INT, 1, &factor), factorName);
+    const std::string method = methodString(coarsening.method());
+    checkNC(nc_put_att_text(ncid, NC_GLOBAL, methodName.c_str(), method.size(), method.c_str()),
+        methodName);
+
+    int localLayers = grid->nIceLayers();
+    int nLayers;
+    MPI_Allreduce(&localLayers, &nLayers, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    int dims[3];
+    checkNC(nc_def_dim(ncid, DevGrid::xDimName.c_str(), coarsening.nx(), &dims[0]), "x dimension");
+    checkNC(nc_def_dim(ncid, DevGrid::yDimName.c_str(), coarsening.ny(), &dims[1]), "y dimension");
+    checkNC(nc_def_dim(ncid, DevGrid::nIceLayersName.c_str(), nLayers, &dims[2]), "z dimension");
+
+    const bool hasLand = anyLand(grid->landMask());
+
+    std::vector<int> varIds;
+    for (auto& field : coarsening.fields()) {
+        const std::string& name = field.description->name;
+        const std::string& units = field.description->units;
+        bool layered = field.description->dimensions == FieldRegistry::Dimensions::LAYERED;
+        int varId;
+        checkNC(nc_def_var(ncid, name.c_str(), NC_DOUBLE, layered ? 3 : 2, dims, &varId), name);
+        compressParallel(ncid, varId, deflateLevel, name);
+        fillLandParallel(ncid, varId, hasLand, name);
+        checkNC(nc_put_att_text(
+                    ncid, varId, unitsAttributeName.c_str(), units.size(), units.c_str()),
+            name);
+        varIds.push_back(varId);
+    }
+    checkNC(nc_enddef(ncid), "defining " + filePath);
+
+    for (std::size_t i = 0; i < varIds.size(); ++i) {
+        const Coarsening::Field& field = coarsening.fields()[i];
+        bool layered = field.description->dimensions == FieldRegistry::Dimensions::LAYERED;
+        std::vector<std::size_t> start = { std::size_t(coarsening.xStart()), 0, 0 };
+        std::vector<std::size_t> count = { std::size_t(coarsening.nxLocal()),
+            std::size_t(coarsening.ny()), std::size_t(layered ? nLayers : 1) };
+        checkNC(nc_var_par_access(ncid, varIds[i], NC_COLLECTIVE), field.description->name);
+        checkNC(nc_put_vara_double(ncid, varIds[i], start.data(), count.data(),
+                    field.values.data()),
+            "writing " + field.description->name);
+    }
+    checkNC(nc_close(ncid), "closing " + filePath);
 }
+#endif
 
 } /* namespace Nextsim */
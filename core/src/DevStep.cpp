@@ -6,20 +6,155 @@
  */
 
 #include "include/DevStep.hpp"
+#include "include/FieldRegistry.hpp"
 #include "include/IPrognosticUpdater.hpp"
 #include "include/PrognosticData.hpp"
+#include "include/Reduction.hpp"
+#include "include/ThreadTeam.hpp"
+
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 
 namespace Nextsim {
 
+const std::string DevStep::forcingStage = "forcing";
+const std::string DevStep::physicsStage = "physics";
+const std::string DevStep::diagnosticsStage = "diagnostics";
+const std::string DevStep::outputStage = "output";
+const std::string DevStep::checkpointStage = "checkpoint";
+
+// Same timestep and previous timestep dependencies of the standard stages
+typedef std::pair<std::vector<std::string>, std::vector<std::string>> Dependencies;
+static const std::map<std::string, Dependencies> standardDependencies = {
+    // The forcing of the next timestep may change the elements only once the
+    // diagnostics, such as the fluxes sent to a coupled partner, are complete
+    { DevStep::forcingStage, { {}, { DevStep::physicsStage, DevStep::diagnosticsStage } } },
+    { DevStep::physicsStage,
+        { { DevStep::forcingStage },
+            { DevStep::diagnosticsStage, DevStep::checkpointStage } } },
+    { DevStep::diagnosticsStage, { { DevStep::physicsStage }, { DevStep::outputStage } } },
+    { DevStep::outputStage, { { DevStep::diagnosticsStage }, {} } },
+    { DevStep::checkpointStage, { { DevStep::physicsStage }, {} } },
+};
+
+DevStep::DevStep()
+    : pStructure(nullptr)
+    , m_startTime(0)
+    , m_dt(0)
+    , m_stepsDone(0)
+    , m_fused(false)
+    , m_budget({ 0, 0, 0, 0 })
+{
+    addStage(physicsStage, [this](int) { iterate(m_dt); });
+
+    // The passes of the fused calculation. The tiles may be run concurrently
+    // by the threads of the ThreadTeam of the model, so each thread has its
+    // own columns, reused for all of its tiles so that no tile allocates.
+    m_tiling.addPass([](const Tiling::Tile& tile) {
+        PrognosticData::updateFreezingPoints(tile);
+        thread_local std::vector<IPhysics1d::Column> columns;
+        columns.clear();
+        for (ElementData* pData : tile) {
+            columns.push_back(pData->physicsColumn());
+        }
+        columns.front().impl->calculateFused(columns);
+    });
+    m_tiling.addPass([](const Tiling::Tile& tile) {
+        for (ElementData* pData : tile) {
+            pData->updateAndIntegrate(*pData);
+        }
+    });
+}
+
+void DevStep::addStage(const std::string& name, const TaskGraph::Stage& stage)
+{
+    auto iter = standardDependencies.find(name);
+    if (iter == standardDependencies.end()) {
+        throw std::invalid_argument("DevStep: unknown standard stage (" + name + ")");
+    }
+    // The messages of each stage are stamped with the time of its own timestep
+    m_stages.addStage(name,
+        [this, stage](int step) {
+            setModelTime(stepTime(step));
+            stage(step);
+        },
+        iter->second.first, iter->second.second);
+}
+
 void DevStep::iterate(const Iterator::Duration& dt)
 {
-    PrognosticData::setTimestep(dt);
-    for (pStructure->cursor = 0; pStructure->cursor; ++pStructure->cursor) {
-        auto& data = *pStructure->cursor;
-        data.updateDerivedData(data, data, data);
-        data.calculate(data, data, data);
-        data.updateAndIntegrate(data);
+    pStructure->context().setTimestep(dt);
+    if (m_fused) {
+        m_tiling.run(*pStructure);
+        return;
+    }
+    Tiling::elements(*pStructure, m_elements);
+    // Each thread of the team calculates its block of the elements, the same
+    // block as was used to first touch the memory of the elements
+    ThreadTeam& team = pStructure->context().threadTeam();
+    m_blocks.resize(team.nThreads());
+    team.run([this, &team](int thread) {
+        auto items = ThreadTeam::block(m_elements.size(), thread, team.nThreads());
+        Block& block = m_blocks[thread];
+        block.elements.assign(m_elements.begin() + items.first, m_elements.begin() + items.second);
+        iterateModular(block);
+    });
+}
+
+void DevStep::iterateModular(Block& block)
+{
+    block.columns.clear();
+    PrognosticData::updateFreezingPoints(block.elements);
+    for (ElementData* pData : block.elements) {
+        pData->updateDerivedData(*pData, *pData, *pData);
+        block.columns.push_back(pData->physicsColumn());
+    }
+    // Calculate the physics of all the elements of the block as a single batch
+    if (!block.columns.empty()) {
+        block.columns.front().impl->calculate(block.columns);
+    }
+    for (ElementData* pData : block.elements) {
+        pData->updateAndIntegrate(*pData);
     }
 }
 
+void DevStep::updateBudget()
+{
+    ElementVector* storage = pStructure->elementStorage();
+    if (!storage) {
+        throw std::runtime_error(
+            "DevStep: the budget requires a structure holding its elements contiguously");
+    }
+    // All the budget terms in a single pass and a single reduction
+    std::vector<double> totals = Reduction::fieldAreaIntegrals(*pStructure,
+        {
+            FieldRegistry::view(*storage, "hice"),
+            FieldRegistry::view(*storage, "hsnow"),
+            FieldRegistry::view(*storage, "cice"),
+            FieldRegistry::view(*storage, "qoce"),
+        });
+    m_budget.iceVolume = totals[0];
+    m_budget.snowVolume = totals[1];
+    m_budget.iceArea = totals[2];
+    m_budget.oceanHeatFlux = totals[3];
+
+    if (isEnabled(DEBUG)) {
+        std::stringstream message;
+        message << std::setprecision(17) << "Budget: ice volume " << m_budget.iceVolume
+                << " m3, snow volume " << m_budget.snowVolume << " m3, ice area "
+                << m_budget.iceArea << " m2, ocean heat flux " << m_budget.oceanHeatFlux << " W";
+        debug(message.str());
+    }
+}
+
+void DevStep::iterateSteps(const Iterator::Duration& dt, int nSteps)
+{
+    m_dt = dt;
+    m_stages.run(nSteps);
+    m_stepsDone += nSteps;
+}
+
 } /* namespace Nextsim */
@@ -6,17 +6,57 @@
 
 #include "include/ElementData.hpp"
 
+#include <cstddef>
+#include <memory>
+
 namespace Nextsim {
+
+// Returns the physics instance of the context, creating it on first use. The
+// instance of any context but the default has a configuration of its own.
+static IPhysics1d& physicsPrototype(ModelContext& context)
+{
+    if (!context.physics()) {
+        std::shared_ptr<IPhysics1d> physics(
+            ModuleLoader::getLoader().getInstance<IPhysics1d>().release());
+        if (&context != &ModelContext::defaultContext()) {
+            physics->detachContext();
+        }
+        context.setPhysics(physics);
+    }
+    return *context.physics();
+}
+
+// Constructs a new physics implementation instance in the physics group of
+// the main arena, or on the heap if the implementation does not support it
+static ElementData::PhysicsPtr newPhysicsImpl(ModelContext& context)
+{
+    const IPhysics1d& implementation = physicsPrototype(context);
+    std::size_t size = implementation.instanceSize();
+    if (size == 0) {
+        return ElementData::PhysicsPtr(
+            ModuleLoader::getLoader().getInstance<IPhysics1d>().release(),
+            Arena::Deleter { nullptr, 0, 0 });
+    }
+    void* storage = Arena::main.allocate(size, alignof(std::max_align_t), Arena::physics);
+    return ElementData::PhysicsPtr(implementation.constructAt(storage),
+        Arena::Deleter { &Arena::main, size, Arena::physics });
+}
+
 ElementData::ElementData()
     : ElementData(1)
 {
 }
 
 ElementData::ElementData(int nIceLayers)
-    : PrognosticData(nIceLayers)
+    : ElementData(nIceLayers, ModelContext::defaultContext())
+{
+}
+
+ElementData::ElementData(int nIceLayers, ModelContext& context)
+    : PrognosticData(nIceLayers, context)
     , PhysicsData(nIceLayers)
 {
-    m_physicsImplData = std::move(ModuleLoader::getLoader().getInstance<IPhysics1d>());
+    m_physicsImplData = newPhysicsImpl(context);
 }
 //! Copy constructor
 ElementData::ElementData(const ElementData& src)
@@ -24,7 +64,7 @@ ElementData::ElementData(const ElementData& src)
     *this = static_cast<PrognosticData>(src);
     *this = static_cast<ExternalData>(src);
     *this = static_cast<PhysicsData>(src);
-    this->m_physicsImplData = std::move(ModuleLoader::getLoader().getInstance<IPhysics1d>());
+    this->m_physicsImplData = newPhysicsImpl(context());
     *(this->m_physicsImplData) = *(src.m_physicsImplData);
 }
 
@@ -46,7 +86,7 @@ ElementData& ElementData::operator=(ElementData other)
     *this = static_cast<PrognosticData>(other);
     *this = static_cast<ExternalData>(other);
     *this = static_cast<PhysicsData>(other);
-    this->m_physicsImplData = std::move(ModuleLoader::getLoader().getInstance<IPhysics1d>());
+    this->m_physicsImplData = newPhysicsImpl(context());
     *(this->m_physicsImplData) = *(other.m_physicsImplData);
 
     return *this;
@@ -71,7 +111,7 @@ ElementData& ElementData::operator=(ElementData&& other)
 void ElementData::configure()
 {
     PrognosticData::configure();
-    Nextsim::tryConfigure(&ModuleLoader::getLoader().getImplementation<IPhysics1d>());
+    Nextsim::tryConfigure(&physicsPrototype(context()));
 }
 
 void ElementData::updateDerivedData(
@@ -86,4 +126,26 @@ void ElementData::calculate(
     m_physicsImplData->calculate(prog, exter, phys);
 }
 
+void allocateElements(ElementVector& data, int nElements, int nLayers, ModelContext& context)
+{
+    // Release the old storage, so that the reserved storage is untouched
+    ElementVector().swap(data);
+    data.reserve(nElements);
+    ThreadTeam& team = context.threadTeam();
+    team.firstTouch(data.data(), nElements, sizeof(ElementData));
+    // The physics instances of the elements are allocated in sequence from the
+    // physics group, so their memory is first touched in the same blocks
+    std::size_t physicsSize = physicsPrototype(context).instanceSize();
+    if (physicsSize > 0) {
+        const std::size_t alignment = alignof(std::max_align_t);
+        std::size_t stride = (physicsSize + alignment - 1) / alignment * alignment;
+        team.firstTouch(Arena::main.reserve(nElements * stride, alignment, Arena::physics),
+            nElements, stride);
+    }
+    // Construct in place, as ElementData assignment is ambiguous
+    for (int i = 0; i < nElements; ++i) {
+        data.emplace_back(nLayers, context);
+    }
+}
+
 } /* namespace Nextsim */
@@ -0,0 +1,121 @@
+/*!
+ * @file FieldRegistry.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/FieldRegistry.hpp"
+
+#include <mutex>
+#include <stdexcept>
+
+namespace Nextsim {
+
+typedef FieldRegistry::Group Group;
+typedef FieldRegistry::Dimensions Dimensions;
+
+// Serializes add() and freeze(), so that no field is being added once the
+// registry is frozen
+static std::mutex addMutex;
+static bool frozen = false;
+
+// clang-format off
+FieldRegistry::FieldList& FieldRegistry::registry()
+{
+    static FieldList fieldList = {
+        { "hice", "m", Dimensions::HORIZONTAL, Group::PROGNOSTIC,
+            [](const ElementData& e) { return &e.iceThickness(); } },
+        { "cice", "1", Dimensions::HORIZONTAL, Group::PROGNOSTIC,
+            [](const ElementData& e) { return &e.iceConcentration(); } },
+        { "hsnow", "m", Dimensions::HORIZONTAL, Group::PROGNOSTIC,
+            [](const ElementData& e) { return &e.snowThickness(); } },
+        { "sst", "degC", Dimensions::HORIZONTAL, Group::PROGNOSTIC,
+            [](const ElementData& e) { return &e.seaSurfaceTemperature(); } },
+        { "sss", "PSU", Dimensions::HORIZONTAL, Group::PROGNOSTIC,
+            [](const ElementData& e) { return &e.seaSurfaceSalinity(); } },
+        { "tice", "degC", Dimensions::LAYERED, Group::PROGNOSTIC,
+            [](const ElementData& e) { return &e.iceTemperature(0); } },
+        { "tair", "degC", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.airTemperature(); } },
+        { "dew2m", "degC", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.dewPoint2m(); } },
+        { "pair", "Pa", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.airPressure(); } },
+        { "mixrat", "kg kg-1", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.ExternalData::mixingRatio(); } },
+        { "sw_in", "W m-2", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.incomingShortwave(); } },
+        { "lw_in", "W m-2", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.incomingLongwave(); } },
+        { "mld", "m", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.mixedLayerDepth(); } },
+        { "snowfall", "kg m-2 s-1", Dimensions::HORIZONTAL, Group::EXTERNAL,
+            [](const ElementData& e) { return &e.snowfall(); } },
+        { "qoce", "W m-2", Dimensions::HORIZONTAL, Group::DIAGNOSTIC,
+            [](const ElementData& e) { return &e.oceanHeatFlux(); } },
+    };
+    return fieldList;
+}
+// clang-format on
+
+const FieldRegistry::FieldList& FieldRegistry::fields() { return registry(); }
+
+const FieldRegistry::Field& FieldRegistry::field(const std::string& name)
+{
+    for (const Field& f : registry()) {
+        if (f.name == name)
+            return f;
+    }
+    throw std::out_of_range("FieldRegistry: no field named " + name);
+}
+
+void FieldRegistry::add(const Field& field)
+{
+    std::lock_guard<std::mutex> lock(addMutex);
+    if (frozen)
+        throw std::logic_error("FieldRegistry: field " + field.name
+            + " added after a model was configured");
+    for (const Field& f : registry()) {
+        if (f.name == field.name)
+            throw std::invalid_argument("FieldRegistry: duplicate field " + field.name);
+    }
+    registry().push_back(field);
+}
+
+void FieldRegistry::freeze()
+{
+    std::lock_guard<std::mutex> lock(addMutex);
+    frozen = true;
+}
+
+// The number of layers of the field in the data
+static int fieldLayers(const FieldRegistry::Field& f, const ElementVector& data)
+{
+    return (f.dimensions == Dimensions::LAYERED) ? data.front().nIceLayers() : 1;
+}
+
+FieldView<const double> FieldRegistry::view(const ElementVector& data, const std::string& name)
+{
+    const Field& f = field(name);
+    if (data.empty())
+        return FieldView<const double>(nullptr, 0, 0);
+    return FieldView<const double>(f.storage(data.front()), data.size(), fieldLayers(f, data));
+}
+
+FieldView<double> FieldRegistry::mutableView(ElementVector& data, const std::string& name)
+{
+    const Field& f = field(name);
+    if (data.empty())
+        return FieldView<double>(nullptr, 0, 0);
+    if (f.group == Group::EXTERNAL) {
+        for (ElementData& element : data) {
+            element.markModified();
+        }
+    }
+    // The data is not const, so neither is the storage the accessor points to
+    double* base = const_cast<double*>(f.storage(data.front()));
+    return FieldView<double>(base, data.size(), fieldLayers(f, data));
+}
+
+} /* namespace Nextsim */
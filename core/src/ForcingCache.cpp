@@ -0,0 +1,265 @@
+/*!
+ * @file ForcingCache.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/ForcingCache.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Nextsim {
+
+// The state of a record, as seen by the processes waiting for it
+enum RecordState : std::uint32_t {
+    DECODING = 0, // The initial, zero filled, state
+    READY,
+    FAILED,
+};
+
+// The header of a record, on its own page so that the fields can be mapped
+// read-only while the header is written
+struct RecordHeader {
+    std::atomic<std::uint32_t> state;
+    std::atomic<std::int32_t> users;
+    // The process decoding the record
+    std::atomic<std::int32_t> decoder;
+    std::uint64_t nElements;
+};
+
+static std::runtime_error systemError(const std::string& what)
+{
+    return std::runtime_error("ForcingCache: " + what + ": " + std::strerror(errno));
+}
+
+// Whether the process decoding a record has exited without finishing it
+static bool decoderExited(const RecordHeader& header)
+{
+    pid_t decoder = header.decoder.load();
+    return decoder > 0 && kill(decoder, 0) != 0 && errno == ESRCH;
+}
+
+// Removes the segment of a name, if the name still refers to the segment
+// with the given device and inode rather than to a new segment created since
+// by another process
+static void unlinkIfSame(const std::string& name, dev_t device, ino_t inode)
+{
+    int current = shm_open(name.c_str(), O_RDONLY, 0);
+    if (current < 0)
+        return;
+    struct stat theirs;
+    if (fstat(current, &theirs) == 0 && theirs.st_dev == device && theirs.st_ino == inode) {
+        shm_unlink(name.c_str());
+    }
+    close(current);
+}
+
+// Removes the segment of a name, if the name still refers to the segment
+// open as fd
+static void unlinkIfSame(const std::string& name, int fd)
+{
+    struct stat ours;
+    if (fstat(fd, &ours) == 0)
+        unlinkIfSame(name, ours.st_dev, ours.st_ino);
+}
+
+// Identifies the version of a source file by its size, modification time and
+// inode, so that the records of a replaced file are not reused. Empty if the
+// source is not a file.
+static std::string sourceVersion(const std::string& source)
+{
+    struct stat status;
+    if (stat(source.c_str(), &status) != 0)
+        return std::string();
+    std::stringstream version;
+    version << ":" << status.st_size << ":" << status.st_mtime << ":" << status.st_ino;
+    return version.str();
+}
+
+ForcingCache::Record::Record(const std::string& name, int index, bool decodedHere,
+    std::size_t nElements, void* header, const double* fields, dev_t device, ino_t inode)
+    : m_name(name)
+    , m_device(device)
+    , m_inode(inode)
+    , m_index(index)
+    , m_decodedHere(decodedHere)
+    , m_nElements(nElements)
+    , m_header(header)
+    , m_headerSize(sysconf(_SC_PAGESIZE))
+    , m_fields(fields)
+    , m_fieldsSize(SharedMemoryCoupler::N_FORCING * nElements * sizeof(double))
+{
+}
+
+ForcingCache::Record::~Record()
+{
+    munmap(const_cast<double*>(m_fields), m_fieldsSize);
+    RecordHeader* header = static_cast<RecordHeader*>(m_header);
+    // The last process using the record removes it, unless a stale record
+    // has since been replaced under the same name
+    if (header->users.fetch_sub(1) == 1) {
+        unlinkIfSame(m_name, m_device, m_inode);
+    }
+    munmap(m_header, m_headerSize);
+}
+
+ForcingCache::ForcingCache(
+    const std::string& source, std::size_t nElements, const Decoder& decoder, double timeout)
+    : m_source(source)
+    , m_version(sourceVersion(source))
+    , m_nElements(nElements)
+    , m_decoder(decoder)
+    , m_timeout(timeout)
+{
+    if (nElements == 0) {
+        throw std::invalid_argument("ForcingCache: a record must have at least one element");
+    }
+}
+
+std::string ForcingCache::segmentName(int index) const
+{
+    // The source may be a long file path, so it is identified by a hash,
+    // which includes the version of a source file
+    std::stringstream name;
+    name << "/nextsim_forcing_" << std::hex << std::setw(16) << std::setfill('0')
+         << std::hash<std::string>()(m_source + m_version) << std::dec << "_" << index;
+    return name.str();
+}
+
+std::shared_ptr<const ForcingCache::Record> ForcingCache::record(int index)
+{
+    const std::string name = segmentName(index);
+    const std::size_t headerSize = sysconf(_SC_PAGESIZE);
+    const std::size_t fieldsSize = SharedMemoryCoupler::N_FORCING * m_nElements * sizeof(double);
+    const std::size_t size = headerSize + fieldsSize;
+
+    auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(m_timeout));
+    while (true) {
+        // Decode the record if no other process has created it
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if (fd >= 0) {
+            if (ftruncate(fd, size) != 0) {
+                close(fd);
+                shm_unlink(name.c_str());
+                throw systemError("cannot size " + name);
+            }
+            void* header = mmap(nullptr, headerSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            void* fields
+                = mmap(nullptr, fieldsSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, headerSize);
+            struct stat created;
+            bool identified = fstat(fd, &created) == 0;
+            close(fd);
+            if (header == MAP_FAILED || fields == MAP_FAILED || !identified) {
+                std::runtime_error error = systemError("cannot map " + name);
+                if (header != MAP_FAILED)
+                    munmap(header, headerSize);
+                if (fields != MAP_FAILED)
+                    munmap(fields, fieldsSize);
+                shm_unlink(name.c_str());
+                throw error;
+            }
+            RecordHeader* recordHeader = static_cast<RecordHeader*>(header);
+            recordHeader->nElements = m_nElements;
+            recordHeader->decoder.store(getpid());
+            // Other processes may already have attached to the sized segment
+            recordHeader->users.fetch_add(1);
+            try {
+                m_decoder(index, static_cast<double*>(fields), m_nElements);
+            } catch (...) {
+                recordHeader->state.store(FAILED, std::memory_order_release);
+                shm_unlink(name.c_str());
+                munmap(fields, fieldsSize);
+                munmap(header, headerSize);
+                throw;
+            }
+            mprotect(fields, fieldsSize, PROT_READ);
+            recordHeader->state.store(READY, std::memory_order_release);
+            return std::shared_ptr<const Record>(new Record(
+                name, index, true, m_nElements, header, static_cast<const double*>(fields),
+                created.st_dev, created.st_ino));
+        }
+        if (errno != EEXIST)
+            throw systemError("cannot create " + name);
+
+        // Another process has created the record, or is creating it
+        fd = shm_open(name.c_str(), O_RDWR, 0);
+        struct stat status;
+        if (fd >= 0 && fstat(fd, &status) == 0 && status.st_size > 0) {
+            if (static_cast<std::size_t>(status.st_size) != size) {
+                close(fd);
+                throw std::runtime_error("ForcingCache: the record " + name
+                    + " shared by another process does not have " + std::to_string(m_nElements)
+                    + " elements");
+            }
+            void* header = mmap(nullptr, headerSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (header == MAP_FAILED) {
+                close(fd);
+                throw systemError("cannot map " + name);
+            }
+            RecordHeader* recordHeader = static_cast<RecordHeader*>(header);
+            recordHeader->users.fetch_add(1);
+            // Wait for the decoding to finish
+            std::uint32_t state;
+            bool stale = false;
+            while ((state = recordHeader->state.load(std::memory_order_acquire)) == DECODING
+                && std::chrono::steady_clock::now() < deadline) {
+                if (decoderExited(*recordHeader)) {
+                    stale = true;
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (stale) {
+                // The decoding process died. Remove its record and decode again.
+                recordHeader->users.fetch_sub(1);
+                munmap(header, headerSize);
+                unlinkIfSame(name, fd);
+                close(fd);
+                continue;
+            }
+            void* fields = MAP_FAILED;
+            if (state == READY) {
+                fields = mmap(nullptr, fieldsSize, PROT_READ, MAP_SHARED, fd, headerSize);
+            }
+            close(fd);
+            if (fields == MAP_FAILED) {
+                recordHeader->users.fetch_sub(1);
+                munmap(header, headerSize);
+                if (state == READY)
+                    throw systemError("cannot map " + name);
+                throw std::runtime_error("ForcingCache: the decoding of " + name
+                    + ((state == FAILED) ? " by another process failed"
+                                         : " by another process timed out"));
+            }
+            return std::shared_ptr<const Record>(new Record(
+                name, index, false, m_nElements, header, static_cast<const double*>(fields),
+                status.st_dev, status.st_ino));
+        }
+        // The record was removed, or is not yet sized. Try again.
+        if (fd >= 0)
+            close(fd);
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("ForcingCache: timed out waiting for the record " + name);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+} /* namespace Nextsim */
@@ -14,11 +14,13 @@ Iterator::NullIterant Iterator::nullIterant;
 
 Iterator::Iterator()
     : iterant(&nullIterant)
+    , m_currentTime(0)
 {
 }
 
 Iterator::Iterator(Iterant* iterant)
     : iterant(iterant)
+    , m_currentTime(0)
 {
 }
 
@@ -52,12 +54,40 @@ void Iterator::parseAndSet(const std::string& startTimeStr, const std::string& s
 
 void Iterator::run()
 {
-    iterant->start(startTime);
+    start();
 
+    int nSteps = 0;
     for (auto t = startTime; t < stopTime; t += timestep) {
-        iterant->iterate(timestep);
+        ++nSteps;
     }
+    step(nSteps);
+
+    stop();
+}
+
+void Iterator::start()
+{
+    m_currentTime = startTime;
+    setModelTime(startTime);
+    iterant->start(startTime);
+}
 
+int Iterator::step(int nSteps)
+{
+    int nDone = 0;
+    for (auto t = m_currentTime; t < stopTime && nDone < nSteps; t += timestep) {
+        ++nDone;
+    }
+    if (nDone > 0) {
+        iterant->iterateSteps(timestep, nDone);
+        m_currentTime += nDone * timestep;
+    }
+    return nDone;
+}
+
+void Iterator::stop()
+{
+    setModelTime(stopTime);
     iterant->stop(stopTime);
 }
 
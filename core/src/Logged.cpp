@@ -6,39 +6,314 @@
 
 #include "include/Logged.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 namespace Nextsim {
 
-// TODO Empty implementations of the declared functions
+std::atomic<int> Logged::minimumLevel(Logged::INFO);
+// No model time has been set
+static const int noModelTime = INT_MIN;
+thread_local int Logged::currentModelTime = noModelTime;
+
+namespace {
+    typedef std::chrono::system_clock WallClock;
+
+    struct Entry {
+        Logged::level lvl;
+        WallClock::time_point wallTime;
+        int modelTime;
+        std::string message;
+    };
+
+    /*
+     * A single producer, single consumer ring buffer. The producer is the
+     * thread that owns the buffer, the consumer is whichever thread holds the
+     * drain lock of the LogSink.
+     */
+    class RingBuffer {
+    public:
+        // Must be a power of two
+        static const size_t capacity = 1024;
+
+        RingBuffer()
+            : head(0)
+            , tail(0)
+            , dropped(0)
+            , closed(false)
+            , entries(capacity)
+        {
+        }
+
+        // Returns false if the buffer is full
+        bool push(Entry&& entry)
+        {
+            size_t h = head.load(std::memory_order_relaxed);
+            if (h - tail.load(std::memory_order_acquire) >= capacity) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            entries[h & (capacity - 1)] = std::move(entry);
+            head.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t size() const
+        {
+            return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+        }
+
+        void drainTo(std::vector<Entry>& out)
+        {
+            size_t t = tail.load(std::memory_order_relaxed);
+            size_t h = head.load(std::memory_order_acquire);
+            for (; t != h; ++t) {
+                out.push_back(std::move(entries[t & (capacity - 1)]));
+            }
+            tail.store(t, std::memory_order_release);
+        }
+
+        std::atomic<size_t> head;
+        std::atomic<size_t> tail;
+        std::atomic<unsigned long> dropped;
+        // Set when the owning thread exits
+        std::atomic<bool> closed;
+
+    private:
+        std::vector<Entry> entries;
+    };
+
+    // Collects the buffers of all threads and writes them out in the background
+    class LogSink {
+    public:
+        static LogSink& instance()
+        {
+            static LogSink sink;
+            return sink;
+        }
+
+        RingBuffer& threadBuffer();
+        void flush();
+        void setOutputFile(const std::string& filePath);
+        void wake();
+
+        ~LogSink();
+
+    private:
+        LogSink();
+        void write(const Entry& entry);
+
+        // Held while buffers are drained and the output is written
+        std::mutex drainMutex;
+        std::ofstream file;
+
+        // Held only when a thread registers its buffer for the first time
+        std::mutex registryMutex;
+        std::vector<std::shared_ptr<RingBuffer>> buffers;
+
+        std::thread flusher;
+        std::mutex wakeMutex;
+        std::condition_variable wakeCv;
+        bool wakeRequested;
+        bool stopping;
+    };
+
+    // Marks the buffer of a thread as closed when the thread exits
+    struct BufferHolder {
+        std::shared_ptr<RingBuffer> buffer;
+        ~BufferHolder()
+        {
+            if (buffer)
+                buffer->closed.store(true, std::memory_order_release);
+        }
+    };
+
+    const std::chrono::milliseconds flushInterval(100);
+
+    LogSink::LogSink()
+        : wakeRequested(false)
+        , stopping(false)
+    {
+        flusher = std::thread([this]() {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            while (!stopping) {
+                wakeCv.wait_for(
+                    lock, flushInterval, [this]() { return wakeRequested || stopping; });
+                wakeRequested = false;
+                lock.unlock();
+                flush();
+                lock.lock();
+            }
+        });
+    }
+
+    LogSink::~LogSink()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wakeCv.notify_one();
+        flusher.join();
+        flush();
+    }
+
+    RingBuffer& LogSink::threadBuffer()
+    {
+        thread_local BufferHolder holder;
+        if (!holder.buffer) {
+            holder.buffer = std::make_shared<RingBuffer>();
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffers.push_back(holder.buffer);
+        }
+        return *holder.buffer;
+    }
+
+    void LogSink::wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wakeRequested = true;
+        }
+        wakeCv.notify_one();
+    }
+
+    void LogSink::flush()
+    {
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+        std::vector<std::shared_ptr<RingBuffer>> current;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            current = buffers;
+        }
+
+        std::vector<Entry> entries;
+        unsigned long nDropped = 0;
+        for (auto& buffer : current) {
+            // Read the closed flag before draining, so that nothing is pushed
+            // to a closed buffer after it has been drained
+            bool wasClosed = buffer->closed.load(std::memory_order_acquire);
+            buffer->drainTo(entries);
+            nDropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+            if (wasClosed) {
+                std::lock_guard<std::mutex> lock(registryMutex);
+                buffers.erase(std::remove(buffers.begin(), buffers.end(), buffer), buffers.end());
+            }
+        }
+
+        // Interleave the messages of different threads by wall time
+        std::stable_sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.wallTime < b.wallTime; });
+        for (auto& entry : entries) {
+            write(entry);
+        }
+        if (nDropped > 0) {
+            write({ Logged::WARNING, WallClock::now(), noModelTime,
+                "Logged: " + std::to_string(nDropped) + " messages dropped" });
+        }
+        if (file.is_open()) {
+            file.flush();
+        } else {
+            std::cerr.flush();
+        }
+    }
+
+    void LogSink::setOutputFile(const std::string& filePath)
+    {
+        flush();
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+        if (file.is_open())
+            file.close();
+        if (!filePath.empty()) {
+            file.open(filePath, std::ios_base::app);
+            if (!file.is_open()) {
+                throw std::runtime_error("Logged: unable to open the log file " + filePath);
+            }
+        }
+    }
+
+    void LogSink::write(const Entry& entry)
+    {
+        std::ostream& os = file.is_open() ? static_cast<std::ostream&>(file) : std::cerr;
+
+        std::time_t seconds = WallClock::to_time_t(entry.wallTime);
+        int millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         entry.wallTime.time_since_epoch())
+                         .count()
+            % 1000;
+        std::tm utc;
+        gmtime_r(&seconds, &utc);
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+
+        os << stamp << "." << std::setfill('0') << std::setw(3) << millis << "Z ";
+        if (entry.modelTime == noModelTime) {
+            os << "[model -] ";
+        } else {
+            os << "[model " << entry.modelTime << "] ";
+        }
+        os << Logged::levelName(entry.lvl) << ": " << entry.message << "\n";
+    }
+}
+
 void Logged::log(const std::string& message, Logged::level lvl)
 {
-    switch (lvl) {
-    case (INFO):
-        info(message);
-        break;
-    case (DEBUG):
-    case (NOTICE):
-    case (WARNING):
-    case (ERROR):
-    case (CRITICAL):
-    case (ALERT):
-        // TODO implement these levels
-        break;
-    case (EMERGENCY):
-        emergency(message);
-        break;
-    default:
-        break;
+    if (!isEnabled(lvl))
+        return;
+
+    LogSink& sink = LogSink::instance();
+    RingBuffer& buffer = sink.threadBuffer();
+    buffer.push({ lvl, WallClock::now(), currentModelTime, message });
+
+    if (lvl >= ERROR) {
+        sink.flush();
+    } else if (buffer.size() == RingBuffer::capacity / 2) {
+        // Avoid dropping messages from a busy thread
+        sink.wake();
     }
 }
 
-void Logged::info(const std::string& message)
+void Logged::setMinimumLevel(const level lvl)
+{
+    minimumLevel.store(lvl, std::memory_order_relaxed);
+}
+
+// Plain strings, so that the names remain available while the LogSink is destroyed
+static const char* const levelNames[]
+    = { "DEBUG", "INFO", "NOTICE", "WARNING", "ERROR", "CRITICAL", "ALERT", "EMERGENCY" };
+static const int nLevels = sizeof(levelNames) / sizeof(levelNames[0]);
+
+Logged::level Logged::levelFromString(const std::string& name)
 {
-    // TODO Replace empty implementation
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+        [](unsigned char c) { return std::toupper(c); });
+    for (int i = 0; i < nLevels; ++i) {
+        if (upper == levelNames[i])
+            return static_cast<level>(i);
+    }
+    throw std::invalid_argument("Logged: unknown log level " + name);
 }
 
-void Logged::emergency(const std::string& message)
+std::string Logged::levelName(const level lvl) { return levelNames[lvl]; }
+
+void Logged::setOutputFile(const std::string& filePath)
 {
-    // TODO Replace empty implementation
+    LogSink::instance().setOutputFile(filePath);
 }
 
+void Logged::flush() { LogSink::instance().flush(); }
+
 } /* namespace Nextsim */
@@ -6,16 +6,29 @@
 
 #include "include/Model.hpp"
 
+#include "include/Arena.hpp"
 #include "include/Configurator.hpp"
 #include "include/DevGrid.hpp"
 #include "include/DevStep.hpp"
 #include "include/DummyExternalData.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/IPhysics1d.hpp"
+#include "include/Reproducibility.hpp"
 #include "include/StructureFactory.hpp"
+#include "include/ThreadTeam.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
-// TODO Replace with real logging
-#include <iostream>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
 
 namespace Nextsim {
 
@@ -26,9 +39,58 @@ const std::map<int, std::string> Configured<Model>::keyMap = {
     { Model::STOPTIME_KEY, "model.stop" },
     { Model::RUNLENGTH_KEY, "model.run_length" },
     { Model::TIMESTEP_KEY, "model.time_step" },
+    { Model::STAGETHREADS_KEY, "model.stage_threads" },
+    { Model::STAGELEAD_KEY, "model.stage_lead" },
+    { Model::LOGLEVEL_KEY, "model.log_level" },
+    { Model::LOGFILE_KEY, "model.log_file" },
+    { Model::REPRODUCIBLE_KEY, "model.reproducible" },
+    { Model::PHYSICSKERNEL_KEY, "model.physics_kernel" },
+    { Model::TILESIZE_KEY, "model.tile_size" },
+    { Model::THREADS_KEY, "model.threads" },
+    { Model::PINTHREADS_KEY, "model.pin_threads" },
+    { Model::HUGEPAGES_KEY, "model.huge_pages" },
+    { Model::COUPLING_KEY, "model.coupling_segment" },
+    { Model::STATISTICSFIELDS_KEY, "model.statistics_fields" },
+    { Model::STATISTICSWINDOW_KEY, "model.statistics_window" },
+    { Model::STATISTICSFILE_KEY, "model.statistics_file" },
+    { Model::OUTPUTFILE_KEY, "model.output_file" },
+    { Model::OUTPUTPERIOD_KEY, "model.output_period" },
+    { Model::COARSENING_KEY, "model.output_coarsening" },
+    { Model::COARSENINGMETHOD_KEY, "model.output_coarsening_method" },
+    { Model::KEEPBITS_KEY, "model.output_keep_bits" },
+    { Model::DEFLATE_KEY, "model.output_deflate_level" },
+    { Model::BUDGETPERIOD_KEY, "model.budget_period" },
 };
 
+namespace {
+
+// The settings which apply to the whole process, shared by its models
+struct ProcessSettings {
+    Logged::level logLevel;
+    std::string logFile;
+    Arena::HugePages hugePages;
+
+    bool operator==(const ProcessSettings& other) const
+    {
+        return logLevel == other.logLevel && logFile == other.logFile
+            && hugePages == other.hugePages;
+    }
+};
+
+std::mutex processMutex;
+// The number of live models configured with the current process settings
+int nProcessModels = 0;
+ProcessSettings processSettings;
+
+} /* namespace */
+
 Model::Model()
+    : finalized(false)
+    , holdsProcessSettings(false)
+    , outputPeriod(0)
+    , outputReady(false)
+    , outputTime(0)
+    , deflateLevel(0)
 {
     iterator.setIterant(&modelStep);
 
@@ -39,21 +101,84 @@ Model::Model()
 
 Model::~Model()
 {
+    if (holdsProcessSettings) {
+        std::lock_guard<std::mutex> lock(processMutex);
+        --nProcessModels;
+    }
     /*
      * Try writing out a valid restart file. If the model and computer are in a
      * state where this can be completed, great! If they are not then the
      * restart file is unlikely to be valid or otherwise stored properly, and
-     * we abandon the writing.
+     * the failure is logged, as a destructor must not throw.
      */
+    if (!dataStructure && !restartWrite.valid())
+        return;
+#ifdef USE_MPI
+    // The restart is written with collective calls, which are no longer
+    // possible once MPI is finalized. The caller must drain the restart first.
+    int mpiFinalized = 0;
+    MPI_Finalized(&mpiFinalized);
+    if (mpiFinalized && (!finalized || restartWrite.valid())) {
+        error("Restart file " + finalFileName
+            + " not written: MPI was finalized before the restart was drained");
+        return;
+    }
+#endif
     try {
-        writeRestartFile();
+        drainRestart();
     } catch (std::exception& e) {
-        // If there are any exceptions at all, fail without writing
+        error("Restart file " + finalFileName + " not written: " + e.what());
+    }
+}
+
+void Model::configureProcess()
+{
+    ProcessSettings settings;
+    settings.logLevel = levelFromString(
+        Configured::getConfiguration(keyMap.at(LOGLEVEL_KEY), std::string("info")));
+    settings.logFile = Configured::getConfiguration(keyMap.at(LOGFILE_KEY), std::string());
+    std::string hugePages
+        = Configured::getConfiguration(keyMap.at(HUGEPAGES_KEY), std::string("none"));
+    if (hugePages == "none") {
+        settings.hugePages = Arena::HugePages::NONE;
+    } else if (hugePages == "transparent") {
+        settings.hugePages = Arena::HugePages::TRANSPARENT;
+    } else if (hugePages == "explicit") {
+        settings.hugePages = Arena::HugePages::EXPLICIT;
+    } else {
+        throw std::invalid_argument("Model: unknown huge page setting " + hugePages);
+    }
+
+    // The settings of the process are only changed when no other live model
+    // has been configured with them
+    std::lock_guard<std::mutex> lock(processMutex);
+    const int nOthers = nProcessModels - (holdsProcessSettings ? 1 : 0);
+    if (nOthers > 0) {
+        if (!(settings == processSettings)) {
+            throw std::invalid_argument("Model: the " + keyMap.at(LOGLEVEL_KEY) + ", "
+                + keyMap.at(LOGFILE_KEY) + " and " + keyMap.at(HUGEPAGES_KEY)
+                + " settings apply to the whole process, and differ from those of another "
+                  "model");
+        }
+    } else {
+        setMinimumLevel(settings.logLevel);
+        setOutputFile(settings.logFile);
+        Arena::main.setHugePages(settings.hugePages);
+        processSettings = settings;
+    }
+    if (!holdsProcessSettings) {
+        holdsProcessSettings = true;
+        ++nProcessModels;
     }
 }
 
 void Model::configure()
 {
+    // Configure the logging first, so that the rest of the configuration can be logged
+    configureProcess();
+    // The fields are read without locking by the models from here on
+    FieldRegistry::freeze();
+
     std::string startTimeStr
         = Configured::getConfiguration(keyMap.at(STARTTIME_KEY), std::string());
     std::string stopTimeStr = Configured::getConfiguration(keyMap.at(STOPTIME_KEY), std::string());
@@ -62,18 +187,275 @@ void Model::configure()
 
     iterator.parseAndSet(startTimeStr, stopTimeStr, durationStr, stepStr);
 
+    // Threads executing the stages of the timesteps. 0 uses the hardware concurrency.
+    modelStep.stages().setThreads(Configured::getConfiguration(keyMap.at(STAGETHREADS_KEY), 0));
+    modelStep.stages().setMaxLead(Configured::getConfiguration(keyMap.at(STAGELEAD_KEY), 1));
+
+    // Bitwise reproducible results, independent of the threads and the processor.
+    // The setting belongs to this model, so that other models are unaffected.
+    context.setReproducible(Configured::getConfiguration(keyMap.at(REPRODUCIBLE_KEY), false));
+    if (context.reproducible()) {
+        // No stage of a later timestep may run before a timestep is complete,
+        // so that all stages see the model state at the same point
+        modelStep.stages().setMaxLead(0);
+        if (!Reproducibility::isReproducibleBuild()) {
+            warning("Reproducible execution requested, but not built with ENABLE_REPRODUCIBLE. "
+                    "Results may differ between differently compiled executables.");
+        }
+    }
+#ifdef USE_MPI
+    // MPI is initialized without thread support, and the reductions of the
+    // physics and the collective netCDF calls of the output must all be made
+    // by the thread which initialized it. The stages therefore run on the
+    // calling thread, one timestep at a time.
+    modelStep.stages().setThreads(1);
+    modelStep.stages().setMaxLead(0);
+#endif
+
     initialFileName = Configured::getConfiguration(keyMap.at(RESTARTFILE_KEY), std::string());
 
     modelStep.setInitFile(initialFileName);
 
+    // Threads computing on the element data. The memory of the elements is
+    // divided between them when the data structure is initialized, and both
+    // physics kernels compute on each thread's own block. The team belongs to
+    // the context of this model, so that other models in the process keep
+    // their own threads.
+    context.threadTeam().setThreads(Configured::getConfiguration(keyMap.at(THREADS_KEY), 1));
+    context.threadTeam().setPinning(
+        Configured::getConfiguration(keyMap.at(PINTHREADS_KEY), false));
+
     // Currently, initialize the data here in Model and pass the pointer to the
     // data structure to IModelStep
     dataStructure = StructureFactory::generateFromFile(initialFileName);
+    dataStructure->setContext(context);
     dataStructure->init(initialFileName);
     modelStep.setInitialData(*dataStructure);
 
-    // TODO Real external data handling (in the model step?)
-    DummyExternalData::setAll(*dataStructure);
+    // The arena is shared by all the models of the process, so the memory is
+    // that of the process, including any models initialized before this one
+    std::stringstream memory;
+    memory << "Process field memory:";
+    for (auto& group : Arena::main.report()) {
+        memory << " " << group.first << " " << group.second << " bytes;";
+    }
+    memory << " " << Arena::main.reservedBytes() << " bytes reserved";
+    info(memory.str());
+
+    // The modular or the single pass (fused) calculation of the column physics
+    std::string kernel
+        = Configured::getConfiguration(keyMap.at(PHYSICSKERNEL_KEY), std::string("modular"));
+    if (kernel == "fused") {
+        modelStep.setFusedPhysics(true);
+        // The implementation is configured by the initialization of the data structure
+        IPhysics1d* physics = context.physics();
+        if (!physics || !physics->hasFusedKernel()) {
+            warning("The fused physics kernel does not support the selected physics modules. "
+                    "The modular calculation will be used for each tile.");
+        }
+        // Elements per tile of the fused calculation
+        modelStep.tiling().setTileSize(
+            Configured::getConfiguration(keyMap.at(TILESIZE_KEY), Tiling::defaultTileSize));
+    } else if (kernel == "modular") {
+        modelStep.setFusedPhysics(false);
+    } else {
+        throw std::invalid_argument("Model: unknown physics kernel " + kernel);
+    }
+
+    // Forcing from a coupled model through shared memory, or constant values
+    std::vector<TaskGraph::Stage> diagnostics;
+    std::string segment
+        = Configured::getConfiguration(keyMap.at(COUPLING_KEY), std::string());
+    if (segment.empty()) {
+        // TODO Real external data handling (in the model step?)
+        DummyExternalData::setAll(*dataStructure);
+    } else {
+        std::size_t nElements = 0;
+        for (dataStructure->cursor = 0; dataStructure->cursor; ++dataStructure->cursor) {
+            ++nElements;
+        }
+        coupler.reset(
+            new SharedMemoryCoupler(segment, SharedMemoryCoupler::Side::MODEL, nElements));
+        info("Coupling through the shared memory segment " + segment);
+        IStructure& structure = *dataStructure;
+        SharedMemoryCoupler& shm = *coupler;
+        modelStep.addStage(
+            DevStep::forcingStage, [&shm, &structure](int) { shm.receiveForcing(structure); });
+        // The fluxes are complete once the physics of the timestep has finished
+        diagnostics.push_back([&shm, &structure](int) { shm.sendFluxes(structure); });
+    }
+
+    // The conservation budget, every budget_period timesteps. Zero disables it.
+    const int budgetPeriod = Configured::getConfiguration(keyMap.at(BUDGETPERIOD_KEY), 1);
+    if (budgetPeriod < 0) {
+        throw std::invalid_argument("Model: the budget period must not be negative");
+    }
+    if (budgetPeriod > 0) {
+        if (!dataStructure->elementStorage()) {
+            throw std::runtime_error(
+                "Model: the budget requires a structure holding its elements contiguously");
+        }
+        diagnostics.push_back([this, budgetPeriod](int step) {
+            if ((modelStep.stepIndex(step) + 1) % budgetPeriod == 0) {
+                modelStep.updateBudget();
+            }
+        });
+    }
+
+    std::vector<TaskGraph::Stage> outputs;
+    configureCompression();
+    configureStatistics(diagnostics, outputs);
+    configureOutput(diagnostics, outputs);
+#ifdef USE_MPI
+    // The files are written synchronously after the diagnostics, rather than
+    // in an output stage overlapping the next timestep
+    diagnostics.insert(diagnostics.end(), outputs.begin(), outputs.end());
+    outputs.clear();
+#endif
+
+    if (!diagnostics.empty()) {
+        modelStep.addStage(DevStep::diagnosticsStage, [diagnostics](int step) {
+            for (auto& diagnostic : diagnostics) {
+                diagnostic(step);
+            }
+        });
+    }
+    if (!outputs.empty()) {
+        modelStep.addStage(DevStep::outputStage, [outputs](int step) {
+            for (auto& output : outputs) {
+                output(step);
+            }
+        });
+    }
+}
+
+void Model::configureCompression()
+{
+    // The mantissa bits kept in the diagnostic output, as a default number
+    // of bits and field:bits for individual fields. Restarts are not rounded.
+    std::string keepBits
+        = Configured::getConfiguration(keyMap.at(KEEPBITS_KEY), std::string());
+    std::replace(keepBits.begin(), keepBits.end(), ',', ' ');
+    std::stringstream keepStream(keepBits);
+    std::string item;
+    // Set after the default, which replaces the rounding
+    std::map<std::string, int> fieldBits;
+    while (keepStream >> item) {
+        std::size_t colon = item.find(':');
+        if (colon == std::string::npos) {
+            outputRounding = BitRounding(std::stoi(item));
+        } else {
+            fieldBits[item.substr(0, colon)] = std::stoi(item.substr(colon + 1));
+        }
+    }
+    for (auto& field : fieldBits) {
+        outputRounding.setKeepBits(field.first, field.second);
+    }
+    deflateLevel = Configured::getConfiguration(keyMap.at(DEFLATE_KEY), 0);
+    if (deflateLevel < 0 || deflateLevel > 9) {
+        throw std::invalid_argument("Model: the deflate level must be between 0 and 9");
+    }
+    if (!outputRounding.isLossless()) {
+        info("Rounding the diagnostic output to " + keepBits + " mantissa bits");
+    }
+}
+
+void Model::configureStatistics(
+    std::vector<TaskGraph::Stage>& diagnostics, std::vector<TaskGraph::Stage>& outputs)
+{
+    // Fields, optionally with histogram bins, as name or name:lower:upper:nBins
+    std::string fields
+        = Configured::getConfiguration(keyMap.at(STATISTICSFIELDS_KEY), std::string());
+    std::replace(fields.begin(), fields.end(), ',', ' ');
+    std::stringstream fieldStream(fields);
+    std::string field;
+    while (fieldStream >> field) {
+        std::replace(field.begin(), field.end(), ':', ' ');
+        std::stringstream spec(field);
+        std::string name;
+        FieldStatistics::Bins bins = { 0., 0., 0 };
+        spec >> name;
+        if (spec >> bins.lower) {
+            if (!(spec >> bins.upper >> bins.nBins)) {
+                throw std::invalid_argument("Model: the statistics of " + name
+                    + " should have histogram bins as " + name + ":lower:upper:nBins");
+            }
+        }
+        statistics.add(name, bins);
+    }
+    if (statistics.empty())
+        return;
+
+    ElementVector* storage = dataStructure->elementStorage();
+    if (!storage) {
+        throw std::runtime_error(
+            "Model: statistics require a structure holding its elements contiguously");
+    }
+    if (!dataStructure->hasStatisticsOutput()) {
+        throw std::invalid_argument(
+            "Model: the " + dataStructure->structureType() + " structure cannot write statistics");
+    }
+    statistics.setWindow(Configured::getConfiguration(keyMap.at(STATISTICSWINDOW_KEY), 0));
+    statisticsFilePrefix = Configured::getConfiguration(
+        keyMap.at(STATISTICSFILE_KEY), std::string("statistics"));
+    info("Writing the statistics of " + fields + " every " + std::to_string(statistics.window())
+        + " to " + statisticsFilePrefix);
+
+    diagnostics.push_back([this, storage](int step) {
+        if (statistics.update(*storage, modelStep.stepTime(step), modelStep.timestep())) {
+            statistics.roundCompleted(outputRounding, context.threadTeam());
+        }
+    });
+    // The statistics of a completed window are written while the next
+    // accumulates, except with MPI, where they are written by the diagnostics
+    outputs.push_back([this](int) {
+        if (statistics.windowCompleted()) {
+            dataStructure->dumpStatistics(statistics,
+                statisticsFilePrefix + "." + std::to_string(statistics.completedEnd()) + ".nc",
+                deflateLevel);
+        }
+    });
+}
+
+void Model::configureOutput(
+    std::vector<TaskGraph::Stage>& diagnostics, std::vector<TaskGraph::Stage>& outputs)
+{
+    outputFilePrefix = Configured::getConfiguration(keyMap.at(OUTPUTFILE_KEY), std::string());
+    if (outputFilePrefix.empty())
+        return;
+    if (!dataStructure->hasCoarsenedOutput()) {
+        throw std::invalid_argument("Model: the " + dataStructure->structureType()
+            + " structure cannot write coarsened output");
+    }
+    outputPeriod = Configured::getConfiguration(keyMap.at(OUTPUTPERIOD_KEY), 0);
+    if (outputPeriod <= 0) {
+        throw std::invalid_argument("Model: the output period must be positive");
+    }
+    // Averaging or subsampling blocks of cells reduces the size of the output
+    coarsening = Coarsening(Configured::getConfiguration(keyMap.at(COARSENING_KEY), 1),
+        Coarsening::methodFromString(Configured::getConfiguration(
+            keyMap.at(COARSENINGMETHOD_KEY), std::string("mean"))));
+    info("Writing the fields every " + std::to_string(outputPeriod) + " to " + outputFilePrefix
+        + ", coarsened by a factor of " + std::to_string(coarsening.factor()));
+
+    // The fields are coarsened from the model state in memory, then written
+    // while the physics of the next timestep is calculated, except with MPI,
+    // where they are written by the diagnostics
+    diagnostics.push_back([this](int step) {
+        Iterator::TimePoint end = modelStep.stepTime(step) + modelStep.timestep();
+        outputReady = (end % outputPeriod == 0);
+        if (outputReady) {
+            outputTime = end;
+            dataStructure->coarsen(coarsening);
+            coarsening.round(outputRounding, context.threadTeam());
+        }
+    });
+    outputs.push_back([this](int) {
+        if (outputReady) {
+            dataStructure->dumpCoarsened(coarsening,
+                outputFilePrefix + "." + std::to_string(outputTime) + ".nc", deflateLevel);
+        }
+    });
 }
 
 void Model::run() { iterator.run(); }
@@ -81,9 +463,73 @@ void Model::run() { iterator.run(); }
 void Model::writeRestartFile()
 {
     if (dataStructure) {
-        // TODO Replace with real logging
-        std::cout << "  Writing restart file: " << finalFileName << std::endl;
+        info("Writing restart file: " + finalFileName);
         dataStructure->dump(finalFileName);
     }
 }
+
+// Formats a checksum as 16 hexadecimal digits
+static std::string checksumString(std::uint64_t checksum)
+{
+    std::stringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << checksum;
+    return hex.str();
+}
+
+void Model::finalize()
+{
+    if (finalized || !dataStructure)
+        return;
+    finalized = true;
+
+    // Structures without contiguous storage are written from the model data,
+    // which must then be unchanged until the writing is complete
+    IStructure* structure = dataStructure.get();
+    ElementVector* storage = structure->elementStorage();
+    if (storage) {
+        restartSnapshot.take(*storage);
+    }
+    info("Writing restart file: " + finalFileName + " from a snapshot of "
+        + std::to_string(restartSnapshot.bytes()) + " bytes, checksum "
+        + checksumString(restartSnapshot.checksum()));
+
+#ifdef USE_MPI
+    // The collective netCDF calls must be made by the thread which initialized MPI
+    const std::launch policy = std::launch::deferred;
+#else
+    const std::launch policy = storage ? std::launch::async : std::launch::deferred;
+#endif
+    restartWrite = std::async(policy, [this, structure, storage]() {
+        RestartStatus status = { false, finalFileName, restartSnapshot.checksum(), "" };
+        try {
+            if (storage) {
+                structure->dumpSnapshot(restartSnapshot, finalFileName);
+            } else {
+                structure->dump(finalFileName);
+            }
+            status.success = true;
+        } catch (std::exception& e) {
+            status.error = e.what();
+        }
+        return status;
+    });
+}
+
+Model::RestartStatus Model::drainRestart()
+{
+    finalize();
+    if (!restartWrite.valid()) {
+        return { false, finalFileName, restartSnapshot.checksum(), "no restart file was started" };
+    }
+    RestartStatus status = restartWrite.get();
+    restartSnapshot.clear();
+
+    if (status.success) {
+        info("Restart file " + status.filePath + " written, checksum "
+            + checksumString(status.checksum));
+    } else {
+        error("Restart file " + status.filePath + " not written: " + status.error);
+    }
+    return status;
+}
 } /* namespace Nextsim */
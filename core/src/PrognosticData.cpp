@@ -7,36 +7,42 @@
 #include "include/PrognosticData.hpp"
 #include "include/IFreezingPoint.hpp"
 #include "include/ModuleLoader.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 namespace Nextsim {
 
-double PrognosticData::m_dt = 0;
-IFreezingPoint* PrognosticData::m_freezer = nullptr;
+const int PrognosticData::maxIceLayers;
 
 PrognosticData::PrognosticData()
     : PrognosticData(1)
 {
 }
 
-PrognosticData::PrognosticData(int nIceLayers)
-    : m_conc(0)
-    , m_snow(0)
-    , m_sss(0)
+PrognosticData::PrognosticData(int nIceLayers, ModelContext& context)
+    : m_thick(0)
+    , m_conc(0)
     , m_sst(0)
-    , m_thick(0)
-    , m_tice(nIceLayers, 0.)
+    , m_sss(0)
+    , m_tf(std::numeric_limits<double>::quiet_NaN())
+    , m_nLayers(nIceLayers)
+    , m_snow(0)
+    , m_context(&context)
 {
-    //    m_tice.resize(nIceLayers);
+    if (nIceLayers > maxIceLayers || nIceLayers < 1) {
+        throw std::length_error("PrognosticData: unsupported number of ice layers ("
+            + std::to_string(nIceLayers) + ")");
+    }
+    m_tice.fill(0.);
 }
 
-PrognosticData::PrognosticData(const PrognosticGenerator& up)
-    : m_conc(up.updatedIceConcentration())
-    , m_snow(up.updatedSnowThickness())
-    , m_thick(up.updatedIceThickness())
-    , m_tice()
-    , m_sst(up.seaSurfaceTemperature())
-    , m_sss(up.seaSurfaceSalinity())
+PrognosticData::PrognosticData(const PrognosticGenerator& up, ModelContext& context)
+    : PrognosticData(1, context)
 {
-    m_tice = up.updatedIceTemperatures();
+    *this = up;
 }
 
 PrognosticData& PrognosticData::operator=(const PrognosticGenerator& up)
@@ -45,19 +51,22 @@ PrognosticData& PrognosticData::operator=(const PrognosticGenerator& up)
     m_conc = up.updatedIceConcentration();
     m_snow = up.updatedSnowThickness();
 
-    m_tice = up.updatedIceTemperatures();
+    setIceLayerData(up.updatedIceTemperatures());
 
     m_sst = up.seaSurfaceTemperature();
     m_sss = up.seaSurfaceSalinity();
+    m_tf = std::numeric_limits<double>::quiet_NaN();
 
     return *this;
 }
 
 void PrognosticData::configure()
 {
-    ModuleLoader& loader = ModuleLoader::getLoader();
-    m_freezer = &loader.getImplementation<IFreezingPoint>();
-    tryConfigure(m_freezer);
+    // A new instance, so that the contexts of different models are independent
+    std::unique_ptr<IFreezingPoint> freezer
+        = ModuleLoader::getLoader().getInstance<IFreezingPoint>();
+    tryConfigure(freezer.get());
+    m_context->setFreezingPoint(std::move(freezer));
 }
 
 PrognosticData& PrognosticData::updateAndIntegrate(const IPrognosticUpdater& updater)
@@ -66,7 +75,9 @@ PrognosticData& PrognosticData::updateAndIntegrate(const IPrognosticUpdater& upd
     m_conc = updater.updatedIceConcentration();
     m_snow = updater.updatedSnowThickness();
 
-    copyInIceLayerData(updater.updatedIceTemperatures(), m_tice);
+    copyInIceLayerData(updater.updatedIceTemperatures());
+    // The salinity may be written directly before the next timestep
+    m_tf = std::numeric_limits<double>::quiet_NaN();
     return *this;
 }
 
@@ -74,22 +85,28 @@ PrognosticData& PrognosticData::setSeaSurface(double sst, double sss)
 {
     m_sst = sst;
     m_sss = sss;
+    m_tf = std::numeric_limits<double>::quiet_NaN();
     return *this;
 }
 
+// Set the ice layers, and their number, from the source data
+void PrognosticData::setIceLayerData(const std::vector<double>& src)
+{
+    if (src.size() > maxIceLayers || src.empty()) {
+        throw std::length_error("PrognosticData: unsupported number of ice layers ("
+            + std::to_string(src.size()) + ")");
+    }
+    m_nLayers = src.size();
+    std::copy(src.begin(), src.end(), m_tice.begin());
+}
+
 // Copy up to as many levels as there are currently.
 // Fill missing layers with the lowest valid temperature
-void PrognosticData::copyInIceLayerData(const std::vector<double>& src, std::vector<double>& tgt)
+void PrognosticData::copyInIceLayerData(const std::vector<double>& src)
 {
-    int tLayers = tgt.size();
     int sLayers = src.size();
-
-    tgt = src;
-    if (tLayers != sLayers) {
-        tgt.resize(tLayers);
-        for (int i = sLayers; i < tLayers; ++i) {
-            tgt[i] = tgt[sLayers - 1];
-        }
+    for (int i = 0; i < m_nLayers; ++i) {
+        m_tice[i] = src[std::min(i, sLayers - 1)];
     }
 }
 } /* namespace Nextsim */
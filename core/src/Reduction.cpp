@@ -0,0 +1,254 @@
+/*!
+ * @file Reduction.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/Reduction.hpp"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace Nextsim {
+
+const int ReproducibleSum::nLimbs;
+const int ReproducibleSum::limbBits;
+
+// The limb values are in units of 2^-fractionBits
+static const int fractionBits = 3 * ReproducibleSum::limbBits;
+static const std::int64_t radix = std::int64_t(1) << ReproducibleSum::limbBits;
+// Each limb of a converted value is less than radix, so this many values can
+// be added to normalized limbs before the limbs could overflow.
+static const int maxPending = 1 << (62 - ReproducibleSum::limbBits);
+
+// The value of one unit of limb i, the most significant limb being 0
+static double limbWeight(int i)
+{
+    return std::ldexp(
+        1., ReproducibleSum::limbBits * (ReproducibleSum::nLimbs - 1 - i) - fractionBits);
+}
+
+ReproducibleSum::ReproducibleSum()
+    : m_pending(0)
+{
+    m_limbs.fill(0);
+}
+
+ReproducibleSum& ReproducibleSum::operator+=(double x)
+{
+    if (!std::isfinite(x)) {
+        throw std::domain_error("ReproducibleSum: non-finite value");
+    }
+    double remainder = std::fabs(x);
+    if (remainder >= limbWeight(0) * radix) {
+        throw std::overflow_error("ReproducibleSum: value too large to be summed");
+    }
+    if (m_pending == maxPending)
+        carry();
+    // Each step removes the leading bits exactly. Bits below the precision of
+    // the smallest limb are truncated.
+    std::int64_t sign = (x < 0) ? -1 : 1;
+    for (int i = 0; i < nLimbs; ++i) {
+        double weight = limbWeight(i);
+        double limb = std::floor(remainder / weight);
+        remainder -= limb * weight;
+        m_limbs[i] += sign * static_cast<std::int64_t>(limb);
+    }
+    ++m_pending;
+    return *this;
+}
+
+ReproducibleSum& ReproducibleSum::operator+=(const ReproducibleSum& other)
+{
+    ReproducibleSum normalized = other;
+    normalized.carry();
+    carry();
+    for (int i = 0; i < nLimbs; ++i) {
+        m_limbs[i] += normalized.m_limbs[i];
+    }
+    m_pending = 1;
+    return *this;
+}
+
+void ReproducibleSum::carry()
+{
+    for (int i = nLimbs - 1; i > 0; --i) {
+        std::int64_t c = m_limbs[i] / radix;
+        m_limbs[i] -= c * radix;
+        if (m_limbs[i] < 0) {
+            m_limbs[i] += radix;
+            --c;
+        }
+        m_limbs[i - 1] += c;
+    }
+    m_pending = 0;
+}
+
+double ReproducibleSum::value() const
+{
+    // The normalized limbs are unique for a given sum, so the conversion,
+    // from the least significant limb, always gives the same double.
+    ReproducibleSum normalized = *this;
+    normalized.carry();
+    double total = 0;
+    for (int i = nLimbs - 1; i >= 0; --i) {
+        total += normalized.m_limbs[i] * limbWeight(i);
+    }
+    return total;
+}
+
+#ifdef USE_MPI
+void ReproducibleSum::allReduce()
+{
+    carry();
+    std::array<std::int64_t, nLimbs> local = m_limbs;
+    MPI_Allreduce(local.data(), m_limbs.data(), nLimbs, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    carry();
+}
+
+void ReproducibleSum::allReduce(std::vector<ReproducibleSum>& sums)
+{
+    std::vector<std::int64_t> local(sums.size() * nLimbs);
+    for (std::size_t i = 0; i < sums.size(); ++i) {
+        sums[i].carry();
+        std::copy(sums[i].m_limbs.begin(), sums[i].m_limbs.end(), local.begin() + i * nLimbs);
+    }
+    std::vector<std::int64_t> global(local.size());
+    MPI_Allreduce(
+        local.data(), global.data(), local.size(), MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD);
+    for (std::size_t i = 0; i < sums.size(); ++i) {
+        std::copy(global.begin() + i * nLimbs, global.begin() + (i + 1) * nLimbs,
+            sums[i].m_limbs.begin());
+        sums[i].carry();
+    }
+}
+#endif
+
+// Calls a function with each local element and its area. The elements are
+// taken from the element storage when the structure has one, so that the
+// shared cursor of the structure is not used.
+template <typename Function>
+static void forEachElement(IStructure& structure, const Function& function)
+{
+    ElementVector* storage = structure.elementStorage();
+    if (storage) {
+        for (std::size_t i = 0; i < storage->size(); ++i) {
+            function((*storage)[i], structure.elementArea(i));
+        }
+        return;
+    }
+    for (structure.cursor = 0; structure.cursor; ++structure.cursor) {
+        function(*structure.cursor, structure.cursorArea());
+    }
+}
+
+// Sums a quantity, optionally weighted by the element area, over the local
+// elements, then over all ranks
+static double reproducibleSum(
+    IStructure& structure, const Reduction::Quantity& quantity, bool weighted)
+{
+    ReproducibleSum total;
+    forEachElement(structure, [&total, &quantity, weighted](const ElementData& data, double area) {
+        total += weighted ? quantity(data) * area : quantity(data);
+    });
+#ifdef USE_MPI
+    total.allReduce();
+#endif
+    return total.value();
+}
+
+double Reduction::sum(IStructure& structure, const Quantity& quantity)
+{
+    return reproducibleSum(structure, quantity, false);
+}
+
+double Reduction::areaIntegral(IStructure& structure, const Quantity& quantity)
+{
+    return reproducibleSum(structure, quantity, true);
+}
+
+std::vector<double> Reduction::areaIntegrals(
+    IStructure& structure, const std::vector<Quantity>& quantities)
+{
+    std::vector<ReproducibleSum> totals(quantities.size());
+    forEachElement(structure, [&totals, &quantities](const ElementData& data, double area) {
+        for (std::size_t i = 0; i < quantities.size(); ++i) {
+            totals[i] += quantities[i](data) * area;
+        }
+    });
+#ifdef USE_MPI
+    ReproducibleSum::allReduce(totals);
+#endif
+    std::vector<double> values;
+    for (auto& total : totals) {
+        values.push_back(total.value());
+    }
+    return values;
+}
+
+std::vector<double> Reduction::fieldAreaIntegrals(
+    IStructure& structure, const std::vector<FieldView<const double>>& fields)
+{
+    std::vector<ReproducibleSum> totals(fields.size());
+    const std::size_t nElements = fields.empty() ? 0 : fields.front().size();
+    for (std::size_t i = 0; i < nElements; ++i) {
+        const double area = structure.elementArea(i);
+        for (std::size_t f = 0; f < fields.size(); ++f) {
+            totals[f] += fields[f][i] * area;
+        }
+    }
+#ifdef USE_MPI
+    ReproducibleSum::allReduce(totals);
+#endif
+    std::vector<double> values;
+    for (auto& total : totals) {
+        values.push_back(total.value());
+    }
+    return values;
+}
+
+double Reduction::areaWeightedMean(IStructure& structure, const Quantity& quantity)
+{
+    double area = reproducibleSum(structure, [](const ElementData&) { return 1.; }, true);
+    return areaIntegral(structure, quantity) / area;
+}
+
+double Reduction::minimum(IStructure& structure, const Quantity& quantity)
+{
+    double localMin = std::numeric_limits<double>::infinity();
+    forEachElement(structure, [&localMin, &quantity](const ElementData& data, double) {
+        localMin = std::min(localMin, quantity(data));
+    });
+#ifdef USE_MPI
+    double globalMin;
+    MPI_Allreduce(&localMin, &globalMin, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    return globalMin;
+#else
+    return localMin;
+#endif
+}
+
+double Reduction::maximum(IStructure& structure, const Quantity& quantity)
+{
+    double localMax = -std::numeric_limits<double>::infinity();
+    forEachElement(structure, [&localMax, &quantity](const ElementData& data, double) {
+        localMax = std::max(localMax, quantity(data));
+    });
+#ifdef USE_MPI
+    double globalMax;
+    MPI_Allreduce(&localMax, &globalMax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return globalMax;
+#else
+    return localMax;
+#endif
+}
+
+} /* namespace Nextsim */
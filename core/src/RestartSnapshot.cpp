@@ -0,0 +1,98 @@
+/*!
+ * @file RestartSnapshot.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/RestartSnapshot.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace Nextsim {
+
+const std::uint64_t RestartSnapshot::initialChecksum;
+
+RestartSnapshot::RestartSnapshot()
+    : m_size(0)
+    , m_checksum(initialChecksum)
+{
+}
+
+void RestartSnapshot::take(const ElementVector& data)
+{
+    if (m_fields.empty()) {
+        for (auto& field : FieldRegistry::fields()) {
+            if (field.group == FieldRegistry::Group::PROGNOSTIC)
+                m_fields.push_back({ &field, 1, {} });
+        }
+    }
+    m_size = data.size();
+    m_checksum = initialChecksum;
+    for (auto& field : m_fields) {
+        FieldView<const double> view = FieldRegistry::view(data, field.description->name);
+        field.nLayers = view.nLayers();
+        field.values.resize(m_size * field.nLayers);
+        double* values = field.values.data();
+        for (std::size_t i = 0; i < m_size; ++i) {
+            for (int layer = 0; layer < field.nLayers; ++layer) {
+                *values++ = view(i, layer);
+            }
+        }
+        m_checksum = checksum(field.values.data(), field.values.size(), m_checksum);
+    }
+}
+
+void RestartSnapshot::restore(ElementVector& data) const
+{
+    if (data.size() != m_size) {
+        throw std::invalid_argument("RestartSnapshot: the snapshot holds "
+            + std::to_string(m_size) + " elements, not " + std::to_string(data.size()));
+    }
+    for (auto& field : m_fields) {
+        FieldView<double> view = FieldRegistry::mutableView(data, field.description->name);
+        if (view.nLayers() != field.nLayers) {
+            throw std::invalid_argument(
+                "RestartSnapshot: the layers of " + field.description->name + " differ");
+        }
+        const double* values = field.values.data();
+        for (std::size_t i = 0; i < m_size; ++i) {
+            for (int layer = 0; layer < field.nLayers; ++layer) {
+                view(i, layer) = *values++;
+            }
+        }
+    }
+}
+
+void RestartSnapshot::clear()
+{
+    std::vector<Field>().swap(m_fields);
+    m_size = 0;
+    m_checksum = initialChecksum;
+}
+
+std::size_t RestartSnapshot::bytes() const
+{
+    std::size_t total = 0;
+    for (auto& field : m_fields) {
+        total += field.values.size() * sizeof(double);
+    }
+    return total;
+}
+
+std::uint64_t RestartSnapshot::checksum(const double* values, std::size_t n, std::uint64_t seed)
+{
+    const std::uint64_t prime = 0x100000001b3ULL;
+    std::uint64_t hash = seed;
+    for (std::size_t i = 0; i < n; ++i) {
+        unsigned char bytes[sizeof(double)];
+        std::memcpy(bytes, values + i, sizeof(double));
+        for (unsigned char byte : bytes) {
+            hash = (hash ^ byte) * prime;
+        }
+    }
+    return hash;
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,260 @@
+/*!
+ * @file SharedMemoryCoupler.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/SharedMemoryCoupler.hpp"
+
+#include "include/ElementData.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Nextsim {
+
+// Identifies a complete segment. Written last by the model side.
+static const std::uint64_t segmentMagic = 0x4e58534d43504c31; // NXSMCPL1
+
+struct SharedMemoryCoupler::Header {
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t nElements;
+    sem_t forcingReady;
+    sem_t fluxesReady;
+};
+
+// The size of the header, keeping the arrays aligned to a cache line
+static const std::size_t headerSize = 256;
+static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t)
+        && 2 * sizeof(std::uint64_t) + 2 * sizeof(sem_t) <= headerSize,
+    "SharedMemoryCoupler: the header does not fit its space");
+
+static std::size_t segmentSize(std::size_t nElements)
+{
+    return headerSize
+        + nElements * (SharedMemoryCoupler::N_FORCING + SharedMemoryCoupler::N_FLUX)
+        * sizeof(double);
+}
+
+static std::runtime_error systemError(const std::string& what)
+{
+    return std::runtime_error("SharedMemoryCoupler: " + what + ": " + std::strerror(errno));
+}
+
+SharedMemoryCoupler::SharedMemoryCoupler(
+    const std::string& name, Side side, std::size_t nElements, double timeout)
+    : m_name(name)
+    , m_side(side)
+    , m_timeout(timeout)
+    , m_mapping(nullptr)
+    , m_size(0)
+    , m_header(nullptr)
+    , m_fields(nullptr)
+{
+    if (side == Side::MODEL) {
+        create(nElements);
+    } else {
+        attach();
+    }
+    m_header = static_cast<Header*>(m_mapping);
+    m_fields = reinterpret_cast<double*>(static_cast<char*>(m_mapping) + headerSize);
+}
+
+SharedMemoryCoupler::~SharedMemoryCoupler()
+{
+    // The semaphores are not destroyed, as the partner may still be using
+    // them. The memory is released when both sides have unmapped it.
+    munmap(m_mapping, m_size);
+    if (m_side == Side::MODEL) {
+        shm_unlink(m_name.c_str());
+    }
+}
+
+void SharedMemoryCoupler::create(std::size_t nElements)
+{
+    // Replace any segment left by an earlier run
+    shm_unlink(m_name.c_str());
+    int fd = shm_open(m_name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        throw systemError("cannot create " + m_name);
+    m_size = segmentSize(nElements);
+    if (ftruncate(fd, m_size) != 0) {
+        close(fd);
+        shm_unlink(m_name.c_str());
+        throw systemError("cannot size " + m_name);
+    }
+    m_mapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m_mapping == MAP_FAILED) {
+        shm_unlink(m_name.c_str());
+        throw systemError("cannot map " + m_name);
+    }
+
+    // The new segment is zero filled, so the partner sees no magic number
+    // until the header is complete
+    Header* header = static_cast<Header*>(m_mapping);
+    header->nElements = nElements;
+    sem_init(&header->forcingReady, 1, 0);
+    sem_init(&header->fluxesReady, 1, 0);
+    header->magic.store(segmentMagic, std::memory_order_release);
+}
+
+void SharedMemoryCoupler::attach()
+{
+    auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(m_timeout));
+    // Wait until the model side has created and sized the segment, and
+    // completed its header
+    while (true) {
+        int fd = shm_open(m_name.c_str(), O_RDWR, 0);
+        if (fd >= 0) {
+            struct stat status;
+            if (fstat(fd, &status) == 0 && status.st_size >= off_t(headerSize)) {
+                m_size = status.st_size;
+                m_mapping = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                close(fd);
+                if (m_mapping == MAP_FAILED)
+                    throw systemError("cannot map " + m_name);
+                Header* header = static_cast<Header*>(m_mapping);
+                if (header->magic.load(std::memory_order_acquire) == segmentMagic
+                    && m_size >= segmentSize(header->nElements)) {
+                    return;
+                }
+                munmap(m_mapping, m_size);
+            } else {
+                close(fd);
+            }
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error(
+                "SharedMemoryCoupler: timed out waiting for the segment " + m_name);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+std::size_t SharedMemoryCoupler::nElements() const { return m_header->nElements; }
+
+double* SharedMemoryCoupler::forcing(Forcing field)
+{
+    return m_fields + field * m_header->nElements;
+}
+
+double* SharedMemoryCoupler::flux(Flux field)
+{
+    return m_fields + (N_FORCING + field) * m_header->nElements;
+}
+
+void SharedMemoryCoupler::sendForcing() { sem_post(&m_header->forcingReady); }
+
+void SharedMemoryCoupler::receiveForcing() { wait(&m_header->forcingReady, "forcing"); }
+
+void SharedMemoryCoupler::sendFluxes() { sem_post(&m_header->fluxesReady); }
+
+void SharedMemoryCoupler::receiveFluxes() { wait(&m_header->fluxesReady, "fluxes"); }
+
+void SharedMemoryCoupler::wait(void* semaphore, const std::string& what)
+{
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    double whole;
+    double fraction = std::modf(m_timeout, &whole);
+    deadline.tv_sec += static_cast<time_t>(whole);
+    deadline.tv_nsec += static_cast<long>(fraction * 1e9);
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_nsec -= 1000000000;
+        ++deadline.tv_sec;
+    }
+    while (sem_timedwait(static_cast<sem_t*>(semaphore), &deadline) != 0) {
+        if (errno == ETIMEDOUT) {
+            throw std::runtime_error("SharedMemoryCoupler: timed out waiting for the " + what
+                + " of " + m_name);
+        } else if (errno != EINTR) {
+            throw systemError("waiting for the " + what + " of " + m_name);
+        }
+    }
+}
+
+static std::runtime_error elementCountError(std::size_t nSegment)
+{
+    return std::runtime_error("SharedMemoryCoupler: the structure does not have the "
+        + std::to_string(nSegment) + " elements of the segment");
+}
+
+// The elements of a structure, which are accessed by index so that the
+// stages of the model do not share the cursor of the structure
+static ElementVector& coupledElements(IStructure& structure, std::size_t nSegment)
+{
+    ElementVector* storage = structure.elementStorage();
+    if (!storage) {
+        throw std::invalid_argument(
+            "SharedMemoryCoupler: the structure does not provide storage of its elements");
+    }
+    if (storage->size() != nSegment)
+        throw elementCountError(nSegment);
+    return *storage;
+}
+
+void SharedMemoryCoupler::receiveForcing(IStructure& structure)
+{
+    receiveForcing();
+    applyForcing(m_fields, nElements(), structure);
+}
+
+void SharedMemoryCoupler::applyForcing(const double* fields, std::size_t n, IStructure& structure)
+{
+    const double* tair = fields + AIR_TEMPERATURE * n;
+    const double* dair = fields + DEW_POINT * n;
+    const double* slp = fields + AIR_PRESSURE * n;
+    const double* mixrat = fields + MIXING_RATIO * n;
+    const double* sw = fields + SHORTWAVE * n;
+    const double* lw = fields + LONGWAVE * n;
+    const double* mld = fields + MIXED_LAYER_DEPTH * n;
+    const double* snow = fields + SNOWFALL * n;
+    ElementVector& elements = coupledElements(structure, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        // The setters mark the data as modified
+        ExternalData& exter = elements[i];
+        exter.setAirTemperature(tair[i]);
+        exter.setDewPoint2m(dair[i]);
+        exter.setAirPressure(slp[i]);
+        exter.setMixingRatio(mixrat[i]);
+        exter.setIncomingShortwave(sw[i]);
+        exter.setIncomingLongwave(lw[i]);
+        exter.setMixedLayerDepth(mld[i]);
+        exter.setSnowfall(snow[i]);
+    }
+}
+
+void SharedMemoryCoupler::sendFluxes(IStructure& structure)
+{
+    const std::size_t n = nElements();
+    double* qio = flux(ICE_OCEAN_HEAT);
+    double* evap = flux(EVAPORATION);
+    double* newIce = flux(NEW_ICE);
+    ElementVector& elements = coupledElements(structure, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const PhysicsData& phys = elements[i];
+        qio[i] = phys.iceOceanHeatFlux();
+        evap[i] = phys.evaporationRate();
+        newIce[i] = phys.newIceThickness();
+    }
+    sendFluxes();
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,84 @@
+/*!
+ * @file SlabPartner.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/SlabPartner.hpp"
+
+#include "include/constants.hpp"
+
+namespace Nextsim {
+
+const double SlabPartner::referenceAirTemperature = -1.;
+const double SlabPartner::relaxationTime = 5 * 86400.;
+// About the heat capacity of the lowest 1000 m of the atmosphere
+const double SlabPartner::airHeatCapacity = 1.e7;
+const double SlabPartner::mixedLayerDepth = 10.;
+
+// Values of the forcing that are not derived from the slab state, as in DummyExternalData
+static const double dewPointDepression = 3.;
+static const double seaLevelPressure = 1e5;
+
+SlabPartner::SlabPartner(const std::string& name, double timestep, double timeout)
+    : m_coupler(name, SharedMemoryCoupler::Side::PARTNER, 0, timeout)
+    , m_dt(timestep)
+    , m_tair(m_coupler.nElements(), referenceAirTemperature)
+    , m_tml(m_coupler.nElements(), Water::TfOcean)
+    , m_evaporated(m_coupler.nElements(), 0.)
+    , m_newIce(m_coupler.nElements(), 0.)
+{
+}
+
+void SlabPartner::sendForcing()
+{
+    double* tair = m_coupler.forcing(SharedMemoryCoupler::AIR_TEMPERATURE);
+    double* dair = m_coupler.forcing(SharedMemoryCoupler::DEW_POINT);
+    double* slp = m_coupler.forcing(SharedMemoryCoupler::AIR_PRESSURE);
+    double* mixrat = m_coupler.forcing(SharedMemoryCoupler::MIXING_RATIO);
+    double* sw = m_coupler.forcing(SharedMemoryCoupler::SHORTWAVE);
+    double* lw = m_coupler.forcing(SharedMemoryCoupler::LONGWAVE);
+    double* mld = m_coupler.forcing(SharedMemoryCoupler::MIXED_LAYER_DEPTH);
+    double* snow = m_coupler.forcing(SharedMemoryCoupler::SNOWFALL);
+    for (std::size_t i = 0; i < m_tair.size(); ++i) {
+        const double tk = kelvin(m_tair[i]);
+        tair[i] = m_tair[i];
+        dair[i] = m_tair[i] - dewPointDepression;
+        slp[i] = seaLevelPressure;
+        // No mixing ratio, so that the dew point is used
+        mixrat[i] = -1;
+        sw[i] = 0;
+        lw[i] = PhysicalConstants::sigma * tk * tk * tk * tk;
+        mld[i] = mixedLayerDepth;
+        snow[i] = 0;
+    }
+    m_coupler.sendForcing();
+}
+
+void SlabPartner::receiveFluxes()
+{
+    m_coupler.receiveFluxes();
+    const double* qio = m_coupler.flux(SharedMemoryCoupler::ICE_OCEAN_HEAT);
+    const double* evap = m_coupler.flux(SharedMemoryCoupler::EVAPORATION);
+    const double* newIce = m_coupler.flux(SharedMemoryCoupler::NEW_ICE);
+    const double mlHeatCapacity = mixedLayerDepth * Water::rhoOcean * Water::cp;
+    for (std::size_t i = 0; i < m_tair.size(); ++i) {
+        m_tair[i] += m_dt
+            * ((referenceAirTemperature - m_tair[i]) / relaxationTime
+                + evap[i] * Water::Lv0 / airHeatCapacity);
+        m_tml[i] -= qio[i] * m_dt / mlHeatCapacity;
+        m_evaporated[i] += evap[i] * m_dt;
+        m_newIce[i] += newIce[i];
+    }
+}
+
+void SlabPartner::run(int nSteps)
+{
+    for (int step = 0; step < nSteps; ++step) {
+        sendForcing();
+        receiveFluxes();
+    }
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,169 @@
+/*!
+ * @file Statistics.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/Statistics.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Nextsim {
+
+FieldStatistics::FieldStatistics(const std::string& field, const Bins& bins)
+    : m_name(FieldRegistry::field(field).name)
+    , m_bins(bins)
+    , m_count(0)
+    , m_size(0)
+    , m_nLayers(1)
+    , m_rounded(false)
+{
+    if (bins.nBins < 0 || (bins.nBins > 0 && !(bins.upper > bins.lower))) {
+        throw std::invalid_argument(
+            "FieldStatistics: the histogram bins of " + field + " are not ordered");
+    }
+}
+
+void FieldStatistics::update(const ElementVector& data)
+{
+    FieldView<const double> view = FieldRegistry::view(data, m_name);
+    if (m_count == 0) {
+        m_size = view.size();
+        m_nLayers = view.nLayers();
+        const std::size_t nValues = m_size * m_nLayers;
+        m_mean.assign(nValues, 0.);
+        m_m2.assign(nValues, 0.);
+        m_min.assign(nValues, 0.);
+        m_max.assign(nValues, 0.);
+        m_histogram.assign(nValues * m_bins.nBins, 0);
+    } else if (view.size() != m_size || view.nLayers() != m_nLayers) {
+        throw std::invalid_argument(
+            "FieldStatistics: the size of " + m_name + " has changed since the last update");
+    }
+
+    m_rounded = false;
+    ++m_count;
+    const double weight = 1. / m_count;
+    const double binsPerUnit
+        = (m_bins.nBins > 0) ? m_bins.nBins / (m_bins.upper - m_bins.lower) : 0.;
+    for (std::size_t i = 0; i < m_size; ++i) {
+        for (int layer = 0; layer < m_nLayers; ++layer) {
+            const double value = view(i, layer);
+            const std::size_t j = index(i, layer);
+            const double delta = value - m_mean[j];
+            m_mean[j] += delta * weight;
+            m_m2[j] += delta * (value - m_mean[j]);
+            if (m_count == 1) {
+                m_min[j] = value;
+                m_max[j] = value;
+            } else {
+                m_min[j] = std::min(m_min[j], value);
+                m_max[j] = std::max(m_max[j], value);
+            }
+            if (m_bins.nBins > 0) {
+                // The end bins also count the values outside the range
+                const double position = (value - m_bins.lower) * binsPerUnit;
+                int bin = 0;
+                if (position >= m_bins.nBins) {
+                    bin = m_bins.nBins - 1;
+                } else if (position > 0.) {
+                    bin = int(position);
+                }
+                ++m_histogram[j * m_bins.nBins + bin];
+            }
+        }
+    }
+}
+
+void FieldStatistics::reset()
+{
+    m_count = 0;
+    m_rounded = false;
+    std::fill(m_mean.begin(), m_mean.end(), 0.);
+    std::fill(m_m2.begin(), m_m2.end(), 0.);
+    std::fill(m_min.begin(), m_min.end(), 0.);
+    std::fill(m_max.begin(), m_max.end(), 0.);
+    std::fill(m_histogram.begin(), m_histogram.end(), 0);
+}
+
+void FieldStatistics::round(const BitRounding& rounding, ThreadTeam& team)
+{
+    varianceData();
+    const std::size_t n = m_mean.size();
+    rounding.round(m_name, m_mean.data(), n, team);
+    rounding.round(m_name, m_variance.data(), n, team);
+    rounding.round(m_name, m_min.data(), n, team);
+    rounding.round(m_name, m_max.data(), n, team);
+    m_rounded = true;
+}
+
+const double* FieldStatistics::varianceData() const
+{
+    if (m_rounded)
+        return m_variance.data();
+    m_variance.resize(m_m2.size());
+    for (std::size_t j = 0; j < m_m2.size(); ++j) {
+        m_variance[j] = (m_count > 0) ? m_m2[j] / m_count : 0.;
+    }
+    return m_variance.data();
+}
+
+Statistics::Statistics()
+    : m_window(1)
+    , m_newWindow(true)
+    , m_currentStart(0)
+    , m_windowCompleted(false)
+    , m_completedStart(0)
+    , m_completedEnd(0)
+{
+}
+
+void Statistics::add(const std::string& field, const FieldStatistics::Bins& bins)
+{
+    m_current.push_back(FieldStatistics(field, bins));
+    m_completed.push_back(m_current.back());
+}
+
+void Statistics::setWindow(Iterator::Duration window)
+{
+    if (window <= 0) {
+        throw std::invalid_argument("Statistics: the window length must be positive");
+    }
+    m_window = window;
+}
+
+bool Statistics::update(const ElementVector& data, Iterator::TimePoint time, Iterator::Duration dt)
+{
+    if (m_newWindow) {
+        m_currentStart = time;
+        m_newWindow = false;
+    }
+    for (auto& field : m_current) {
+        field.update(data);
+    }
+    const Iterator::TimePoint end = time + dt;
+    m_windowCompleted = (end - m_currentStart >= m_window);
+    if (m_windowCompleted) {
+        // Keep the completed statistics, and reuse the storage of the
+        // previous window for the next one
+        m_current.swap(m_completed);
+        for (auto& field : m_current) {
+            field.reset();
+        }
+        m_completedStart = m_currentStart;
+        m_completedEnd = end;
+        m_newWindow = true;
+    }
+    return m_windowCompleted;
+}
+
+void Statistics::roundCompleted(const BitRounding& rounding, ThreadTeam& team)
+{
+    for (auto& field : m_completed) {
+        field.round(rounding, team);
+    }
+}
+
+} /* namespace Nextsim */
@@ -8,6 +8,8 @@
 #include "include/StructureFactory.hpp"
 #include "include/DevGrid.hpp"
 #include "include/DevGridIO.hpp"
+#include "include/UnstructuredMesh.hpp"
+#include "include/UnstructuredMeshIO.hpp"
 
 #include <ncFile.h>
 #include <ncGroup.h>
@@ -31,6 +33,10 @@ std::shared_ptr<IStructure> StructureFactory::generate(const std::string& struct
             if (shst->structureTypeCheck(DevGrid::structureName)) {
                 std::shared_ptr<DevGrid> shdg = std::dynamic_pointer_cast<DevGrid>(shst);
                 shdg->setIO(new DevGridIO(*shdg));
+            } else if (shst->structureTypeCheck(UnstructuredMesh::structureName)) {
+                std::shared_ptr<UnstructuredMesh> shum
+                    = std::dynamic_pointer_cast<UnstructuredMesh>(shst);
+                shum->setIO(new UnstructuredMeshIO(*shum));
             }
 
             return shst;
@@ -0,0 +1,177 @@
+/*!
+ * @file TaskGraph.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/TaskGraph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace Nextsim {
+
+TaskGraph::TaskGraph()
+    : m_nThreads(0)
+    , m_maxLead(1)
+{
+}
+
+void TaskGraph::addStage(const std::string& name, const Stage& stage,
+    const std::vector<std::string>& dependencies,
+    const std::vector<std::string>& previousStepDependencies)
+{
+    if (hasStage(name)) {
+        throw std::invalid_argument("TaskGraph: duplicate stage name (" + name + ")");
+    }
+    m_nodes.push_back({ name, stage, dependencies, previousStepDependencies });
+}
+
+bool TaskGraph::hasStage(const std::string& name) const
+{
+    for (auto& node : m_nodes) {
+        if (node.name == name)
+            return true;
+    }
+    return false;
+}
+
+namespace {
+    // The execution state of one run of the graph, shared between the worker threads.
+    class Execution {
+    public:
+        Execution(std::size_t nStages, int nSteps, int maxLead)
+            : nSteps(nSteps)
+            , maxLead(maxLead)
+            , completed(nStages, 0)
+            , running(nStages, false)
+            , deps(nStages)
+            , prevDeps(nStages)
+            , nRunning(0)
+        {
+        }
+
+        // Returns the index of a stage that can run now, or none().
+        std::size_t ready() const
+        {
+            int oldest = *std::min_element(completed.begin(), completed.end());
+            std::size_t chosen = none();
+            for (std::size_t s = 0; s < completed.size(); ++s) {
+                int step = completed[s];
+                if (running[s] || step >= nSteps || step > oldest + maxLead)
+                    continue;
+                bool ok = true;
+                for (std::size_t d : deps[s])
+                    ok = ok && (completed[d] > step);
+                for (std::size_t p : prevDeps[s])
+                    ok = ok && (completed[p] >= step);
+                // Prefer the stage with the oldest pending timestep
+                if (ok && (chosen == none() || step < completed[chosen]))
+                    chosen = s;
+            }
+            return chosen;
+        }
+
+        // The index returned by ready() when no stage can run
+        std::size_t none() const { return completed.size(); }
+
+        bool finished() const
+        {
+            return *std::min_element(completed.begin(), completed.end()) >= nSteps;
+        }
+
+        const int nSteps;
+        const int maxLead;
+        std::vector<int> completed;
+        std::vector<bool> running;
+        std::vector<std::vector<std::size_t>> deps;
+        std::vector<std::vector<std::size_t>> prevDeps;
+        int nRunning;
+        std::exception_ptr error;
+        std::mutex mtx;
+        std::condition_variable cv;
+    };
+}
+
+void TaskGraph::run(int nSteps)
+{
+    if (m_nodes.empty() || nSteps <= 0)
+        return;
+
+    const std::size_t nStages = m_nodes.size();
+    Execution exec(nStages, nSteps, m_maxLead);
+
+    // Resolve the dependency names to stage indices, ignoring undeclared stages
+    typedef std::vector<std::size_t> Indices;
+    auto resolve = [this](const std::vector<std::string>& names, Indices& indices) {
+        for (auto& name : names) {
+            for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+                if (m_nodes[i].name == name)
+                    indices.push_back(i);
+            }
+        }
+    };
+    for (std::size_t s = 0; s < nStages; ++s) {
+        resolve(m_nodes[s].dependencies, exec.deps[s]);
+        resolve(m_nodes[s].previousStepDependencies, exec.prevDeps[s]);
+    }
+
+    auto work = [this, &exec]() {
+        std::unique_lock<std::mutex> lock(exec.mtx);
+        while (!exec.error && !exec.finished()) {
+            std::size_t s = exec.ready();
+            if (s == exec.none()) {
+                if (exec.nRunning == 0) {
+                    // Nothing is running and nothing can run
+                    exec.error = std::make_exception_ptr(
+                        std::logic_error("TaskGraph: the stage dependencies contain a cycle"));
+                    exec.cv.notify_all();
+                } else {
+                    exec.cv.wait(lock);
+                }
+                continue;
+            }
+            int step = exec.completed[s];
+            exec.running[s] = true;
+            ++exec.nRunning;
+            lock.unlock();
+            std::exception_ptr thrown;
+            try {
+                m_nodes[s].stage(step);
+            } catch (...) {
+                thrown = std::current_exception();
+            }
+            lock.lock();
+            exec.running[s] = false;
+            --exec.nRunning;
+            ++exec.completed[s];
+            if (thrown && !exec.error)
+                exec.error = thrown;
+            exec.cv.notify_all();
+        }
+    };
+
+    int nThreads = (m_nThreads > 0) ? m_nThreads : std::thread::hardware_concurrency();
+    nThreads = std::max(1, std::min(nThreads, int(nStages)));
+
+    // The calling thread is one of the workers
+    std::vector<std::thread> workers;
+    for (int i = 1; i < nThreads; ++i) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (exec.error)
+        std::rethrow_exception(exec.error);
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,229 @@
+/*!
+ * @file ThreadTeam.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/ThreadTeam.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace Nextsim {
+
+ThreadTeam ThreadTeam::main;
+
+ThreadTeam::ThreadTeam()
+    : m_nThreads(1)
+    , m_pin(false)
+    , m_cores(affinity())
+    , m_task(nullptr)
+    , m_generation(0)
+    , m_running(0)
+    , m_stopping(false)
+{
+}
+
+ThreadTeam::~ThreadTeam() { stopWorkers(); }
+
+void ThreadTeam::setThreads(int nThreads)
+{
+    if (nThreads <= 0)
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::lock_guard<std::mutex> running(m_runMutex);
+    if (nThreads == m_nThreads)
+        return;
+    stopWorkers();
+    m_nThreads = nThreads;
+    startWorkers();
+}
+
+void ThreadTeam::setPinning(bool pin)
+{
+    std::lock_guard<std::mutex> running(m_runMutex);
+    if (pin == m_pin)
+        return;
+    stopWorkers();
+    m_pin = pin;
+    startWorkers();
+}
+
+void ThreadTeam::startWorkers()
+{
+    // Workers wait for the tasks after the current generation, even if they
+    // start after the first task has been issued
+    for (int thread = 1; thread < m_nThreads; ++thread) {
+        m_workers.emplace_back(&ThreadTeam::work, this, thread, m_generation);
+    }
+}
+
+void ThreadTeam::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_start.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+    m_stopping = false;
+}
+
+void ThreadTeam::work(int thread, unsigned long done)
+{
+    if (m_pin)
+        pinThread(thread);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this, done] { return m_stopping || m_generation != done; });
+            if (m_stopping)
+                return;
+            done = m_generation;
+        }
+        execute(thread);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_running == 0)
+                m_done.notify_one();
+        }
+    }
+}
+
+void ThreadTeam::execute(int thread)
+{
+    try {
+        (*m_task)(thread);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_error)
+            m_error = std::current_exception();
+    }
+}
+
+// Pins the calling thread as thread 0 of a team for its lifetime, then
+// restores the previous affinity of the thread
+class ThreadTeam::CallerPin {
+public:
+    CallerPin(ThreadTeam& team)
+        : m_pinned(team.m_pin)
+    {
+        if (m_pinned) {
+            m_previous = affinity();
+            team.pinThread(0);
+        }
+    }
+    ~CallerPin()
+    {
+        if (m_pinned)
+            setAffinity(m_previous);
+    }
+
+private:
+    bool m_pinned;
+    std::vector<int> m_previous;
+};
+
+void ThreadTeam::run(const Task& task)
+{
+    std::lock_guard<std::mutex> running(m_runMutex);
+    CallerPin pin(*this);
+    if (m_nThreads == 1) {
+        task(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_error = nullptr;
+        m_running = m_nThreads - 1;
+        ++m_generation;
+    }
+    m_start.notify_all();
+    execute(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_running == 0; });
+    m_task = nullptr;
+    if (m_error)
+        std::rethrow_exception(m_error);
+}
+
+void ThreadTeam::firstTouch(void* storage, std::size_t nItems, std::size_t itemSize)
+{
+    if (m_nThreads == 1 || nItems == 0)
+        return;
+#ifdef __linux__
+    const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+#else
+    const std::size_t pageSize = 4096;
+#endif
+    char* base = static_cast<char*>(storage);
+    run([=](int thread) {
+        auto items = block(nItems, thread, m_nThreads);
+        if (items.first == items.second)
+            return;
+        volatile char* first = base + items.first * itemSize;
+        volatile char* last = base + items.second * itemSize;
+        // One write in every page of the block, including the last
+        for (volatile char* p = first; p < last; p += pageSize) {
+            *p = 0;
+        }
+        *(last - 1) = 0;
+    });
+}
+
+std::pair<std::size_t, std::size_t> ThreadTeam::block(
+    std::size_t nItems, int thread, int nThreads)
+{
+    std::size_t base = nItems / nThreads;
+    std::size_t extra = nItems % nThreads;
+    std::size_t t = thread;
+    std::size_t first = t * base + std::min(t, extra);
+    return { first, first + base + ((t < extra) ? 1 : 0) };
+}
+
+void ThreadTeam::pinThread(int thread)
+{
+    if (!m_cores.empty())
+        setAffinity({ m_cores[thread % m_cores.size()] });
+}
+
+std::vector<int> ThreadTeam::affinity()
+{
+    std::vector<int> cores;
+#ifdef __linux__
+    cpu_set_t set;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        for (int core = 0; core < CPU_SETSIZE; ++core) {
+            if (CPU_ISSET(core, &set))
+                cores.push_back(core);
+        }
+    }
+#endif
+    return cores;
+}
+
+void ThreadTeam::setAffinity(const std::vector<int>& cores)
+{
+#ifdef __linux__
+    if (cores.empty())
+        return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        CPU_SET(core, &set);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
+} /* namespace Nextsim */
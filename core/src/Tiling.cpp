@@ -0,0 +1,95 @@
+/*!
+ * @file Tiling.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/Tiling.hpp"
+
+#include "include/ThreadTeam.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace Nextsim {
+
+const int Tiling::defaultTileSize;
+
+Tiling::Tiling()
+    : Tiling(defaultTileSize)
+{
+}
+
+Tiling::Tiling(int tileSize) { setTileSize(tileSize); }
+
+void Tiling::setTileSize(int tileSize)
+{
+    if (tileSize < 1) {
+        throw std::invalid_argument(
+            "Tiling: the tile size must be at least one (" + std::to_string(tileSize) + ")");
+    }
+    m_tileSize = tileSize;
+}
+
+void Tiling::run(IStructure& structure)
+{
+    ThreadTeam& team = structure.context().threadTeam();
+    elements(structure, m_elements);
+    if (team.nThreads() == 1) {
+        m_tile.clear();
+        m_tile.reserve(m_tileSize);
+        for (ElementData* pData : m_elements) {
+            m_tile.push_back(pData);
+            if (static_cast<int>(m_tile.size()) == m_tileSize) {
+                runPasses(m_tile);
+            }
+        }
+        runPasses(m_tile);
+        return;
+    }
+
+    // Divide the elements between the threads in the same blocks as were
+    // used to first touch the memory of the elements
+    team.run([this, &team](int thread) {
+        auto items = ThreadTeam::block(m_elements.size(), thread, team.nThreads());
+        Tile tile;
+        tile.reserve(m_tileSize);
+        for (std::size_t i = items.first; i < items.second; ++i) {
+            tile.push_back(m_elements[i]);
+            if (static_cast<int>(tile.size()) == m_tileSize) {
+                runPasses(tile);
+            }
+        }
+        runPasses(tile);
+    });
+}
+
+void Tiling::elements(IStructure& structure, std::vector<ElementData*>& elements)
+{
+    elements.clear();
+    ElementVector* storage = structure.elementStorage();
+    if (storage) {
+        elements.reserve(storage->size());
+        for (ElementData& data : *storage) {
+            elements.push_back(&data);
+        }
+        return;
+    }
+    for (structure.cursor = 0; structure.cursor; ++structure.cursor) {
+        elements.push_back(&*structure.cursor);
+    }
+}
+
+void Tiling::runPasses(Tile& tile) const
+{
+    if (tile.empty())
+        return;
+    for (auto& pass : m_passes) {
+        pass(tile);
+    }
+    tile.clear();
+}
+
+} /* namespace Nextsim */
@@ -13,6 +13,7 @@
 #include <map>
 #include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 namespace Nextsim {
@@ -58,9 +59,24 @@ void Timer::tock()
 void Timer::TimerNode::tick() { timeKeeper.start(); }
 
 void Timer::TimerNode::tock() { timeKeeper.stop(); }
-// TODO: implement lap and elapsed
-double Timer::lap(const Key& timerName) const { return 0; }
-double Timer::elapsed(const Key& timerName) const { return 0; }
+
+static double secondsFromWall(const Timer::WallTimeDuration& wall)
+{
+    return std::chrono::duration_cast<std::chrono::duration<double>>(wall).count();
+}
+
+double Timer::lap(const Key& timerName) const
+{
+    const Chrono& timeKeeper = firstMatch(timerName).timeKeeper;
+    if (!timeKeeper.running())
+        return 0;
+    return secondsFromWall(std::chrono::high_resolution_clock::now() - timeKeeper.wallHack());
+}
+
+double Timer::elapsed(const Key& timerName) const
+{
+    return secondsFromWall(firstMatch(timerName).timeKeeper.wallTime());
+}
 
 void Timer::additionalTime(
     const TimerPath& path, WallTimeDuration wallAdd, CpuTimeDuration cpuAdd, int ticksAdd)
@@ -91,6 +107,15 @@ Timer::TimerPath Timer::pathToFirstMatch(const Key& timerName) const
     return root.searchDescendants(timerName);
 }
 
+const Timer::TimerNode& Timer::firstMatch(const Key& timerName) const
+{
+    const TimerNode* node = root.findDescendant(timerName);
+    if (!node) {
+        throw std::out_of_range("Timer: no timer named " + timerName);
+    }
+    return *node;
+}
+
 std::ostream& Timer::report(const Key& timerName, std::ostream& os) const
 {
     return report(pathToFirstMatch(timerName), os);
@@ -133,6 +158,20 @@ Timer::TimerPath Timer::TimerNode::searchDescendants(const Key& timerName) const
     return path;
 }
 
+const Timer::TimerNode* Timer::TimerNode::findDescendant(const Key& timerName) const
+{
+    // Depth first, so the first match is the one reached by always taking the
+    // first child in key order
+    for (auto& child : childNodes) {
+        if (child.first == timerName)
+            return &child.second;
+        const TimerNode* match = child.second.findDescendant(timerName);
+        if (match)
+            return match;
+    }
+    return nullptr;
+}
+
 inline int msCountFromWall(const Timer::WallTimeDuration& wall)
 {
     return std::chrono::duration_cast<std::chrono::microseconds>(wall).count();
@@ -0,0 +1,177 @@
+/*!
+ * @file UnstructuredMeshIO.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/UnstructuredMeshIO.hpp"
+
+#include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/IStructure.hpp"
+#include "include/RestartSnapshot.hpp"
+#include "include/UnstructuredMesh.hpp"
+
+#include <array>
+#include <cstddef>
+#include <ncDim.h>
+#include <ncDouble.h>
+#include <ncFile.h>
+#include <ncInt.h>
+#include <ncVar.h>
+
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+namespace {
+
+const std::string unitsAttributeName = "units";
+const std::string ticeName = "tice";
+const std::string nodeXName = "node_x";
+const std::string nodeYName = "node_y";
+const std::string elementNodesName = "element_nodes";
+
+// The names of the node, element, vertex and layer dimensions
+enum DimName { NODE_DIM, ELEMENT_DIM, VERTEX_DIM, Z_DIM, N_DIMS };
+typedef std::array<std::string, N_DIMS> DimNames;
+
+// The dimensions of the fields of a file
+struct FieldDims {
+    netCDF::NcDim element;
+    netCDF::NcDim layers;
+};
+
+// Writes the metadata and the mesh of a file, in the original order of the
+// mesh, and returns the data group
+netCDF::NcGroup dumpMesh(netCDF::NcFile& ncFile, const UnstructuredMesh& mesh,
+    const DimNames& dimNames, int nLayers, FieldDims& fieldDims)
+{
+    netCDF::NcGroup metaGroup = ncFile.addGroup(IStructure::metadataNodeName());
+    netCDF::NcGroup dataGroup = ncFile.addGroup(IStructure::dataNodeName());
+    metaGroup.putAtt(IStructure::typeNodeName(), UnstructuredMesh::structureName);
+
+    netCDF::NcDim nodeDim = dataGroup.addDim(dimNames[NODE_DIM], mesh.nNodes());
+    fieldDims.element = dataGroup.addDim(dimNames[ELEMENT_DIM], mesh.nElements());
+    netCDF::NcDim vertexDim = dataGroup.addDim(dimNames[VERTEX_DIM], mesh.nMaxVertices());
+    fieldDims.layers = dataGroup.addDim(dimNames[Z_DIM], nLayers);
+
+    std::vector<double> nodeX;
+    std::vector<double> nodeY;
+    std::vector<int> elementNodes;
+    mesh.originalMesh(nodeX, nodeY, elementNodes);
+    netCDF::NcVar xVar(dataGroup.addVar(nodeXName, netCDF::ncDouble, nodeDim));
+    xVar.putAtt(unitsAttributeName, "m");
+    xVar.putVar(nodeX.data());
+    netCDF::NcVar yVar(dataGroup.addVar(nodeYName, netCDF::ncDouble, nodeDim));
+    yVar.putAtt(unitsAttributeName, "m");
+    yVar.putVar(nodeY.data());
+    netCDF::NcVar nodesVar(
+        dataGroup.addVar(elementNodesName, netCDF::ncInt, { fieldDims.element, vertexDim }));
+    nodesVar.setFill(true, UnstructuredMesh::noNode());
+    nodesVar.putVar(elementNodes.data());
+
+    return dataGroup;
+}
+
+// Writes a field of the elements, nValues for each, in the original element order
+void dumpField(netCDF::NcGroup& dataGroup, const UnstructuredMesh& mesh,
+    const FieldDims& fieldDims, const FieldRegistry::Field& field, const double* values,
+    std::ptrdiff_t stride, int nValues, std::vector<double>& original)
+{
+    std::vector<netCDF::NcDim> dims = { fieldDims.element };
+    if (field.dimensions == FieldRegistry::Dimensions::LAYERED)
+        dims.push_back(fieldDims.layers);
+    netCDF::NcVar var(dataGroup.addVar(field.name, netCDF::ncDouble, dims));
+    var.putAtt(unitsAttributeName, field.units);
+    original.resize(mesh.nElements() * nValues);
+    mesh.toOriginalOrder(values, stride, nValues, original.data());
+    var.putVar(original.data());
+}
+
+} /* namespace */
+
+void UnstructuredMeshIO::init(ElementVector& data, const std::string& filePath) const
+{
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::read);
+    netCDF::NcGroup dataGroup(ncFile.getGroup(IStructure::dataNodeName()));
+
+    std::size_t nNodes = dataGroup.getDim(UnstructuredMesh::nodeDimName).getSize();
+    std::size_t nElements = dataGroup.getDim(UnstructuredMesh::elementDimName).getSize();
+    int nMaxVertices = dataGroup.getDim(UnstructuredMesh::vertexDimName).getSize();
+    std::vector<double> nodeX(nNodes);
+    std::vector<double> nodeY(nNodes);
+    std::vector<int> elementNodes(nElements * nMaxVertices);
+    dataGroup.getVar(nodeXName).getVar(nodeX.data());
+    dataGroup.getVar(nodeYName).getVar(nodeY.data());
+    dataGroup.getVar(elementNodesName).getVar(elementNodes.data());
+    mesh->setMesh(nodeX, nodeY, elementNodes, nMaxVertices);
+
+    // Get the number of ice layers from the ice temperature data
+    const int layersDim = 1;
+    int nLayers = dataGroup.getVar(ticeName).getDim(layersDim).getSize();
+    mesh->allocate(nLayers);
+
+    // Read the prognostic fields in the original order into the mesh order
+    std::vector<double> original;
+    for (auto& field : FieldRegistry::fields()) {
+        if (field.group != FieldRegistry::Group::PROGNOSTIC)
+            continue;
+        FieldView<double> view = FieldRegistry::mutableView(data, field.name);
+        int nValues = (field.dimensions == FieldRegistry::Dimensions::LAYERED) ? nLayers : 1;
+        original.resize(nElements * nValues);
+        dataGroup.getVar(field.name).getVar(original.data());
+        mesh->fromOriginalOrder(
+            original.data(), nValues, view.data(), FieldView<double>::elementStride);
+    }
+    ncFile.close();
+}
+
+void UnstructuredMeshIO::dump(const ElementVector& data, const std::string& filePath) const
+{
+    DimNames dimNames = {
+        UnstructuredMesh::nodeDimName,
+        UnstructuredMesh::elementDimName,
+        UnstructuredMesh::vertexDimName,
+        UnstructuredMesh::nIceLayersName,
+    };
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
+    FieldDims fieldDims;
+    netCDF::NcGroup dataGroup = dumpMesh(ncFile, *mesh, dimNames, mesh->nIceLayers(), fieldDims);
+
+    std::vector<double> original;
+    for (auto& field : FieldRegistry::fields()) {
+        if (field.group != FieldRegistry::Group::PROGNOSTIC)
+            continue;
+        FieldView<const double> view = FieldRegistry::view(data, field.name);
+        dumpField(dataGroup, *mesh, fieldDims, field, view.data(),
+            FieldView<const double>::elementStride, view.nLayers(), original);
+    }
+    ncFile.close();
+}
+
+void UnstructuredMeshIO::dumpSnapshot(
+    const RestartSnapshot& snapshot, const std::string& filePath) const
+{
+    DimNames dimNames = {
+        UnstructuredMesh::nodeDimName,
+        UnstructuredMesh::elementDimName,
+        UnstructuredMesh::vertexDimName,
+        UnstructuredMesh::nIceLayersName,
+    };
+    netCDF::NcFile ncFile(filePath, netCDF::NcFile::replace);
+    FieldDims fieldDims;
+    netCDF::NcGroup dataGroup = dumpMesh(ncFile, *mesh, dimNames, mesh->nIceLayers(), fieldDims);
+
+    // The snapshot fields are held contiguously in the element order of the mesh
+    std::vector<double> original;
+    for (auto& field : snapshot.fields()) {
+        dumpField(dataGroup, *mesh, fieldDims, *field.description, field.values.data(),
+            field.nLayers, field.nLayers, original);
+    }
+    ncFile.close();
+}
+
+} /* namespace Nextsim */
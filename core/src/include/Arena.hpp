@@ -0,0 +1,251 @@
+/*!
+ * @file Arena.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_ARENA_HPP
+#define CORE_SRC_INCLUDE_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief An allocator of large chunks of memory, from which the model fields
+ * and scratch buffers are allocated in sequence.
+ *
+ * @details Allocating each element's data separately from the heap makes
+ * many small allocations, spread across memory. The arena instead divides
+ * large chunks, so that the data of the elements is contiguous, allocation
+ * is an increment of an offset, and teardown returns whole chunks to the
+ * system. The chunks may be backed by 2 MB huge pages, reducing the number
+ * of TLB entries needed to cover large grids.
+ *
+ * Each allocation belongs to a group, and each group has its own chunks, so
+ * that the memory used by each group can be reported. Deallocated memory is
+ * reused when it is the most recent allocation of its chunk, or when the
+ * whole chunk has been deallocated.
+ *
+ * Allocation and deallocation are thread safe. Temporary buffers used
+ * within a thread should be allocated from the arena of that thread, given
+ * by local(), so that the threads of a team do not contend for the main
+ * arena.
+ */
+class Arena {
+public:
+    //! How the chunks are backed by huge pages.
+    enum class HugePages {
+        NONE, //!< Normal pages only.
+        TRANSPARENT, //!< Chunks are aligned to and advised to use transparent huge pages.
+        EXPLICIT, //!< Chunks are mapped from the reserved huge pages of the system.
+    };
+
+    /*!
+     * @brief Destroys and deallocates an object allocated from an Arena, or
+     * deletes an object allocated by new if arena is null.
+     */
+    struct Deleter {
+        Arena* arena;
+        std::size_t size;
+        int group;
+
+        template <class T> void operator()(T* p) const
+        {
+            if (!arena) {
+                delete p;
+                return;
+            }
+            p->~T();
+            arena->deallocate(p, size, group);
+        }
+    };
+
+    Arena();
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /*!
+     * @brief Sets the huge page backing of chunks allocated after the call.
+     *
+     * @details If explicit huge pages are not available from the system, the
+     * chunk is allocated using transparent huge pages instead, and a warning
+     * is logged. Huge pages are only available on Linux.
+     */
+    void setHugePages(HugePages hugePages) { m_hugePages = hugePages; }
+    //! Returns the huge page backing of new chunks.
+    HugePages hugePages() const { return m_hugePages; }
+
+    /*!
+     * @brief Sets the minimum size of the chunks allocated after the call.
+     *
+     * @throws std::invalid_argument if the size is zero.
+     */
+    void setChunkSize(std::size_t chunkSize);
+    //! Returns the minimum size of a chunk.
+    std::size_t chunkSize() const { return m_chunkSize; }
+
+    /*!
+     * @brief Returns the index of the named group, creating it if needed.
+     *
+     * @param name The name of the group, as used in the reports.
+     */
+    int group(const std::string& name);
+
+    /*!
+     * @brief Allocates memory from a group.
+     *
+     * @param bytes The size of the memory in bytes.
+     * @param alignment The alignment of the memory, a power of two.
+     * @param group The index of the group.
+     * @throws std::bad_alloc if a new chunk cannot be allocated.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment, int group);
+    /*!
+     * @brief Returns memory to a group.
+     *
+     * @param p The memory, as returned by allocate().
+     * @param bytes The size of the memory in bytes, as passed to allocate().
+     * @param group The index of the group, as passed to allocate().
+     */
+    void deallocate(void* p, std::size_t bytes, int group);
+    /*!
+     * @brief Makes room in a group for allocations totalling a given size,
+     * without allocating.
+     *
+     * @details Starts a new chunk if the most recent chunk of the group
+     * cannot hold the allocations. The following allocations of the group with
+     * the given alignment are then made in sequence from the returned memory,
+     * unless other threads allocate from the group in between, so that the
+     * memory can be first touched before the allocations are made.
+     *
+     * @param bytes The total size of the allocations in bytes.
+     * @param alignment The alignment of the allocations, a power of two.
+     * @param group The index of the group.
+     * @return The memory of the next allocation from the group.
+     * @throws std::bad_alloc if a new chunk cannot be allocated.
+     */
+    void* reserve(std::size_t bytes, std::size_t alignment, int group);
+
+    //! Returns the bytes currently allocated from the named group.
+    std::size_t bytes(const std::string& group) const;
+    //! Returns the bytes currently allocated from each group, by the name of the group.
+    std::map<std::string, std::size_t> report() const;
+    //! Returns the total size of the chunks of all groups in bytes.
+    std::size_t reservedBytes() const;
+
+    //! The arena of the model fields and scratch buffers, shared by all the models of the process.
+    static Arena main;
+    /*!
+     * @brief Returns the arena of the calling thread.
+     *
+     * @details Memory allocated from the arena must be deallocated by the
+     * same thread. The chunks of the arena are returned to the system when
+     * the thread exits, and are not backed by huge pages.
+     */
+    static Arena& local();
+
+    //! The group of the element data.
+    static const int fields = 0;
+    //! The group of the per-element physics implementation instances.
+    static const int physics = 1;
+    //! The group of the temporary buffers of calculations.
+    static const int scratch = 2;
+
+    //! The default minimum chunk size, and the size of a huge page.
+    static const std::size_t hugePageSize = 2 * 1024 * 1024;
+
+private:
+    struct Chunk {
+        char* base;
+        std::size_t size;
+        std::size_t offset;
+        // Bytes allocated and not yet deallocated
+        std::size_t live;
+        // The mapping holding the chunk
+        void* mapping;
+        std::size_t mappedSize;
+    };
+    struct Group {
+        std::string name;
+        std::size_t bytes;
+        std::vector<Chunk> chunks;
+    };
+
+    static std::size_t alignedOffset(const Chunk& chunk, std::size_t alignment);
+    // Returns the most recent chunk of a group, or a new chunk if that
+    // cannot hold the given size
+    Chunk& chunkFor(Group& grp, std::size_t bytes, std::size_t alignment);
+    Chunk newChunk(std::size_t minimumSize);
+    static void freeChunk(const Chunk& chunk);
+
+    HugePages m_hugePages;
+    std::size_t m_chunkSize;
+    std::vector<Group> m_groups;
+    mutable std::mutex m_mutex;
+};
+
+/*!
+ * @brief An allocator for the standard containers, allocating from one group
+ * of an Arena.
+ *
+ * @details The default allocator allocates from the fields group of the main
+ * arena.
+ */
+template <class T> class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator()
+        : ArenaAllocator(Arena::main, Arena::fields)
+    {
+    }
+    ArenaAllocator(Arena& arena, int group)
+        : m_arena(&arena)
+        , m_group(group)
+    {
+    }
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : m_arena(other.arena())
+        , m_group(other.group())
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T), m_group));
+    }
+    void deallocate(T* p, std::size_t n) { m_arena->deallocate(p, n * sizeof(T), m_group); }
+
+    Arena* arena() const { return m_arena; }
+    int group() const { return m_group; }
+
+private:
+    Arena* m_arena;
+    int m_group;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+    return a.arena() == b.arena() && a.group() == b.group();
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b)
+{
+    return !(a == b);
+}
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_ARENA_HPP */
@@ -0,0 +1,92 @@
+/*!
+ * @file BitRounding.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_BITROUNDING_HPP
+#define CORE_SRC_INCLUDE_BITROUNDING_HPP
+
+#include "include/ThreadTeam.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace Nextsim {
+
+/*!
+ * @brief Rounds output values to a number of significant bits, per variable.
+ *
+ * @details Each value keeps the given number of the 52 explicit mantissa
+ * bits of a double, rounded to nearest with ties to even, and the remaining
+ * bits are set to zero. The trailing zero bits compress well, so that output
+ * written with deflate compression is several times smaller. The relative
+ * error of each value is at most 2^-(keepBits + 1). Keeping all 52 bits
+ * leaves the values unchanged, which is the default: only output such as
+ * diagnostics and statistics should be rounded, never restart files.
+ */
+class BitRounding {
+public:
+    //! The number of explicit mantissa bits of a double, which is lossless.
+    static const int allBits = 52;
+
+    /*!
+     * @brief Constructs a rounding with the same number of bits for every variable.
+     *
+     * @throws std::invalid_argument if the number of bits is not between 0 and 52.
+     */
+    BitRounding(int defaultBits = allBits);
+
+    /*!
+     * @brief Sets the number of bits kept for one variable.
+     *
+     * @throws std::invalid_argument if the number of bits is not between 0 and 52.
+     */
+    void setKeepBits(const std::string& variable, int bits);
+    //! Returns the number of bits kept for a variable.
+    int keepBits(const std::string& variable) const;
+    //! Returns whether every variable keeps all of its bits.
+    bool isLossless() const;
+
+    /*!
+     * @brief Rounds the values of a variable in place.
+     *
+     * @details The values are divided between the threads of a team, which
+     * should be that of the model whose output is rounded.
+     */
+    void round(const std::string& variable, double* values, std::size_t n,
+        ThreadTeam& team = ThreadTeam::main) const;
+
+    //! Returns a value rounded to keepBits mantissa bits. Infinities and NaNs are unchanged.
+    static double round(double value, int keepBits)
+    {
+        if (keepBits >= allBits)
+            return value;
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const std::uint64_t exponentMask = 0x7ffull << allBits;
+        if ((bits & exponentMask) == exponentMask)
+            return value;
+        const int shift = allBits - keepBits;
+        // Half of the last kept bit, less one unless the last kept bit is
+        // set, so that ties round to even
+        const std::uint64_t half = (std::uint64_t(1) << (shift - 1)) - 1 + ((bits >> shift) & 1);
+        bits = (bits + half) & ~((std::uint64_t(1) << shift) - 1);
+        std::memcpy(&value, &bits, sizeof(bits));
+        return value;
+    }
+
+private:
+    static int checkBits(int bits);
+
+    int m_defaultBits;
+    std::map<std::string, int> m_bits;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_BITROUNDING_HPP */
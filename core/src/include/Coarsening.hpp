@@ -0,0 +1,130 @@
+/*!
+ * @file Coarsening.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_COARSENING_HPP
+#define CORE_SRC_INCLUDE_COARSENING_HPP
+
+#include "include/BitRounding.hpp"
+#include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/LandMask.hpp"
+#include "include/ThreadTeam.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief Coarsened copies of the output fields of a rectangular grid.
+ *
+ * @details The grid is divided into blocks of factor × factor cells, and each
+ * block is reduced to a single value, either the mean of its cells or the
+ * value of its first cell. Blocks at the high x and y edges of the grid hold
+ * the cells remaining when the size of the grid is not a multiple of the
+ * factor. The coarsened fields are held in memory, so that they can be
+ * prepared from the model state and then written while the model continues.
+ *
+ * The output fields are the registered fields which are not external data,
+ * as written to restart files.
+ *
+ * On a grid with a land mask, the mean of a block is that of its ocean cells.
+ * Blocks without ocean, and subsampled blocks whose first cell is land, are
+ * given the fill value of LandMask.
+ */
+class Coarsening {
+public:
+    //! The reduction of each block to a single value.
+    enum class Method {
+        MEAN, //!< The mean of the cells of the block.
+        SUBSAMPLE, //!< The value of the first cell of the block.
+    };
+
+    //! A coarsened field, indexed by coarse x index, coarse y index, then layer.
+    struct Field {
+        //! The registered description, which remains valid as fields are added.
+        const FieldRegistry::Field* description;
+        int nLayers;
+        std::vector<double> values;
+    };
+
+    /*!
+     * @brief Constructs a coarsening by a factor.
+     *
+     * @param factor The number of cells along each side of a block.
+     * @param method The reduction of each block.
+     * @throws std::invalid_argument if the factor is less than one.
+     */
+    Coarsening(int factor = 1, Method method = Method::MEAN);
+
+    /*!
+     * @brief Returns the method named by a string, "mean" or "subsample".
+     *
+     * @throws std::invalid_argument if the method is unknown.
+     */
+    static Method methodFromString(const std::string& name);
+
+    //! Returns the number of cells along each side of a block.
+    int factor() const { return m_factor; }
+    //! Returns the reduction of each block.
+    Method method() const { return m_method; }
+    //! Returns the number of coarse cells along a dimension of n cells.
+    int coarseSize(int n) const { return (n + m_factor - 1) / m_factor; }
+
+    /*!
+     * @brief Coarsens the output fields of the rows of a grid held by this process.
+     *
+     * @details The elements are held with the x index varying slowest. The
+     * coarse rows are divided between the threads of a team, which should
+     * be that of the model context of the grid.
+     * Elements are held only for the ocean cells of a masked grid.
+     *
+     * @param data The elements of the rows of the grid held by this process.
+     * @param xStart The x index of the first row held.
+     * @param nxLocal The number of rows held.
+     * @param nx The number of rows of the whole grid.
+     * @param ny The number of cells of each row.
+     * @param mask The land mask of the rows held, or nullptr if every cell
+     * holds an element.
+     * @throws std::invalid_argument if the rows held do not divide into
+     * whole blocks, as the blocks would then be divided between processes,
+     * or if the mask is not that of the rows held.
+     */
+    void coarsen(const ElementVector& data, int xStart, int nxLocal, int nx, int ny,
+        const LandMask* mask = nullptr, ThreadTeam& team = ThreadTeam::main);
+
+    /*!
+     * @brief Rounds the coarsened fields for output, in place.
+     *
+     * @details Each field is rounded to the bits kept for it by the rounding.
+     */
+    void round(const BitRounding& rounding, ThreadTeam& team = ThreadTeam::main);
+
+    //! Returns the coarsened fields of the latest call to coarsen().
+    const std::vector<Field>& fields() const { return m_fields; }
+    //! Returns the coarse x index of the first coarse row held.
+    int xStart() const { return m_xStart; }
+    //! Returns the number of coarse rows held.
+    int nxLocal() const { return m_nxLocal; }
+    //! Returns the number of coarse rows of the whole grid.
+    int nx() const { return m_nx; }
+    //! Returns the number of coarse cells of each row.
+    int ny() const { return m_ny; }
+
+private:
+    int m_factor;
+    Method m_method;
+    std::vector<Field> m_fields;
+    int m_xStart;
+    int m_nxLocal;
+    int m_nx;
+    int m_ny;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_COARSENING_HPP */
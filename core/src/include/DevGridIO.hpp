@@ -17,6 +17,13 @@ namespace Nextsim {
 
 class DevGrid;
 
+/*!
+ * @brief The netCDF IO of DevGrid.
+ *
+ * @details When built with MPI (USE_MPI), each rank reads and writes only
+ * the rows of the grid it holds, by collective parallel netCDF-4/HDF5 IO of
+ * hyperslabs of a single file.
+ */
 class DevGridIO : public IDevGridIO {
 public:
     DevGridIO(DevGrid& grid)
@@ -25,11 +32,26 @@ public:
     }
     virtual ~DevGridIO() = default;
 
-    void init(std::vector<ElementData>& data, const std::string& filePath) const override;
-    void dump(const std::vector<ElementData>& data, const std::string& filePath) const override;
+    void init(ElementVector& data, const std::string& filePath) const override;
+    void dump(const ElementVector& data, const std::string& filePath) const override;
+    void dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const override;
+    void dumpStatistics(const Statistics& statistics, const std::string& filePath,
+        int deflateLevel) const override;
+    void coarsen(const ElementVector& data, Coarsening& coarsening) const override;
+    void dumpCoarsened(const Coarsening& coarsening, const std::string& filePath,
+        int deflateLevel) const override;
 
+#ifdef USE_MPI
 private:
-    DevGrid* grid;
+    // Collective reading and writing of the rows of the grid held by each rank
+    void initParallel(ElementVector& data, const std::string& filePath) const;
+    void dumpParallel(const ElementVector& data, const std::string& filePath) const;
+    void dumpSnapshotParallel(const RestartSnapshot& snapshot, const std::string& filePath) const;
+    void dumpStatisticsParallel(
+        const Statistics& statistics, const std::string& filePath, int deflateLevel) const;
+    void dumpCoarsenedParallel(
+        const Coarsening& coarsening, const std::string& filePath, int deflateLevel) const;
+#endif
 };
 
 } /* namespace Nextsim */
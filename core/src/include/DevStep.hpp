@@ -9,17 +9,25 @@
 #define CORE_SRC_INCLUDE_DEVSTEP_HPP
 
 #include "include/IModelStep.hpp"
+#include "include/IPhysics1d.hpp"
 #include "include/IStructure.hpp"
+#include "include/TaskGraph.hpp"
+#include "include/Tiling.hpp"
 
 #include <string>
+#include <vector>
 
 namespace Nextsim {
 
 class DevStep : public IModelStep {
 public:
-    DevStep() = default;
+    DevStep();
     virtual ~DevStep() = default;
 
+    // The stages hold a pointer to this instance
+    DevStep(const DevStep&) = delete;
+    DevStep& operator=(const DevStep&) = delete;
+
     // Member functions inherited from IModelStep
     void writeRestartFile(const std::string& filePath) override {};
 
@@ -27,12 +35,139 @@ public:
 
     // Member functions inherited from Iterant
     void init() override {};
-    void start(const Iterator::TimePoint& startTime) override {};
+    void start(const Iterator::TimePoint& startTime) override
+    {
+        m_startTime = startTime;
+        m_stepsDone = 0;
+    };
     void iterate(const Iterator::Duration& dt) override;
+    void iterateSteps(const Iterator::Duration& dt, int nSteps) override;
     void stop(const Iterator::TimePoint& stopTime) override {};
 
+    /*!
+     * @brief Adds one of the standard stages to the timestep.
+     *
+     * @details The stage is declared with the standard dependencies of the
+     * named stage: forcing → physics → diagnostics → output, and
+     * physics → checkpoint. The physics of a timestep waits for the forcing,
+     * diagnostics and checkpoint stages of the previous timestep, which read
+     * or write the model state. The output stage should write only data
+     * prepared by the diagnostics stage, so that it can overlap with the
+     * physics of the following timestep. The diagnostics of a timestep wait
+     * for the output of the previous timestep, so that the data prepared for
+     * the output is not changed while it is written. Messages logged by the
+     * stage are stamped with the model time of its timestep.
+     *
+     * @param name The name of the stage, one of the standard stage names.
+     * @param stage The function to execute for each timestep.
+     */
+    void addStage(const std::string& name, const TaskGraph::Stage& stage);
+
+    /*!
+     * @brief Returns the model time at the start of a timestep of the stages.
+     *
+     * @param step The step index passed to the stage.
+     */
+    Iterator::TimePoint stepTime(int step) const
+    {
+        return m_startTime + (m_stepsDone + step) * m_dt;
+    }
+    /*!
+     * @brief Returns the index of a timestep of the stages, counted from the
+     * start of the run.
+     *
+     * @param step The step index passed to the stage.
+     */
+    int stepIndex(int step) const { return m_stepsDone + step; }
+    //! Returns the length of the timesteps of the stages.
+    Iterator::Duration timestep() const { return m_dt; }
+
+    //! Returns the graph of the stages making up each timestep.
+    TaskGraph& stages() { return m_stages; }
+
+    /*!
+     * @brief Selects the single pass (fused) or the modular physics calculation.
+     *
+     * @details The modular calculation updates the derived data of every
+     * element, then calculates the physics of all the elements, then updates
+     * the prognostic data of every element, so that each element is read
+     * from memory three times per timestep. Each thread of the ThreadTeam of
+     * the model makes these passes over its own block of the elements, as
+     * divided by ThreadTeam::block(). The fused calculation runs as
+     * passes of tiling(): the physics of a tile, using
+     * IPhysics1d::calculateFused(), then the update of its prognostic data,
+     * while the tile is in cache.
+     *
+     * @param fused true for the fused calculation, false for the modular one.
+     */
+    void setFusedPhysics(bool fused) { m_fused = fused; }
+    //! Returns whether the single pass physics calculation is selected.
+    bool fusedPhysics() const { return m_fused; }
+
+    /*!
+     * @brief Returns the tiling of the fused calculation.
+     *
+     * @details The tiling initially holds the physics and prognostic update
+     * passes. Further passes added to it run on each tile after those. The
+     * default tile size fits the data used by the physics, about 500 bytes
+     * per element, in a 32 kB L1 data cache.
+     */
+    Tiling& tiling() { return m_tiling; }
+
+    //! Domain totals for monitoring the conservation of ice, snow and heat.
+    struct Budget {
+        double iceVolume; //!< Total ice volume [m³]
+        double snowVolume; //!< Total snow volume [m³]
+        double iceArea; //!< Total ice covered area [m²]
+        double oceanHeatFlux; //!< Net heat flux out of the ocean [W]
+    };
+
+    /*!
+     * @brief Calculates the budget totals of the current state, and logs them
+     * at the DEBUG level.
+     *
+     * @details The totals are calculated with a reproducible reduction, so
+     * that they are bitwise identical for any decomposition of the domain.
+     * The fields are read through their FieldRegistry views. The budget is
+     * not part of the timestep: the model calls this from its diagnostics
+     * stage, as often as configured.
+     *
+     * @throws std::runtime_error if the structure does not hold its elements
+     * contiguously.
+     */
+    void updateBudget();
+    //! Returns the budget totals as of the latest call to updateBudget().
+    const Budget& budget() const { return m_budget; }
+
+    // Names of the standard stages of a timestep
+    static const std::string forcingStage;
+    static const std::string physicsStage;
+    static const std::string diagnosticsStage;
+    static const std::string outputStage;
+    static const std::string checkpointStage;
+
 private:
     IStructure* pStructure;
+    TaskGraph m_stages;
+    Iterator::TimePoint m_startTime;
+    Iterator::Duration m_dt;
+    // Timesteps completed by earlier calls to iterateSteps()
+    int m_stepsDone;
+    // The elements and columns of the modular calculation by one thread
+    struct Block {
+        std::vector<ElementData*> elements;
+        std::vector<IPhysics1d::Column> columns;
+    };
+    // The modular calculation of the elements of one thread
+    void iterateModular(Block& block);
+
+    // The elements of the physics calculation, and their division between
+    // the threads, reused between timesteps
+    std::vector<ElementData*> m_elements;
+    std::vector<Block> m_blocks;
+    Tiling m_tiling;
+    bool m_fused;
+    Budget m_budget;
 };
 
 } /* namespace Nextsim */
@@ -22,14 +22,14 @@ public:
     static void setAll(IStructure& is)
     {
         for (is.cursor = 0; is.cursor; ++is.cursor) {
-            is.cursor->airTemperature() = -1;
-            is.cursor->dewPoint2m() = -4;
-            is.cursor->airPressure() = 1e5;
-            is.cursor->ExternalData::mixingRatio() = -1.;
-            is.cursor->incomingShortwave() = 0; // night
-            is.cursor->incomingLongwave() = 311;
-            is.cursor->mixedLayerDepth() = 10;
-            is.cursor->snowfall() = 0;
+            is.cursor->setAirTemperature(-1);
+            is.cursor->setDewPoint2m(-4);
+            is.cursor->setAirPressure(1e5);
+            is.cursor->setMixingRatio(-1.);
+            is.cursor->setIncomingShortwave(0); // night
+            is.cursor->setIncomingLongwave(311);
+            is.cursor->setMixedLayerDepth(10);
+            is.cursor->setSnowfall(0);
         }
     }
 
@@ -7,6 +7,7 @@
 #ifndef SRC_INCLUDE_ELEMENTDATA_HPP
 #define SRC_INCLUDE_ELEMENTDATA_HPP
 
+#include "Arena.hpp"
 #include "Configured.hpp"
 #include "ExternalData.hpp"
 #include "ModuleLoader.hpp"
@@ -14,6 +15,9 @@
 #include "include/IPhysics1d.hpp"
 #include "include/PhysicsData.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace Nextsim {
 
 //! A class to be used when a non-specific class derived from BaseElementData
@@ -35,6 +39,14 @@ class ElementData : public PrognosticData,
 public:
     ElementData();
     ElementData(int nIceLayers);
+    /*!
+     * @brief Constructs an element of a model.
+     *
+     * @param nIceLayers The number of ice layers.
+     * @param context The context of the model, from whose physics instance
+     * that of the element is constructed.
+     */
+    ElementData(int nIceLayers, ModelContext& context);
 
     //! Copy constructor
     ElementData(const ElementData& src);
@@ -55,7 +67,7 @@ public:
     ElementData& operator=(ElementData&& other);
 
     //! Configures the PrognosticData and physics implementation aspects of the
-    //!  object.
+    //!  context of the object.
     void configure() override;
 
     void updateDerivedData(
@@ -63,10 +75,36 @@ public:
 
     void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
 
+    //! The owning pointer to the physics implementation instance of an element.
+    typedef std::unique_ptr<IPhysics1d, Arena::Deleter> PhysicsPtr;
+
+    //! Returns the data and physics implementation of this element for a batch calculation.
+    IPhysics1d::Column physicsColumn() { return { this, this, this, m_physicsImplData.get() }; }
+
 private:
-    std::unique_ptr<IPhysics1d> m_physicsImplData;
+    PhysicsPtr m_physicsImplData;
 };
 
+//! The storage of the data of the elements of a structure, allocated from the fields group of the
+//! main Arena.
+typedef std::vector<ElementData, ArenaAllocator<ElementData>> ElementVector;
+
+/*!
+ * @brief Replaces the element data of a structure with new elements, first
+ * touching their memory, and that of their physics instances, from the
+ * threads that will compute on them.
+ *
+ * @details The memory is divided between the threads of the ThreadTeam of the
+ * context in the same blocks as the computation, so that on NUMA systems each
+ * block is placed on the node of its thread.
+ *
+ * @param data The element data to be replaced.
+ * @param nElements The number of elements.
+ * @param nLayers The number of ice layers of each element.
+ * @param context The model context of the elements.
+ */
+void allocateElements(ElementVector& data, int nElements, int nLayers, ModelContext& context);
+
 } /* namespace Nextsim */
 
 #endif /* SRC_INCLUDE_ELEMENTDATA_HPP */
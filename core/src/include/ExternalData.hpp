@@ -10,59 +10,125 @@
 #include "BaseElementData.hpp"
 #include "constants.hpp"
 
+#include <algorithm>
+
 namespace Nextsim {
 
-//! A class holding all of the data for an element that is imported from
-//! external sources (coupled models, climatologies).
+/*!
+ * @brief A class holding all of the data for an element that is imported from
+ * external sources (coupled models, climatologies).
+ *
+ * @details The data carries a version number which changes whenever a
+ * value is set, so that quantities derived only from the external data need
+ * be recalculated only when it has been changed. The values are read through
+ * the constant accessors, which leave the version unchanged.
+ */
 class ExternalData : public BaseElementData {
 public:
-    ExternalData() = default;
+    ExternalData()
+        : m_version(0)
+    {
+    }
     ~ExternalData() = default;
+    ExternalData(const ExternalData&) = default;
+
+    //! Copy assignment, which changes the version of the assigned-to data.
+    ExternalData& operator=(const ExternalData& other)
+    {
+        unsigned long newVersion = std::max(m_version, other.m_version) + 1;
+        m_tair = other.m_tair;
+        m_dair = other.m_dair;
+        m_slp = other.m_slp;
+        m_mixrat = other.m_mixrat;
+        m_Qsw_in = other.m_Qsw_in;
+        m_Qlw_in = other.m_Qlw_in;
+        m_mld = other.m_mld;
+        m_snowfall = other.m_snowfall;
+        m_version = newVersion;
+        return *this;
+    }
+
+    //! The version of the data, which changes whenever the data may have been changed.
+    inline unsigned long version() const { return m_version; }
+    //! Marks the data as changed, for writers that do not use the setters.
+    inline void markModified() { ++m_version; }
 
-    //! Reference to the air temperature at 2 m [˚C]
-    inline double& airTemperature() { return m_tair; };
     //! Air temperature at 2 m [˚C]
-    inline double airTemperature() const { return m_tair; }
+    inline const double& airTemperature() const { return m_tair; }
+    //! Sets the air temperature at 2 m [˚C].
+    inline void setAirTemperature(double value)
+    {
+        m_tair = value;
+        markModified();
+    }
 
-    //! Reference to the dew point temperature at 2 m [˚C]
-    inline double& dewPoint2m() { return m_dair; };
     //! Dew point temperature at 2 m [˚C]
-    inline double dewPoint2m() const { return m_dair; };
+    inline const double& dewPoint2m() const { return m_dair; }
+    //! Sets the dew point temperature at 2 m [˚C].
+    inline void setDewPoint2m(double value)
+    {
+        m_dair = value;
+        markModified();
+    }
 
-    //! Reference to the sea level atmospheric pressure [Pa]
-    inline double& airPressure() { return m_slp; };
     //! Sea level atmospheric pressure [Pa]
-    inline double airPressure() const { return m_slp; }
+    inline const double& airPressure() const { return m_slp; }
+    //! Sets the sea level atmospheric pressure [Pa].
+    inline void setAirPressure(double value)
+    {
+        m_slp = value;
+        markModified();
+    }
 
-    //! Reference to the water vapour mixing ratio [kg kg⁻¹]
-    inline double& mixingRatio() { return m_mixrat; };
     //! Water vapour mixing ratio [kg kg⁻¹]
-    inline double mixingRatio() const { return m_mixrat; }
+    inline const double& mixingRatio() const { return m_mixrat; }
+    //! Sets the water vapour mixing ratio [kg kg⁻¹].
+    inline void setMixingRatio(double value)
+    {
+        m_mixrat = value;
+        markModified();
+    }
 
     //! Does the element have a valid value of water vapour mixing ratio?
     inline bool hasMixingRatio() const { return (m_mixrat >= 0) && (m_mixrat <= 1); };
 
-    //! Reference to the incoming short wave radiation flux [W m⁻²]
-    inline double& incomingShortwave() { return m_Qsw_in; }
     //! Incoming short wave radiation flux [W m⁻²]
-    inline double incomingShortwave() const { return m_Qsw_in; }
+    inline const double& incomingShortwave() const { return m_Qsw_in; }
+    //! Sets the incoming short wave radiation flux [W m⁻²].
+    inline void setIncomingShortwave(double value)
+    {
+        m_Qsw_in = value;
+        markModified();
+    }
 
-    //! Reference to the incoming long wave radiation flux [W m⁻²]
-    inline double& incomingLongwave() { return m_Qlw_in; }
     //! Incoming long wave radiation flux [W m⁻²]
-    inline double incomingLongwave() const { return m_Qlw_in; }
+    inline const double& incomingLongwave() const { return m_Qlw_in; }
+    //! Sets the incoming long wave radiation flux [W m⁻²].
+    inline void setIncomingLongwave(double value)
+    {
+        m_Qlw_in = value;
+        markModified();
+    }
 
-    //! Reference to the depth of the ocean mixed layer [m]
-    inline double& mixedLayerDepth() { return m_mld; };
     //! Depth of the ocean mixed layer [m]
-    inline double mixedLayerDepth() const { return m_mld; }
+    inline const double& mixedLayerDepth() const { return m_mld; }
+    //! Sets the depth of the ocean mixed layer [m].
+    inline void setMixedLayerDepth(double value)
+    {
+        m_mld = value;
+        markModified();
+    }
     //! The areal mixed layer heat capacity [J K⁻¹ m⁻²]
     inline double mixedLayerBulkHeatCapacity() const { return m_mld * Water::rhoOcean * Water::cp; }
 
-    //! Reference to the snowfall rate [kg m⁻² s⁻¹]
-    inline double& snowfall() { return m_snowfall; }
     //! Snowfall rate [kg m⁻² s⁻¹]
-    inline double snowfall() const { return m_snowfall; }
+    inline const double& snowfall() const { return m_snowfall; }
+    //! Sets the snowfall rate [kg m⁻² s⁻¹].
+    inline void setSnowfall(double value)
+    {
+        m_snowfall = value;
+        markModified();
+    }
 
 private:
     double m_tair;
@@ -74,6 +140,8 @@ private:
     double m_mld;
 
     double m_snowfall;
+
+    unsigned long m_version;
 };
 
 } /* namespace Nextsim */
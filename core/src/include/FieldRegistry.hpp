@@ -0,0 +1,157 @@
+/*!
+ * @file FieldRegistry.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_FIELDREGISTRY_HPP
+#define CORE_SRC_INCLUDE_FIELDREGISTRY_HPP
+
+#include "ElementData.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A strided view of one field of an array of ElementData.
+ *
+ * @details The field of each element lies at the same offset within the
+ * element, so the values for consecutive elements are separated by a fixed
+ * number of doubles. Layered fields store their layers contiguously within
+ * each element. No data is copied: the view refers directly to the storage of
+ * the elements, and is invalidated by anything that reallocates that storage.
+ *
+ * @tparam T double or const double.
+ */
+template <typename T> class FieldView {
+public:
+    //! The separation of the values of consecutive elements, in doubles.
+    static const std::ptrdiff_t elementStride = sizeof(ElementData) / sizeof(double);
+    static_assert(sizeof(ElementData) % sizeof(double) == 0,
+        "ElementData must be a whole number of doubles in size");
+
+    FieldView(T* base, std::size_t size, int nLayers)
+        : m_base(base)
+        , m_size(size)
+        , m_nLayers(nLayers)
+    {
+    }
+
+    //! The value for element i (of layer 0, for layered fields).
+    T& operator[](std::size_t i) const { return m_base[i * elementStride]; }
+    //! The value of the given layer for element i.
+    T& operator()(std::size_t i, int layer) const { return m_base[i * elementStride + layer]; }
+
+    //! The address of the value of the first element.
+    T* data() const { return m_base; }
+    //! The number of elements in the view.
+    std::size_t size() const { return m_size; }
+    //! The number of layers of the field, 1 for fields without layers.
+    int nLayers() const { return m_nLayers; }
+
+private:
+    T* m_base;
+    std::size_t m_size;
+    int m_nLayers;
+};
+
+template <typename T> const std::ptrdiff_t FieldView<T>::elementStride;
+
+/*!
+ * @brief The central list of the named fields of the model data.
+ *
+ * @details Each field is described by its name, units, dimensions and an
+ * accessor which returns the address of its storage within an element. IO,
+ * forcing and diagnostic code can then read and write the fields in place
+ * through a FieldView, without gathering them into temporary arrays. New
+ * output variables need only be added here, or at run time with add().
+ *
+ * The registry is read without locking by every model of the process, so
+ * fields may only be added during start up. Configuring a model freezes the
+ * registry, after which add() throws.
+ */
+class FieldRegistry {
+public:
+    //! The part of the model data a field belongs to.
+    enum class Group {
+        PROGNOSTIC,
+        EXTERNAL,
+        DIAGNOSTIC,
+    };
+
+    //! The dimensions of a field.
+    enum class Dimensions {
+        HORIZONTAL, //!< One value per element.
+        LAYERED, //!< One value per ice layer per element.
+    };
+
+    //! Returns the address of the (first layer of the) field within an element.
+    typedef std::function<const double*(const ElementData&)> Accessor;
+
+    //! The description of a single field.
+    struct Field {
+        std::string name;
+        std::string units;
+        Dimensions dimensions;
+        Group group;
+        Accessor storage;
+    };
+
+    /*!
+     * @brief The list of fields.
+     *
+     * @details A deque, so that references to the registered fields, which
+     * are held by Coarsening and RestartSnapshot, remain valid when fields
+     * are added.
+     */
+    typedef std::deque<Field> FieldList;
+
+    //! All of the registered fields, in the order they were registered.
+    static const FieldList& fields();
+
+    /*!
+     * @brief Returns the description of the named field.
+     *
+     * @throws std::out_of_range if no field of that name is registered.
+     */
+    static const Field& field(const std::string& name);
+
+    /*!
+     * @brief Registers an additional field.
+     *
+     * @throws std::invalid_argument if a field of that name is already registered.
+     * @throws std::logic_error if the registry has been frozen.
+     */
+    static void add(const Field& field);
+    /*!
+     * @brief Prevents any further fields being added.
+     *
+     * @details Called by the configuration of each model, after which the
+     * registry can be read concurrently by several models.
+     */
+    static void freeze();
+
+    //! Returns a read-only view of the named field of the data.
+    static FieldView<const double> view(const ElementVector& data, const std::string& name);
+
+    /*!
+     * @brief Returns a writable view of the named field of the data.
+     *
+     * @details The elements of external fields are marked as modified, as the
+     * view allows them to be written without the use of the accessors.
+     */
+    static FieldView<double> mutableView(ElementVector& data, const std::string& name);
+
+private:
+    static FieldList& registry();
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_FIELDREGISTRY_HPP */
@@ -0,0 +1,136 @@
+/*!
+ * @file ForcingCache.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_FORCINGCACHE_HPP
+#define CORE_SRC_INCLUDE_FORCINGCACHE_HPP
+
+#include "include/IStructure.hpp"
+#include "include/SharedMemoryCoupler.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <sys/types.h>
+
+namespace Nextsim {
+
+/*!
+ * @brief A cache of decoded forcing records, shared between the model
+ * processes running on a node.
+ *
+ * @details Each record of a forcing source is decoded once, by the first
+ * process to request it, into a POSIX shared memory segment. The other
+ * processes requesting the record wait for the decoding to finish, then map
+ * the same memory read-only, so that an ensemble of model processes holds
+ * and reads one copy of the forcing rather than one copy per member.
+ *
+ * A record holds the ExternalData forcing fields in the layout of the
+ * forcing arrays of SharedMemoryCoupler. The segment of a record is removed
+ * when the last process using it releases it. A record left half decoded by
+ * a process which died is removed and decoded again by the next process to
+ * request it.
+ *
+ * When the source is a file, its size, modification time and inode are part
+ * of the segment names, so that a replaced or rewritten file is not served
+ * from the records of its previous contents.
+ */
+class ForcingCache {
+public:
+    /*!
+     * @brief Decodes a forcing record into the forcing arrays.
+     *
+     * @param index The index of the record in the forcing source.
+     * @param fields The SharedMemoryCoupler::N_FORCING arrays of nElements
+     * values, one after the other in the order of SharedMemoryCoupler::Forcing.
+     * @param nElements The number of values in each array.
+     */
+    typedef std::function<void(int index, double* fields, std::size_t nElements)> Decoder;
+
+    //! A decoded record, mapped read-only.
+    class Record {
+    public:
+        ~Record();
+        Record(const Record&) = delete;
+        Record& operator=(const Record&) = delete;
+
+        //! Returns the index of the record in the forcing source.
+        int index() const { return m_index; }
+        //! Returns whether this process decoded the record.
+        bool decodedHere() const { return m_decodedHere; }
+        //! Returns the values of a forcing field.
+        const double* field(SharedMemoryCoupler::Forcing field) const
+        {
+            return m_fields + field * m_nElements;
+        }
+        //! Copies the record into the ExternalData of the elements of a structure.
+        void apply(IStructure& structure) const
+        {
+            SharedMemoryCoupler::applyForcing(m_fields, m_nElements, structure);
+        }
+
+    private:
+        friend class ForcingCache;
+        Record(const std::string& name, int index, bool decodedHere, std::size_t nElements,
+            void* header, const double* fields, dev_t device, ino_t inode);
+
+        std::string m_name;
+        // Identify the segment, which the name may no longer refer to
+        dev_t m_device;
+        ino_t m_inode;
+        int m_index;
+        bool m_decodedHere;
+        std::size_t m_nElements;
+        void* m_header;
+        std::size_t m_headerSize;
+        const double* m_fields;
+        std::size_t m_fieldsSize;
+    };
+
+    /*!
+     * @brief Constructs a cache of the records of a forcing source.
+     *
+     * @param source A name identifying the forcing source, such as its file
+     * path, which is the same in all the processes sharing the records.
+     * @param nElements The number of elements of each record.
+     * @param decoder The function decoding a record.
+     * @param timeout The maximum wait for another process to decode a record [s].
+     * @throws std::invalid_argument if nElements is zero.
+     */
+    ForcingCache(const std::string& source, std::size_t nElements, const Decoder& decoder,
+        double timeout = 300.);
+
+    /*!
+     * @brief Returns a record, decoding it if no other process has.
+     *
+     * @details The record remains mapped while the returned pointer, or any
+     * copy of it, exists.
+     *
+     * @param index The index of the record in the forcing source.
+     * @throws std::runtime_error if the shared memory cannot be created or
+     * mapped, the record held by another process has a different number of
+     * elements, or the decoding by another process fails or times out.
+     * Exceptions thrown by the decoder are passed on.
+     */
+    std::shared_ptr<const Record> record(int index);
+
+    //! Returns the name of the shared memory segment of a record.
+    std::string segmentName(int index) const;
+
+private:
+    std::string m_source;
+    // The version of a source file, empty if the source is not a file
+    std::string m_version;
+    std::size_t m_nElements;
+    Decoder m_decoder;
+    double m_timeout;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_FORCINGCACHE_HPP */
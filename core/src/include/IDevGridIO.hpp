@@ -12,7 +12,10 @@
 
 namespace Nextsim {
 
+class Coarsening;
 class DevGrid;
+class RestartSnapshot;
+class Statistics;
 /*!
  * @brief A class that deals with all the netCDF related parts of DevGrid.
  *
@@ -32,17 +35,56 @@ public:
     /*!
      * @brief Reads data from the file location into the vector of data elements.
      *
+     * @details The land mask of the grid is replaced by that of the file, and
+     * elements are created only for its ocean cells.
+     *
      * @param dg The vector of ElementData instances to be filled.
      * @param filePath The location of the NetCDF restart file to be read.
      */
-    virtual void init(std::vector<ElementData>& dg, const std::string& filePath) const = 0;
+    virtual void init(ElementVector& dg, const std::string& filePath) const = 0;
     /*!
      * @brief Writes data from the vector of data elements into the file location.
      *
      * @param dg The vector of ElementData instances containing the data.
      * @param filePath The location of the NetCDF restart file to be written.
      */
-    virtual void dump(const std::vector<ElementData>& dg, const std::string& fielPath) const = 0;
+    virtual void dump(const ElementVector& dg, const std::string& fielPath) const = 0;
+    /*!
+     * @brief Writes a snapshot of the data elements into the file location.
+     *
+     * @param snapshot The snapshot of the restart fields of the data elements.
+     * @param filePath The location of the NetCDF restart file to be written.
+     */
+    virtual void dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const
+        = 0;
+    /*!
+     * @brief Writes the statistics of the last completed window into the file location.
+     *
+     * @param statistics The statistics of the element data.
+     * @param filePath The location of the NetCDF statistics file to be written.
+     * @param deflateLevel The deflate compression level of the variables, 0 for none.
+     */
+    virtual void dumpStatistics(
+        const Statistics& statistics, const std::string& filePath, int deflateLevel) const = 0;
+    /*!
+     * @brief Coarsens the output fields of the vector of data elements.
+     *
+     * @details The coarsening is only needed for output, so it is done by
+     * the IO, keeping its dependencies out of DevGrid.
+     *
+     * @param dg The vector of ElementData instances containing the data.
+     * @param coarsening The coarsening to hold the coarsened fields.
+     */
+    virtual void coarsen(const ElementVector& dg, Coarsening& coarsening) const = 0;
+    /*!
+     * @brief Writes coarsened fields into the file location.
+     *
+     * @param coarsening The coarsened fields.
+     * @param filePath The location of the NetCDF file to be written.
+     * @param deflateLevel The deflate compression level of the variables, 0 for none.
+     */
+    virtual void dumpCoarsened(
+        const Coarsening& coarsening, const std::string& filePath, int deflateLevel) const = 0;
 
 protected:
     DevGrid* grid;
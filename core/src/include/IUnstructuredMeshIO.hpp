@@ -0,0 +1,69 @@
+/*!
+ * @file IUnstructuredMeshIO.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_IUNSTRUCTUREDMESHIO_HPP
+#define CORE_SRC_INCLUDE_IUNSTRUCTUREDMESHIO_HPP
+
+#include "include/ElementData.hpp"
+
+#include <string>
+
+namespace Nextsim {
+
+class RestartSnapshot;
+class UnstructuredMesh;
+
+/*!
+ * @brief A class that deals with all the netCDF related parts of
+ * UnstructuredMesh.
+ *
+ * @details As for IDevGridIO, the interface keeps the NetCDF libraries out of
+ * the module. See UnstructuredMeshIO for the implementing class.
+ */
+class IUnstructuredMeshIO {
+public:
+    IUnstructuredMeshIO(UnstructuredMesh& mesh)
+        : mesh(&mesh)
+    {
+    }
+    virtual ~IUnstructuredMeshIO() = default;
+    /*!
+     * @brief Reads the mesh and the data of its elements from the file location.
+     *
+     * @details The mesh is replaced by that of the file, and the elements are
+     * created in the order of the mesh rather than that of the file.
+     *
+     * @param data The vector of ElementData instances to be filled.
+     * @param filePath The location of the NetCDF restart file to be read.
+     */
+    virtual void init(ElementVector& data, const std::string& filePath) const = 0;
+    /*!
+     * @brief Writes the mesh and the data of its elements into the file
+     * location, in the order of the nodes and elements of the file from which
+     * the mesh was read.
+     *
+     * @param data The vector of ElementData instances containing the data.
+     * @param filePath The location of the NetCDF restart file to be written.
+     */
+    virtual void dump(const ElementVector& data, const std::string& filePath) const = 0;
+    /*!
+     * @brief Writes the mesh and a snapshot of the data of its elements into
+     * the file location, in the format written by dump().
+     *
+     * @param snapshot The snapshot of the restart fields of the data elements.
+     * @param filePath The location of the NetCDF restart file to be written.
+     */
+    virtual void dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const
+        = 0;
+
+protected:
+    UnstructuredMesh* mesh;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_IUNSTRUCTUREDMESHIO_HPP */
@@ -67,11 +67,32 @@ public:
     //! Run the Iterant over the specified time period.
     void run();
 
+    /*!
+     * @brief Starts a run which is then advanced by step(), for callers
+     * which act on the model between timesteps.
+     */
+    void start();
+    /*!
+     * @brief Advances a run started by start() by a number of timesteps,
+     * stopping early at the stop time.
+     *
+     * @param nSteps The number of timesteps to advance.
+     * @returns The number of timesteps performed.
+     */
+    int step(int nSteps);
+    //! Stops a run started by start().
+    void stop();
+    //! Returns the time reached by the run.
+    TimePoint currentTime() const { return m_currentTime; }
+    //! Returns whether the run has reached the stop time.
+    bool finished() const { return m_currentTime >= stopTime; }
+
 private:
     Iterant* iterant; // FIXME smart pointer
     TimePoint startTime;
     TimePoint stopTime;
     Duration timestep;
+    TimePoint m_currentTime;
 
 public:
     //! A base class for classes that specify what happens during one timestep.
@@ -101,6 +122,23 @@ public:
          * @param dt The length of the timestep.
          */
         virtual void iterate(const Duration& dt) = 0;
+        /*!
+         * @brief Performs a number of consecutive iterations of a specified
+         * length.
+         *
+         * @details The default implementation calls iterate() once per
+         * timestep. Implementing classes can override this to overlap the
+         * work of consecutive timesteps.
+         *
+         * @param dt The length of each timestep.
+         * @param nSteps The number of timesteps to perform.
+         */
+        virtual void iterateSteps(const Duration& dt, int nSteps)
+        {
+            for (int i = 0; i < nSteps; ++i) {
+                iterate(dt);
+            }
+        }
         /*!
          * Finalizes the iterant based on the stop time.
          *
@@ -0,0 +1,170 @@
+/*!
+ * @file LandMask.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_LANDMASK_HPP
+#define CORE_SRC_INCLUDE_LANDMASK_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief The ocean cells of the rows of a rectangular grid held by a process.
+ *
+ * @details Only the ocean cells of the grid hold elements. The elements are
+ * stored contiguously in the order of their cells, with the x index varying
+ * slowest, so that no memory or computation is spent on land. The mask maps
+ * between the element indices and the cell indices of the rows, so that
+ * fields can be gathered from and scattered to the full rows for IO.
+ */
+class LandMask {
+public:
+    /*!
+     * @brief Constructs the mask of rows in which every cell is ocean.
+     *
+     * @param nxLocal The number of rows.
+     * @param ny The number of cells of each row.
+     */
+    LandMask(int nxLocal = 0, int ny = 0)
+        : m_nxLocal(nxLocal)
+        , m_ny(ny)
+    {
+        const std::size_t nCells = std::size_t(nxLocal) * ny;
+        m_cell.reserve(nCells);
+        m_element.reserve(nCells);
+        for (std::size_t cell = 0; cell < nCells; ++cell) {
+            m_cell.push_back(cell);
+            m_element.push_back(cell);
+        }
+    }
+
+    /*!
+     * @brief Constructs the mask of rows from the mask values of their cells.
+     *
+     * @param nxLocal The number of rows.
+     * @param ny The number of cells of each row.
+     * @param ocean The mask value of each cell, indexed by x then y, non-zero
+     * for ocean and zero for land.
+     * @throws std::invalid_argument if the number of values is not the number
+     * of cells.
+     */
+    LandMask(int nxLocal, int ny, const std::vector<int>& ocean)
+        : m_nxLocal(nxLocal)
+        , m_ny(ny)
+    {
+        if (ocean.size() != std::size_t(nxLocal) * ny) {
+            throw std::invalid_argument("LandMask: " + std::to_string(ocean.size())
+                + " mask values for " + std::to_string(nxLocal) + " rows of "
+                + std::to_string(ny) + " cells");
+        }
+        m_element.reserve(ocean.size());
+        for (std::size_t cell = 0; cell < ocean.size(); ++cell) {
+            if (ocean[cell]) {
+                m_element.push_back(m_cell.size());
+                m_cell.push_back(cell);
+            } else {
+                m_element.push_back(landElement());
+            }
+        }
+    }
+
+    //! Returns the value of land cells in fields scattered to the full rows.
+    static double fillValue()
+    {
+        // A power of two, so that it is unchanged by bit rounding
+        return std::ldexp(1., 123);
+    }
+
+    //! Returns the number of rows.
+    int nxLocal() const { return m_nxLocal; }
+    //! Returns the number of cells of each row.
+    int ny() const { return m_ny; }
+    //! Returns the number of cells of the rows.
+    std::size_t nCells() const { return m_element.size(); }
+    //! Returns the number of ocean cells, which is the number of elements.
+    std::size_t nOcean() const { return m_cell.size(); }
+    //! Returns whether every cell is ocean, so that elements and cells coincide.
+    bool allOcean() const { return m_cell.size() == m_element.size(); }
+
+    //! Returns whether a cell is ocean.
+    bool isOcean(std::size_t cell) const { return m_element[cell] != landElement(); }
+    //! Returns the cell of an element.
+    std::size_t cell(std::size_t element) const { return m_cell[element]; }
+    //! Returns the element of an ocean cell.
+    std::size_t element(std::size_t cell) const { return m_element[cell]; }
+
+    //! Returns the mask value of each cell, 1 for ocean and 0 for land.
+    std::vector<int> values() const
+    {
+        std::vector<int> ocean(nCells(), 0);
+        for (std::size_t cell : m_cell) {
+            ocean[cell] = 1;
+        }
+        return ocean;
+    }
+
+    /*!
+     * @brief Copies values from the elements to every cell of the rows.
+     *
+     * @param elements The values of the elements, nValues for each element,
+     * with consecutive elements separated by stride.
+     * @param stride The separation of the values of consecutive elements.
+     * @param nValues The number of values of each element and cell.
+     * @param cells The values of the cells, indexed by cell then value.
+     * @param fill The value given to land cells.
+     */
+    template <typename T>
+    void scatter(const T* elements, std::ptrdiff_t stride, int nValues, T* cells, T fill) const
+    {
+        for (std::size_t cell = 0; cell < nCells(); ++cell) {
+            const std::size_t element = m_element[cell];
+            for (int value = 0; value < nValues; ++value) {
+                cells[cell * nValues + value]
+                    = (element == landElement()) ? fill : elements[element * stride + value];
+            }
+        }
+    }
+
+    /*!
+     * @brief Copies the values of the ocean cells of the rows to their elements.
+     *
+     * @param cells The values of the cells, indexed by cell then value.
+     * @param nValues The number of values of each element and cell.
+     * @param elements The values of the elements, nValues for each element,
+     * with consecutive elements separated by stride.
+     * @param stride The separation of the values of consecutive elements.
+     */
+    template <typename T>
+    void gather(const T* cells, int nValues, T* elements, std::ptrdiff_t stride) const
+    {
+        for (std::size_t element = 0; element < nOcean(); ++element) {
+            const std::size_t cell = m_cell[element];
+            for (int value = 0; value < nValues; ++value) {
+                elements[element * stride + value] = cells[cell * nValues + value];
+            }
+        }
+    }
+
+private:
+    // The element index of land cells
+    static std::size_t landElement() { return std::size_t(-1); }
+
+    int m_nxLocal;
+    int m_ny;
+    // The cell of each element
+    std::vector<std::size_t> m_cell;
+    // The element of each cell, or landElement()
+    std::vector<std::size_t> m_element;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_LANDMASK_HPP */
@@ -7,21 +7,84 @@
 #ifndef SRC_INCLUDE_LOGGED_HPP
 #define SRC_INCLUDE_LOGGED_HPP
 
+#include <atomic>
 #include <string>
 
 namespace Nextsim {
 
+/*!
+ * @brief A base class for classes that write log messages.
+ *
+ * @details Messages are stamped with the wall time and the model time of the
+ * calling thread, and placed in a lock-free ring buffer belonging to that
+ * thread. The model time is held per thread, as each stage of a timestep
+ * runs on its own thread and concurrent models have times of their own. A
+ * background thread drains the buffers of all threads and writes the messages
+ * to the log file, or to standard error if no file has been set. Logging from
+ * several threads therefore never contends on a lock, and a message below the
+ * minimum level costs a single atomic load. If a buffer is full, the message
+ * is dropped and the number of dropped messages is reported by the flusher.
+ */
 class Logged {
 public:
-    enum level { INFO, DEBUG, NOTICE, WARNING, ERROR, CRITICAL, ALERT, EMERGENCY };
+    // Levels in increasing order of severity
+    enum level { DEBUG, INFO, NOTICE, WARNING, ERROR, CRITICAL, ALERT, EMERGENCY };
     static void log(const std::string& message, const level lvl);
-    static void info(const std::string& message);
-    // TODO: functions for all the levels in between
-    static void emergency(const std::string& message);
+    static void debug(const std::string& message) { log(message, DEBUG); }
+    static void info(const std::string& message) { log(message, INFO); }
+    static void notice(const std::string& message) { log(message, NOTICE); }
+    static void warning(const std::string& message) { log(message, WARNING); }
+    static void error(const std::string& message) { log(message, ERROR); }
+    static void critical(const std::string& message) { log(message, CRITICAL); }
+    static void alert(const std::string& message) { log(message, ALERT); }
+    static void emergency(const std::string& message) { log(message, EMERGENCY); }
+
+    //! Returns whether messages of the given level are currently logged.
+    static bool isEnabled(const level lvl)
+    {
+        return lvl >= minimumLevel.load(std::memory_order_relaxed);
+    }
+    //! Sets the least severe level of message that is logged.
+    static void setMinimumLevel(const level lvl);
+    /*!
+     * @brief Parses the name of a level, ignoring case.
+     *
+     * @param name The name of the level, such as "info" or "WARNING".
+     * @throws std::invalid_argument if the name is not one of the levels.
+     */
+    static level levelFromString(const std::string& name);
+    //! Returns the upper case name of a level.
+    static std::string levelName(const level lvl);
+
+    /*!
+     * @brief Sets the file the messages are written to.
+     *
+     * @details Messages already logged are flushed to the previous output.
+     * An empty path writes the messages to standard error.
+     *
+     * @param filePath The path of the log file, which is appended to.
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    static void setOutputFile(const std::string& filePath);
+    //! Sets the model time with which subsequent messages of the calling thread are stamped.
+    static void setModelTime(int modelTime) { currentModelTime = modelTime; }
+    //! Returns the model time with which messages of the calling thread are stamped.
+    static int modelTime() { return currentModelTime; }
+    /*!
+     * @brief Writes all messages logged so far to the output.
+     *
+     * @details Only the messages logged by the calling thread are guaranteed
+     * to have been logged "so far". Messages of level ERROR or above are
+     * flushed immediately after they are logged.
+     */
+    static void flush();
 
 protected:
     Logged() = default;
-    // TODO: Add implementation to actually do some logging
+
+private:
+    static std::atomic<int> minimumLevel;
+    static thread_local int currentModelTime;
 };
 
 } /* namespace Nextsim */
@@ -9,12 +9,22 @@
 
 #include "include/Logged.hpp"
 
+#include "include/BitRounding.hpp"
+#include "include/Coarsening.hpp"
 #include "include/Configured.hpp"
 #include "include/IStructure.hpp"
+#include "include/ModelContext.hpp"
 #include "include/Iterator.hpp"
+#include "include/RestartSnapshot.hpp"
+#include "include/SharedMemoryCoupler.hpp"
+#include "include/Statistics.hpp"
 
 #include "DevStep.hpp"
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace Nextsim {
 
@@ -23,7 +33,7 @@ class Model : public Logged, public Configured<Model> {
 public:
     Model(); // TODO add arguments to pass the desired
              // environment and configuration to the model
-    ~Model(); // Finalize the model. Collect data and so on.
+    ~Model(); // Finalizes the model, if not already finalized, and waits for the restart file.
 
     void configure() override;
     enum {
@@ -32,24 +42,128 @@ public:
         STOPTIME_KEY,
         RUNLENGTH_KEY,
         TIMESTEP_KEY,
+        STAGETHREADS_KEY,
+        STAGELEAD_KEY,
+        LOGLEVEL_KEY,
+        LOGFILE_KEY,
+        REPRODUCIBLE_KEY,
+        PHYSICSKERNEL_KEY,
+        TILESIZE_KEY,
+        THREADS_KEY,
+        PINTHREADS_KEY,
+        HUGEPAGES_KEY,
+        COUPLING_KEY,
+        STATISTICSFIELDS_KEY,
+        STATISTICSWINDOW_KEY,
+        STATISTICSFILE_KEY,
+        OUTPUTFILE_KEY,
+        OUTPUTPERIOD_KEY,
+        COARSENING_KEY,
+        COARSENINGMETHOD_KEY,
+        KEEPBITS_KEY,
+        DEFLATE_KEY,
+        BUDGETPERIOD_KEY,
     };
 
     //! Run the model
     void run();
 
+    //! Starts a run which is advanced by step(), for acting on the model between timesteps.
+    void start() { iterator.start(); }
+    /*!
+     * @brief Advances a run started by start().
+     *
+     * @param nSteps The number of timesteps to advance.
+     * @returns The number of timesteps performed, fewer than nSteps if the
+     * stop time is reached.
+     */
+    int step(int nSteps = 1) { return iterator.step(nSteps); }
+    //! Stops a run started by start().
+    void stop() { iterator.stop(); }
+    //! Returns the model time reached by the run.
+    Iterator::TimePoint time() const { return iterator.currentTime(); }
+    //! Returns whether the run has reached the stop time.
+    bool finished() const { return iterator.finished(); }
+
+    //! Returns the data structure of the model, once configured.
+    IStructure* structure() { return dataStructure.get(); }
+
     void writeRestartFile();
 
+    //! The outcome of writing the restart file started by finalize().
+    struct RestartStatus {
+        bool success; //!< Whether the file was written.
+        std::string filePath; //!< The path of the file.
+        std::uint64_t checksum; //!< The checksum of the data written.
+        std::string error; //!< The reason the file was not written.
+    };
+
+    /*!
+     * @brief Finalizes the model, starting the writing of the restart file.
+     *
+     * @details The restart fields are copied into a compact snapshot, which
+     * is written in the background, so that shutting down and any following
+     * work overlap with the writing. The run must have finished or been
+     * stopped. In MPI builds the collective IO must be performed by the main
+     * thread, so the writing is deferred to drainRestart().
+     */
+    void finalize();
+    /*!
+     * @brief Waits for the restart file started by finalize(), finalizing
+     * the model first if it has not been finalized.
+     *
+     * @details The outcome is logged as well as returned. The snapshot is
+     * released once written.
+     */
+    RestartStatus drainRestart();
+
     //! Sets the filename of the restart file that would currently be written out.
     void setFinalFilename(const std::string& finalFile);
 
 private:
+    // Configures the logging and huge pages, which apply to
+    // the whole process and so must agree between its configured models
+    void configureProcess();
+    // Configures the rounding and compression of the diagnostic output
+    void configureCompression();
+    // Configures the running statistics, adding their update to the
+    // diagnostics and their writing to the outputs
+    void configureStatistics(
+        std::vector<TaskGraph::Stage>& diagnostics, std::vector<TaskGraph::Stage>& outputs);
+    // Configures the periodic, optionally coarsened, output of the fields
+    void configureOutput(
+        std::vector<TaskGraph::Stage>& diagnostics, std::vector<TaskGraph::Stage>& outputs);
+
     Iterator iterator;
     DevStep modelStep; // Change the model step calculation here
 
     std::string initialFileName;
     std::string finalFileName;
 
+    // The timestep and configured modules of the elements of this model. Declared
+    // before the structure, so that it outlives the elements which refer to it.
+    ModelContext context;
     std::shared_ptr<IStructure> dataStructure;
+    // The restart fields at finalization, and their writing in the background
+    RestartSnapshot restartSnapshot;
+    std::future<RestartStatus> restartWrite;
+    bool finalized;
+    // Whether this model is counted among the models sharing the process settings
+    bool holdsProcessSettings;
+    // Exchanges the forcing and fluxes with a coupled model, if configured
+    std::unique_ptr<SharedMemoryCoupler> coupler;
+    // Running statistics of the model fields, written at the end of each window
+    Statistics statistics;
+    std::string statisticsFilePrefix;
+    // Periodic output of the fields, coarsened in the diagnostics stage
+    Coarsening coarsening;
+    std::string outputFilePrefix;
+    Iterator::Duration outputPeriod;
+    bool outputReady;
+    Iterator::TimePoint outputTime;
+    // Lossy rounding and lossless compression of the diagnostic output
+    BitRounding outputRounding;
+    int deflateLevel;
 };
 
 } /* namespace Nextsim */
@@ -0,0 +1,109 @@
+/*!
+ * @file ModelContext.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_MODELCONTEXT_HPP
+#define CORE_SRC_INCLUDE_MODELCONTEXT_HPP
+
+#include "include/IFreezingPoint.hpp"
+#include "include/ThreadTeam.hpp"
+
+#include <memory>
+
+namespace Nextsim {
+
+class IPhysics1d;
+
+/*!
+ * @brief The state shared by the elements of one model.
+ *
+ * @details Each element refers to the context of its model for the current
+ * timestep, the reproducibility setting, the freezing point implementation
+ * and the physics instance from which the physics instances of the elements
+ * are constructed, which in turn share the configured parameters and modules
+ * of the physics. Each context
+ * also has its own team of threads computing on the elements. As no element
+ * state is held in static variables, models with separate contexts can be
+ * configured one after another and then run concurrently on different
+ * threads.
+ *
+ * Elements constructed without a context share the default context, which
+ * is configured by configuring any of them, and whose team is
+ * ThreadTeam::main.
+ */
+class ModelContext {
+public:
+    ModelContext()
+        : m_dt(0)
+        , m_reproducible(false)
+        , m_team(new ThreadTeam)
+    {
+    }
+
+    // The elements of a model hold a pointer to its context
+    ModelContext(const ModelContext&) = delete;
+    ModelContext& operator=(const ModelContext&) = delete;
+
+    //! Returns the current timestep [s].
+    double timestep() const { return m_dt; }
+    //! Sets the timestep of all the elements of the context [s].
+    void setTimestep(double dt) { m_dt = dt; }
+
+    //! Returns whether the physics of the elements is calculated bitwise reproducibly.
+    bool reproducible() const { return m_reproducible; }
+    /*!
+     * @brief Sets whether the physics of the elements is calculated bitwise
+     * reproducibly (see Reproducibility). Should be set before the model runs.
+     */
+    void setReproducible(bool reproducible) { m_reproducible = reproducible; }
+
+    //! Returns the freezing point implementation, once configured.
+    const IFreezingPoint& freezingPoint() const { return *m_freezer; }
+    //! Sets the configured freezing point implementation.
+    void setFreezingPoint(std::unique_ptr<IFreezingPoint> freezer)
+    {
+        m_freezer = std::move(freezer);
+    }
+
+    /*!
+     * @brief Returns the physics instance from which the physics instances of
+     * the elements are constructed, or nullptr if none has been set.
+     */
+    IPhysics1d* physics() const { return m_physics.get(); }
+    //! Sets the physics instance from which those of the elements are constructed.
+    void setPhysics(std::shared_ptr<IPhysics1d> physics) { m_physics = std::move(physics); }
+
+    //! Returns the team of threads computing on the elements of the context.
+    ThreadTeam& threadTeam() const { return m_team ? *m_team : ThreadTeam::main; }
+
+    //! Returns the context of elements constructed without one.
+    static ModelContext& defaultContext()
+    {
+        static ModelContext context(MainTeam {});
+        return context;
+    }
+
+private:
+    struct MainTeam { };
+    // The default context, which uses the main team
+    ModelContext(MainTeam)
+        : m_dt(0)
+        , m_reproducible(false)
+    {
+    }
+
+    double m_dt;
+    bool m_reproducible;
+    std::unique_ptr<IFreezingPoint> m_freezer;
+    // Shared, as the class is complete only where the instance is created
+    std::shared_ptr<IPhysics1d> m_physics;
+    // Null in the default context
+    std::unique_ptr<ThreadTeam> m_team;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_MODELCONTEXT_HPP */
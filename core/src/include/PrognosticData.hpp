@@ -11,22 +11,51 @@
 #include "Configured.hpp"
 #include "include/IFreezingPoint.hpp"
 #include "include/IPrognosticUpdater.hpp"
+#include "include/ModelContext.hpp"
 #include "include/PrognosticGenerator.hpp"
 
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <vector>
 
 namespace Nextsim {
 
-//! A class holding all of the data for an element that is carried from one
-//! timestep to another.
+/*!
+ * @brief A class holding all of the data for an element that is carried from
+ * one timestep to another.
+ *
+ * @details The values are stored directly in the instance, including the ice
+ * layer temperatures, so that each field of an array of elements has a fixed
+ * stride in memory and can be read or written in place (see FieldRegistry).
+ * The timestep and the freezing point implementation are those of the
+ * ModelContext of the element.
+ */
 class PrognosticData : public BaseElementData, public Configured<PrognosticData> {
 public:
+    //! The maximum number of ice temperature layers.
+    static const int maxIceLayers = 8;
+
     //! Constructs an instance with a default of 1 ice layer.
     PrognosticData();
-    //! Constructs an instance with a number of ice layers.
-    PrognosticData(int nIceLayers);
-    PrognosticData(const PrognosticGenerator&);
+    /*!
+     * @brief Constructs an instance with a number of ice layers.
+     *
+     * @param nIceLayers The number of ice layers.
+     * @param context The context of the model of the element.
+     * @throws std::length_error if there are more than maxIceLayers layers.
+     */
+    PrognosticData(int nIceLayers, ModelContext& context = ModelContext::defaultContext());
+    /*!
+     * @brief Constructs an instance from the values of a generator.
+     *
+     * @param up The generator of the values, including the ice layers.
+     * @param context The context of the model of the element. Elements of a
+     * model must be given its context, as the default context is not
+     * configured by the model.
+     */
+    PrognosticData(
+        const PrognosticGenerator& up, ModelContext& context = ModelContext::defaultContext());
     ~PrognosticData() = default;
 
     /*!
@@ -48,55 +77,105 @@ public:
      */
     PrognosticData& setSeaSurface(double sst, double sss);
 
+    //! Configures the freezing point implementation of the context of the element.
     void configure() override;
 
     //! Effective Ice thickness [m]
-    inline double iceThickness() const { return m_thick; }
+    inline const double& iceThickness() const { return m_thick; }
     //! True ice thickness [m]. Zero concentration means no ice thickness
     inline double iceTrueThickness() const { return (m_conc != 0) ? m_thick / m_conc : 0; }
 
     //! Ice concentration [1]
-    inline double iceConcentration() const { return m_conc; }
+    inline const double& iceConcentration() const { return m_conc; }
 
     //! Sea surface temperature [˚C]
-    inline double seaSurfaceTemperature() const { return m_sst; }
+    inline const double& seaSurfaceTemperature() const { return m_sst; }
 
     //! Sea surface salinity [psu]
-    inline double seaSurfaceSalinity() const { return m_sss; }
+    inline const double& seaSurfaceSalinity() const { return m_sss; }
 
     //! Ice temperatures [˚C]
-    inline const std::vector<double>& iceTemperatures() const { return m_tice; }
-    template <int I> double iceTemperature() const { return m_tice[I]; }
-    double iceTemperature(int i) const { return m_tice[i]; };
+    inline std::vector<double> iceTemperatures() const
+    {
+        return std::vector<double>(m_tice.begin(), m_tice.begin() + m_nLayers);
+    }
+    template <int I> const double& iceTemperature() const { return m_tice[I]; }
+    const double& iceTemperature(int i) const { return m_tice[i]; };
 
     //! Mean snow thickness [m]
-    inline double snowThickness() const { return m_snow; }
+    inline const double& snowThickness() const { return m_snow; }
     //! Mean snow thickness over ice [m]
     inline double snowTrueThickness() const { return (m_conc != 0) ? m_snow / m_conc : 0; }
 
-    //! Salinity dependent freezing point [˚C]
-    inline double freezingPoint() const { return (*m_freezer)(m_sss); }
+    /*!
+     * @brief Salinity dependent freezing point [˚C]
+     *
+     * @details The value cached by updateFreezingPoints() is returned, so
+     * that the freezing point is calculated once per element per timestep.
+     * The cached value is discarded at the end of the timestep by
+     * updateAndIntegrate(), and when the salinity is set through this class,
+     * and is otherwise calculated on each call. Salinities written directly
+     * to the field in memory between timesteps, such as through
+     * FieldRegistry::mutableView(), are therefore used immediately.
+     */
+    inline double freezingPoint() const
+    {
+        return std::isnan(m_tf) ? m_context->freezingPoint()(m_sss) : m_tf;
+    }
+
+    /*!
+     * @brief Calculates and caches the freezing points of a block of
+     * elements, with a single call to the freezing point implementation.
+     *
+     * The working arrays are reused by each thread, so that calculating a
+     * block allocates nothing once a block of its size has been calculated.
+     *
+     * @param data The elements, of PrognosticData or a derived class, all
+     * of the same context.
+     */
+    template <typename T> static void updateFreezingPoints(const std::vector<T*>& data)
+    {
+        if (data.empty())
+            return;
+        const std::size_t n = data.size();
+        thread_local std::vector<double> sss;
+        thread_local std::vector<double> tf;
+        sss.resize(n);
+        tf.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            sss[i] = data[i]->seaSurfaceSalinity();
+        }
+        const PrognosticData& first = *data.front();
+        first.m_context->freezingPoint().blockFreezingPoint(sss.data(), tf.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            static_cast<PrognosticData*>(data[i])->m_tf = tf[i];
+        }
+    }
 
     //! Timestep [s]
-    inline double timestep() const { return m_dt; }
-    //! Set a new value for the timestep
-    static void setTimestep(double newDt) { m_dt = newDt; }
+    inline double timestep() const { return m_context->timestep(); }
+    //! Set a new value for the timestep of all the elements of the context
+    void setTimestep(double newDt) { m_context->setTimestep(newDt); }
+
+    //! Returns the context of the model of the element.
+    ModelContext& context() const { return *m_context; }
 
     //! Returns the number of ice layers in this element.
-    int nIceLayers() const { return m_tice.size(); };
+    int nIceLayers() const { return m_nLayers; };
 
 private:
     double m_thick; //!< Effective Ice thickness [m]
     double m_conc; //!< Ice concentration [1]
     double m_sst; //!< Sea surface temperature [˚C]
     double m_sss; //!< Sea surface salinity [psu]
-    std::vector<double> m_tice; //!< Ice temperature [˚C]
+    double m_tf; //!< Cached freezing point [˚C], NaN if not calculated
+    std::array<double, maxIceLayers> m_tice; //!< Ice temperature [˚C]
+    int m_nLayers; //!< Number of valid ice temperature layers
     double m_snow; //!< Mean snow thickness [m]
+    ModelContext* m_context; //!< Timestep and freezing point, shared by the elements of a model
 
-    static double m_dt; //!< Current timestep, shared by all elements
-    static IFreezingPoint* m_freezer;
-
-    static void copyInIceLayerData(const std::vector<double>& src, std::vector<double>& tgt);
+    void setIceLayerData(const std::vector<double>& src);
+    void copyInIceLayerData(const std::vector<double>& src);
 };
 
 } /* namespace Nextsim */
@@ -0,0 +1,115 @@
+/*!
+ * @file Reduction.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_REDUCTION_HPP
+#define CORE_SRC_INCLUDE_REDUCTION_HPP
+
+#include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/IStructure.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A sum of doubles which is independent of the order of summation.
+ *
+ * @details Each value is converted to a fixed-point number held in several
+ * 64 bit integer limbs. Integer addition is associative, so the sum, and the
+ * double returned by value(), are bitwise identical however the values are
+ * divided between threads or MPI ranks and in whatever order they are added.
+ * Values are represented to an absolute precision of 2⁻¹³⁸, and the
+ * magnitude of each value and of the sum must be less than 2¹³⁸ (about
+ * 3.5×10⁴¹).
+ */
+class ReproducibleSum {
+public:
+    ReproducibleSum();
+
+    /*!
+     * @brief Adds a value to the sum.
+     *
+     * @throws std::domain_error if the value is not finite.
+     * @throws std::overflow_error if the value is too large to be represented.
+     */
+    ReproducibleSum& operator+=(double x);
+    //! Adds a partial sum to this sum.
+    ReproducibleSum& operator+=(const ReproducibleSum& other);
+
+    //! The sum as a double.
+    double value() const;
+
+#ifdef USE_MPI
+    //! Sums the partial sums of all MPI ranks. Must be called on all ranks.
+    void allReduce();
+    //! Sums several partial sums of all MPI ranks in a single reduction.
+    static void allReduce(std::vector<ReproducibleSum>& sums);
+#endif
+
+    //! The number of limbs of the fixed point representation.
+    static const int nLimbs = 6;
+    //! The number of bits held by each limb, leaving headroom for carries.
+    static const int limbBits = 46;
+
+private:
+    // Returns all but the most significant limb to the range [0, 2^limbBits)
+    void carry();
+
+    std::array<std::int64_t, nLimbs> m_limbs;
+    // The number of values added since the last carry
+    int m_pending;
+};
+
+/*!
+ * @brief Global reductions of the element data of a structure.
+ *
+ * @details Sums and means are calculated with ReproducibleSum, so that the
+ * results do not depend on the decomposition of the structure between MPI
+ * ranks. The reductions must be called on all ranks.
+ */
+class Reduction {
+public:
+    //! A quantity calculated from the data of one element.
+    typedef std::function<double(const ElementData&)> Quantity;
+
+    //! The sum over all elements.
+    static double sum(IStructure& structure, const Quantity& quantity);
+    //! The integral over the area of the structure, the sum of the quantity times the element area.
+    static double areaIntegral(IStructure& structure, const Quantity& quantity);
+    /*!
+     * @brief The integrals over the area of the structure of several
+     * quantities, calculated in a single pass and a single reduction.
+     */
+    static std::vector<double> areaIntegrals(
+        IStructure& structure, const std::vector<Quantity>& quantities);
+    /*!
+     * @brief The integrals over the area of the structure of several fields,
+     * calculated in a single pass and a single reduction.
+     *
+     * @details The values are read directly from the views, so no function
+     * is called per element per field.
+     *
+     * @param structure The structure, whose element storage the views are of.
+     * @param fields Views of the fields of the element storage of the structure.
+     */
+    static std::vector<double> fieldAreaIntegrals(
+        IStructure& structure, const std::vector<FieldView<const double>>& fields);
+    //! The area weighted mean over all elements.
+    static double areaWeightedMean(IStructure& structure, const Quantity& quantity);
+    //! The minimum over all elements. Infinity if there are no elements.
+    static double minimum(IStructure& structure, const Quantity& quantity);
+    //! The maximum over all elements. Negative infinity if there are no elements.
+    static double maximum(IStructure& structure, const Quantity& quantity);
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_REDUCTION_HPP */
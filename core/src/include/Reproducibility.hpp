@@ -0,0 +1,144 @@
+/*!
+ * @file Reproducibility.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_REPRODUCIBILITY_HPP
+#define CORE_SRC_INCLUDE_REPRODUCIBILITY_HPP
+
+#include <cmath>
+#include <limits>
+
+namespace Nextsim {
+
+/*!
+ * @brief The switch for bitwise reproducible execution, and the math
+ * functions whose results depend on it.
+ *
+ * @details The physics of each element is calculated independently and the
+ * global reductions are order independent (see ReproducibleSum), so the
+ * results do not depend on the number of threads or ranks. What can still
+ * differ between machines running the same executable are the results of
+ * the transcendental functions of the C library, which selects different
+ * implementations (with and without FMA instructions, for example) by the
+ * features of the processor. When reproducibility is enabled, the functions
+ * here use portable implementations built only from basic IEEE arithmetic,
+ * which give the same result on every processor. When it is disabled they
+ * are the standard library functions.
+ *
+ * Reproducibility is a setting of each model, held in its ModelContext. The
+ * physics kernels read it once per call and enable it for the calling thread
+ * with a Scope, so that the functions here need not look up the model, and
+ * models with different settings can run concurrently.
+ *
+ * Differences between executables are avoided by building with the
+ * ENABLE_REPRODUCIBLE CMake option, which prevents the compiler from
+ * contracting multiplications and additions into FMA instructions.
+ */
+class Reproducibility {
+public:
+    //! Returns whether bitwise reproducible execution is enabled on the calling thread.
+    static bool isEnabled() { return enabledFlag(); }
+
+    /*!
+     * @brief Enables or disables bitwise reproducible execution on the
+     * calling thread for the lifetime of the instance.
+     *
+     * @details The previous setting of the thread is restored when the
+     * instance is destroyed, so scopes may be nested.
+     */
+    class Scope {
+    public:
+        Scope(bool enabled)
+            : m_previous(enabledFlag())
+        {
+            enabledFlag() = enabled;
+        }
+        ~Scope() { enabledFlag() = m_previous; }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool m_previous;
+    };
+
+    //! Returns whether the executable was built for reproducible floating point arithmetic.
+    static bool isReproducibleBuild()
+    {
+#ifdef REPRODUCIBLE_BUILD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    //! eˣ, using the portable implementation when reproducibility is enabled.
+    static double exp(double x) { return isEnabled() ? portableExp(x) : std::exp(x); }
+
+    //! xⁿ for integer n ≥ 0, by repeated multiplication when reproducibility is enabled.
+    static double pow(double x, int n) { return isEnabled() ? portablePow(x, n) : std::pow(x, n); }
+
+    /*!
+     * @brief eˣ calculated with basic arithmetic operations only.
+     *
+     * @details The argument is reduced to x = k ln 2 + r, with |r| ≤ ½ ln 2,
+     * and eʳ calculated by its Taylor series, which is accurate to within
+     * about 1 ulp.
+     */
+    static double portableExp(double x)
+    {
+        // Beyond these limits the result overflows or underflows
+        if (x > 709.782712893384)
+            return std::numeric_limits<double>::infinity();
+        if (x < -745.1332191019412)
+            return 0;
+        if (x != x)
+            return x;
+
+        // ln 2 split so that k * ln2Hi is exact (from fdlibm)
+        const double ln2Hi = 6.93147180369123816490e-01;
+        const double ln2Lo = 1.90821492927058770002e-10;
+        const double log2e = 1.44269504088896338700e+00;
+        double k = std::floor(x * log2e + 0.5);
+        double r = (x - k * ln2Hi) - k * ln2Lo;
+
+        // Taylor series to the r¹³ term, evaluated by Horner's scheme
+        const int nTerms = 14;
+        static const double inverseFactorial[nTerms] = { 1., 1., 1. / 2, 1. / 6, 1. / 24,
+            1. / 120, 1. / 720, 1. / 5040, 1. / 40320, 1. / 362880, 1. / 3628800, 1. / 39916800,
+            1. / 479001600, 1. / 6227020800. };
+        double er = inverseFactorial[nTerms - 1];
+        for (int i = nTerms - 2; i >= 0; --i) {
+            er = er * r + inverseFactorial[i];
+        }
+        return std::ldexp(er, static_cast<int>(k));
+    }
+
+    //! xⁿ for integer n ≥ 0, calculated by binary exponentiation.
+    static double portablePow(double x, int n)
+    {
+        double result = 1;
+        double square = x;
+        while (n > 0) {
+            if (n & 1)
+                result *= square;
+            square *= square;
+            n >>= 1;
+        }
+        return result;
+    }
+
+private:
+    static bool& enabledFlag()
+    {
+        thread_local bool enabled = false;
+        return enabled;
+    }
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_REPRODUCIBILITY_HPP */
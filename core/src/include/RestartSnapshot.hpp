@@ -0,0 +1,89 @@
+/*!
+ * @file RestartSnapshot.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_RESTARTSNAPSHOT_HPP
+#define CORE_SRC_INCLUDE_RESTARTSNAPSHOT_HPP
+
+#include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A compact copy of the restart fields of the element data.
+ *
+ * @details The restart fields are the registered prognostic fields, which
+ * are those read back by the initialization of the model. Each is copied
+ * into its own contiguous array, indexed by element then layer, so that
+ * the copy holds none of the padding or working storage of the elements.
+ * Once taken, the snapshot is independent of the model state, and can be
+ * written while the model is shut down or reused.
+ *
+ * A checksum of the values is calculated as the snapshot is taken, so that
+ * the data written can be checked against the state of the model.
+ */
+class RestartSnapshot {
+public:
+    //! A restart field, indexed by element then layer.
+    struct Field {
+        //! The registered description, which remains valid as fields are added.
+        const FieldRegistry::Field* description;
+        int nLayers;
+        std::vector<double> values;
+    };
+
+    RestartSnapshot();
+
+    /*!
+     * @brief Copies the restart fields of the element data.
+     *
+     * @param data The element data.
+     */
+    void take(const ElementVector& data);
+    /*!
+     * @brief Copies the restart fields back into the element data.
+     *
+     * @throws std::invalid_argument if the number of elements or layers of
+     * the data differs from that of the snapshot.
+     */
+    void restore(ElementVector& data) const;
+    //! Discards the copied fields, releasing their memory.
+    void clear();
+
+    //! Returns whether no snapshot is held.
+    bool empty() const { return m_fields.empty(); }
+    //! Returns the number of elements of the snapshot.
+    std::size_t size() const { return m_size; }
+    //! Returns the number of bytes of field data held.
+    std::size_t bytes() const;
+    //! Returns the restart fields of the latest call to take().
+    const std::vector<Field>& fields() const { return m_fields; }
+    //! Returns the checksum of the fields of the latest call to take().
+    std::uint64_t checksum() const { return m_checksum; }
+
+    /*!
+     * @brief Returns the 64 bit FNV-1a checksum of an array of values,
+     * continuing from the checksum of the preceding data.
+     */
+    static std::uint64_t checksum(
+        const double* values, std::size_t n, std::uint64_t seed = initialChecksum);
+    //! The checksum of no data.
+    static const std::uint64_t initialChecksum = 0xcbf29ce484222325ULL;
+
+private:
+    std::vector<Field> m_fields;
+    std::size_t m_size;
+    std::uint64_t m_checksum;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_RESTARTSNAPSHOT_HPP */
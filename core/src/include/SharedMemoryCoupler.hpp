@@ -0,0 +1,158 @@
+/*!
+ * @file SharedMemoryCoupler.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_SHAREDMEMORYCOUPLER_HPP
+#define CORE_SRC_INCLUDE_SHAREDMEMORYCOUPLER_HPP
+
+#include "include/IStructure.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace Nextsim {
+
+/*!
+ * @brief Exchanges the forcing and the ice-ocean fluxes with a coupled model
+ * running in another process, through a POSIX shared memory segment.
+ *
+ * @details The segment holds one array per exchanged field, in the order of
+ * the elements of the data structure, and two process-shared semaphores.
+ * Each timestep the partner writes the forcing arrays and signals that the
+ * forcing is ready. The model waits for the forcing, copies it into the
+ * ExternalData of the elements, calculates the timestep, then writes the flux
+ * arrays and signals that the fluxes are ready. No data passes through files.
+ *
+ * The model side creates the segment, and removes its name when destroyed.
+ * The partner side attaches to an existing segment, waiting for the model
+ * side to create it.
+ */
+class SharedMemoryCoupler {
+public:
+    //! The side of the exchange that a coupler is on.
+    enum class Side {
+        MODEL, //!< The sea ice model, which receives the forcing and sends the fluxes.
+        PARTNER, //!< The coupled model, which sends the forcing and receives the fluxes.
+    };
+
+    //! The forcing fields sent to the sea ice model, as held in ExternalData.
+    enum Forcing {
+        AIR_TEMPERATURE, //!< Air temperature at 2 m [˚C]
+        DEW_POINT, //!< Dew point at 2 m [˚C]
+        AIR_PRESSURE, //!< Sea level pressure [Pa]
+        MIXING_RATIO, //!< Water vapour mixing ratio [kg kg⁻¹]
+        SHORTWAVE, //!< Incoming short wave radiation [W m⁻²]
+        LONGWAVE, //!< Incoming long wave radiation [W m⁻²]
+        MIXED_LAYER_DEPTH, //!< Ocean mixed layer depth [m]
+        SNOWFALL, //!< Snowfall rate [kg m⁻² s⁻¹]
+        N_FORCING,
+    };
+
+    //! The fluxes sent from the sea ice model, as held in PhysicsData.
+    enum Flux {
+        ICE_OCEAN_HEAT, //!< Ice-ocean heat flux, over the ice fraction [W m⁻²]
+        EVAPORATION, //!< Open water evaporation rate [kg m⁻² s⁻¹]
+        NEW_ICE, //!< New ice thickness over the timestep [m]
+        N_FLUX,
+    };
+
+    /*!
+     * @brief Creates or attaches to the shared memory segment.
+     *
+     * @param name The name of the segment, beginning with '/'.
+     * @param side The side of the exchange. The model side creates the
+     * segment, replacing any left by an earlier run.
+     * @param nElements The number of elements exchanged. Only used by the
+     * model side, the partner side takes it from the segment.
+     * @param timeout The maximum wait for the other side in seconds.
+     * @throws std::runtime_error if the segment cannot be created, or the
+     * partner side times out waiting for it.
+     */
+    SharedMemoryCoupler(
+        const std::string& name, Side side, std::size_t nElements = 0, double timeout = 60.);
+    ~SharedMemoryCoupler();
+
+    SharedMemoryCoupler(const SharedMemoryCoupler&) = delete;
+    SharedMemoryCoupler& operator=(const SharedMemoryCoupler&) = delete;
+
+    //! Returns the number of elements exchanged.
+    std::size_t nElements() const;
+    //! Returns the side of the exchange of this coupler.
+    Side side() const { return m_side; }
+
+    //! Returns the array of a forcing field in the segment.
+    double* forcing(Forcing field);
+    //! Returns the array of a flux field in the segment.
+    double* flux(Flux field);
+
+    //! Signals the model side that the forcing arrays are complete.
+    void sendForcing();
+    /*!
+     * @brief Waits until the partner side has completed the forcing arrays.
+     *
+     * @throws std::runtime_error if the wait times out.
+     */
+    void receiveForcing();
+    //! Signals the partner side that the flux arrays are complete.
+    void sendFluxes();
+    /*!
+     * @brief Waits until the model side has completed the flux arrays.
+     *
+     * @throws std::runtime_error if the wait times out.
+     */
+    void receiveFluxes();
+
+    /*!
+     * @brief Waits for the forcing and copies it into the ExternalData of
+     * the elements of the structure.
+     *
+     * @throws std::runtime_error if the wait times out or the number of
+     * elements differs from the segment.
+     */
+    void receiveForcing(IStructure& structure);
+    /*!
+     * @brief Copies the fluxes from the PhysicsData of the elements of the
+     * structure and signals the partner.
+     *
+     * @throws std::runtime_error if the number of elements differs from the
+     * segment.
+     */
+    void sendFluxes(IStructure& structure);
+
+    /*!
+     * @brief Copies forcing arrays into the ExternalData of the elements of a
+     * structure.
+     *
+     * @param fields The N_FORCING arrays of nElements values, one after the
+     * other in the order of Forcing, as held in the segment.
+     * @param nElements The number of values in each array.
+     * @param structure The structure to receive the forcing.
+     * @throws std::runtime_error if the structure does not have nElements elements.
+     * @throws std::invalid_argument if the structure does not provide
+     * elementStorage(). The elements are accessed by index rather than with
+     * the cursor of the structure, which may be in use by another stage.
+     */
+    static void applyForcing(const double* fields, std::size_t nElements, IStructure& structure);
+
+private:
+    struct Header;
+
+    void create(std::size_t nElements);
+    void attach();
+    void wait(void* semaphore, const std::string& what);
+
+    std::string m_name;
+    Side m_side;
+    double m_timeout;
+    void* m_mapping;
+    std::size_t m_size;
+    Header* m_header;
+    double* m_fields;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_SHAREDMEMORYCOUPLER_HPP */
@@ -0,0 +1,77 @@
+/*!
+ * @file SlabPartner.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_SLABPARTNER_HPP
+#define CORE_SRC_INCLUDE_SLABPARTNER_HPP
+
+#include "include/SharedMemoryCoupler.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A stand-in for the coupled models: a slab atmosphere and a slab
+ * ocean mixed layer for each element, exchanging data with the sea ice model
+ * through a SharedMemoryCoupler.
+ *
+ * @details The atmosphere temperature relaxes towards a reference value, and
+ * is warmed by the latent heat of the water evaporated from the open water.
+ * The incoming long wave radiation is that of a black body at the atmosphere
+ * temperature, and the dew point is a fixed depression below it. The ocean
+ * mixed layer has a fixed depth and loses the ice-ocean heat flux. The
+ * initial state gives forcing close to that of DummyExternalData.
+ */
+class SlabPartner {
+public:
+    /*!
+     * @brief Attaches to the segment created by the sea ice model.
+     *
+     * @param name The name of the shared memory segment.
+     * @param timestep The timestep of the coupled models [s].
+     * @param timeout The maximum wait for the sea ice model [s].
+     */
+    SlabPartner(const std::string& name, double timestep, double timeout = 60.);
+
+    //! Writes the forcing from the current state and signals the sea ice model.
+    void sendForcing();
+    //! Waits for the fluxes of the sea ice model and updates the state.
+    void receiveFluxes();
+    //! Exchanges data with the sea ice model for a number of timesteps.
+    void run(int nSteps);
+
+    //! Atmosphere temperature of an element [˚C]
+    double airTemperature(std::size_t i) const { return m_tair[i]; }
+    //! Ocean mixed layer temperature of an element [˚C]
+    double oceanTemperature(std::size_t i) const { return m_tml[i]; }
+    //! Total of the evaporation received from an element [kg m⁻²]
+    double evaporated(std::size_t i) const { return m_evaporated[i]; }
+    //! Total of the new ice thickness received from an element [m]
+    double newIce(std::size_t i) const { return m_newIce[i]; }
+
+    //! Reference temperature of the atmosphere [˚C]
+    static const double referenceAirTemperature;
+    //! Relaxation timescale of the atmosphere temperature [s]
+    static const double relaxationTime;
+    //! Areal heat capacity of the slab atmosphere [J K⁻¹ m⁻²]
+    static const double airHeatCapacity;
+    //! Depth of the slab ocean mixed layer [m]
+    static const double mixedLayerDepth;
+
+private:
+    SharedMemoryCoupler m_coupler;
+    double m_dt;
+    std::vector<double> m_tair;
+    std::vector<double> m_tml;
+    std::vector<double> m_evaporated;
+    std::vector<double> m_newIce;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_SLABPARTNER_HPP */
@@ -0,0 +1,174 @@
+/*!
+ * @file SpaceFillingCurve.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_SPACEFILLINGCURVE_HPP
+#define CORE_SRC_INCLUDE_SPACEFILLINGCURVE_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief Orderings of points in the plane along space-filling curves.
+ *
+ * @details Points which are close along a space-filling curve are close in
+ * the plane, so elements stored in the order of the curve through their
+ * centroids have their neighbours nearby in memory. The Hilbert curve keeps
+ * better locality than the Morton (Z-order) curve, which jumps between the
+ * quadrants of each level, but the Morton index is cheaper to calculate.
+ *
+ * The points are quantized to a square lattice of 2^order × 2^order cells
+ * covering their bounding box, and ordered by the index of their cells along
+ * the curve.
+ */
+class SpaceFillingCurve {
+public:
+    enum class Curve {
+        NONE, //!< The original order of the points.
+        MORTON, //!< The Morton or Z-order curve.
+        HILBERT, //!< The Hilbert curve.
+    };
+
+    //! The number of bits of each lattice coordinate.
+    static int order() { return 16; }
+
+    /*!
+     * @brief Returns the curve of a name, ignoring case.
+     *
+     * @param name One of "none", "morton" or "hilbert".
+     * @throws std::invalid_argument if the name is not that of a curve.
+     */
+    static Curve curve(const std::string& name)
+    {
+        std::string lower(name);
+        std::transform(lower.begin(), lower.end(), lower.begin(),
+            [](unsigned char c) { return std::tolower(c); });
+        if (lower == "none")
+            return Curve::NONE;
+        if (lower == "morton")
+            return Curve::MORTON;
+        if (lower == "hilbert")
+            return Curve::HILBERT;
+        throw std::invalid_argument("SpaceFillingCurve: unknown curve " + name);
+    }
+
+    /*!
+     * @brief Returns the index along the Morton curve of a lattice cell, by
+     * interleaving the bits of its coordinates.
+     *
+     * @param x The x coordinate of the cell, less than 2^order().
+     * @param y The y coordinate of the cell, less than 2^order().
+     */
+    static std::uint64_t mortonIndex(std::uint32_t x, std::uint32_t y)
+    {
+        return spread(x) | (spread(y) << 1);
+    }
+
+    /*!
+     * @brief Returns the index along the Hilbert curve of a lattice cell.
+     *
+     * @details The curve starts at the cell (0, 0) and ends at the cell
+     * (2^order() - 1, 0), and consecutive cells along it share a side.
+     *
+     * @param x The x coordinate of the cell, less than 2^order().
+     * @param y The y coordinate of the cell, less than 2^order().
+     */
+    static std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y)
+    {
+        const std::uint32_t n = std::uint32_t(1) << order();
+        std::uint64_t index = 0;
+        for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+            std::uint32_t rx = (x & s) ? 1 : 0;
+            std::uint32_t ry = (y & s) ? 1 : 0;
+            index += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+            // Rotate the quadrant, so that the curve within it has the
+            // orientation of the curve at the next level
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = n - 1 - x;
+                    y = n - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return index;
+    }
+
+    /*!
+     * @brief Returns the order of points along a curve.
+     *
+     * @details Points in the same lattice cell keep their original order, so
+     * the ordering is deterministic.
+     *
+     * @param x The x coordinates of the points.
+     * @param y The y coordinates of the points.
+     * @param curve The curve along which to order the points.
+     * @return The index of each point in the order of the curve, such that
+     * the ith point along the curve is point [i] of the original order.
+     */
+    static std::vector<std::size_t> sortOrder(
+        const std::vector<double>& x, const std::vector<double>& y, Curve curve)
+    {
+        if (x.size() != y.size()) {
+            throw std::invalid_argument("SpaceFillingCurve: " + std::to_string(x.size())
+                + " x coordinates and " + std::to_string(y.size()) + " y coordinates");
+        }
+        std::vector<std::size_t> sorted(x.size());
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            sorted[i] = i;
+        }
+        if (curve == Curve::NONE || x.empty())
+            return sorted;
+
+        const auto xRange = std::minmax_element(x.begin(), x.end());
+        const auto yRange = std::minmax_element(y.begin(), y.end());
+        std::vector<std::uint64_t> index(x.size());
+        for (std::size_t i = 0; i < index.size(); ++i) {
+            std::uint32_t xCell = latticeCoordinate(x[i], *xRange.first, *xRange.second);
+            std::uint32_t yCell = latticeCoordinate(y[i], *yRange.first, *yRange.second);
+            index[i] = (curve == Curve::HILBERT) ? hilbertIndex(xCell, yCell)
+                                                 : mortonIndex(xCell, yCell);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [&index](std::size_t a, std::size_t b) { return index[a] < index[b]; });
+        return sorted;
+    }
+
+private:
+    // Spreads the bits of a lattice coordinate to the even bits of the result
+    static std::uint64_t spread(std::uint32_t coordinate)
+    {
+        std::uint64_t bits = coordinate;
+        bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFULL;
+        bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFULL;
+        bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        bits = (bits | (bits << 2)) & 0x3333333333333333ULL;
+        bits = (bits | (bits << 1)) & 0x5555555555555555ULL;
+        return bits;
+    }
+
+    // The lattice cell of a coordinate within the range [min, max]
+    static std::uint32_t latticeCoordinate(double value, double min, double max)
+    {
+        const std::uint32_t last = (std::uint32_t(1) << order()) - 1;
+        if (!(max > min))
+            return 0;
+        double scaled = (value - min) / (max - min) * last;
+        return std::min(last, std::uint32_t(scaled + 0.5));
+    }
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_SPACEFILLINGCURVE_HPP */
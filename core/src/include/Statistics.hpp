@@ -0,0 +1,212 @@
+/*!
+ * @file Statistics.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_STATISTICS_HPP
+#define CORE_SRC_INCLUDE_STATISTICS_HPP
+
+#include "include/BitRounding.hpp"
+#include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/Iterator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief The running statistics over time of one field of every element.
+ *
+ * @details For each value of the field, one per element or one per ice layer
+ * per element, the mean, variance, minimum and maximum over all the updates
+ * since the last reset are held, together with an optional histogram of the
+ * values in fixed bins. The mean and variance are updated with Welford's
+ * algorithm, so that no sums of large numbers of values are held.
+ */
+class FieldStatistics {
+public:
+    //! The fixed bins of a histogram. No histogram is held if nBins is zero.
+    struct Bins {
+        double lower; //!< The lower bound of the first bin.
+        double upper; //!< The upper bound of the last bin.
+        int nBins; //!< The number of bins of equal width.
+    };
+
+    /*!
+     * @brief Constructs the statistics of a registered field.
+     *
+     * @param field The name of the field in the FieldRegistry.
+     * @param bins The bins of the histogram of the values, if any.
+     * @throws std::out_of_range if the field is not registered.
+     * @throws std::invalid_argument if the bins are not ordered.
+     */
+    FieldStatistics(const std::string& field, const Bins& bins = { 0., 0., 0 });
+
+    //! Returns the name of the field.
+    const std::string& name() const { return m_name; }
+    //! Returns the bins of the histogram.
+    const Bins& bins() const { return m_bins; }
+    //! Returns whether a histogram of the values is held.
+    bool hasHistogram() const { return m_bins.nBins > 0; }
+
+    /*!
+     * @brief Adds the current values of the field of the data.
+     *
+     * @details The storage of the statistics is sized by the first update
+     * after a reset.
+     *
+     * @throws std::invalid_argument if the number of elements or layers of
+     * the data differs from that of the earlier updates.
+     */
+    void update(const ElementVector& data);
+    //! Discards all the values added since the last reset.
+    void reset();
+    /*!
+     * @brief Rounds the mean, variance, minimum and maximum for output.
+     *
+     * @details The values are rounded to the bits kept for the field by the
+     * rounding, divided between the threads of a team. No further values
+     * should be added until the next reset.
+     */
+    void round(const BitRounding& rounding, ThreadTeam& team = ThreadTeam::main);
+
+    //! Returns the number of updates since the last reset.
+    std::size_t count() const { return m_count; }
+    //! Returns the number of elements of the updates.
+    std::size_t size() const { return m_size; }
+    //! Returns the number of ice layers of the field, 1 for fields without layers.
+    int nLayers() const { return m_nLayers; }
+
+    //! Returns the mean value of element i (and layer, for layered fields).
+    double mean(std::size_t i, int layer = 0) const { return m_mean[index(i, layer)]; }
+    //! Returns the population variance of the values of element i.
+    double variance(std::size_t i, int layer = 0) const
+    {
+        return (m_count > 0) ? m_m2[index(i, layer)] / m_count : 0.;
+    }
+    //! Returns the minimum value of element i.
+    double minimum(std::size_t i, int layer = 0) const { return m_min[index(i, layer)]; }
+    //! Returns the maximum value of element i.
+    double maximum(std::size_t i, int layer = 0) const { return m_max[index(i, layer)]; }
+    /*!
+     * @brief Returns the bin counts of the histogram of element i.
+     *
+     * @details Values below the lower bound are counted in the first bin, and
+     * values above the upper bound in the last.
+     */
+    const std::uint32_t* histogram(std::size_t i, int layer = 0) const
+    {
+        return m_histogram.data() + index(i, layer) * m_bins.nBins;
+    }
+
+    /*!
+     * @brief Returns the contiguous array of a statistic, indexed by element
+     * then layer.
+     */
+    const double* meanData() const { return m_mean.data(); }
+    const double* varianceData() const;
+    const double* minimumData() const { return m_min.data(); }
+    const double* maximumData() const { return m_max.data(); }
+    //! Returns the contiguous bin counts, indexed by element, layer, then bin.
+    const std::uint32_t* histogramData() const { return m_histogram.data(); }
+
+private:
+    std::size_t index(std::size_t i, int layer) const { return i * m_nLayers + layer; }
+
+    std::string m_name;
+    Bins m_bins;
+    std::size_t m_count;
+    std::size_t m_size;
+    int m_nLayers;
+    std::vector<double> m_mean;
+    // The sums of the squared differences from the mean
+    std::vector<double> m_m2;
+    std::vector<double> m_min;
+    std::vector<double> m_max;
+    std::vector<std::uint32_t> m_histogram;
+    // The variance, calculated on demand from m_m2 until rounded
+    mutable std::vector<double> m_variance;
+    bool m_rounded;
+};
+
+/*!
+ * @brief Running statistics of model fields over windows of model time.
+ *
+ * @details The statistics of each field are updated every timestep, and
+ * restart at the end of each window. The statistics of the last completed
+ * window are kept until the end of the following window, so that they can
+ * be written while the next window accumulates. Writing statistics once per
+ * window, rather than the fields every timestep, reduces the output by a
+ * factor of the number of timesteps per window.
+ */
+class Statistics {
+public:
+    Statistics();
+
+    /*!
+     * @brief Adds the statistics of a field.
+     *
+     * @param field The name of the field in the FieldRegistry.
+     * @param bins The bins of the histogram of the values, if any.
+     */
+    void add(const std::string& field, const FieldStatistics::Bins& bins = { 0., 0., 0 });
+    //! Returns whether no fields have been added.
+    bool empty() const { return m_current.empty(); }
+
+    /*!
+     * @brief Sets the length of the statistics windows.
+     *
+     * @param window The model time of each window.
+     * @throws std::invalid_argument if the length is not positive.
+     */
+    void setWindow(Iterator::Duration window);
+    //! Returns the length of the statistics windows.
+    Iterator::Duration window() const { return m_window; }
+
+    /*!
+     * @brief Adds the fields of the data at the end of a timestep.
+     *
+     * @param data The element data.
+     * @param time The model time at the start of the timestep.
+     * @param dt The length of the timestep.
+     * @returns Whether the timestep completes a window, in which case the
+     * statistics of the window are available from completed(), and the
+     * statistics of the next window are accumulated from the next update.
+     */
+    bool update(const ElementVector& data, Iterator::TimePoint time, Iterator::Duration dt);
+    //! Returns whether the latest update completed a window.
+    bool windowCompleted() const { return m_windowCompleted; }
+
+    //! Returns the statistics of the fields in the window being accumulated.
+    const std::vector<FieldStatistics>& current() const { return m_current; }
+    //! Returns the statistics of the fields in the last completed window.
+    const std::vector<FieldStatistics>& completed() const { return m_completed; }
+    //! Returns the model time at the start of the last completed window.
+    Iterator::TimePoint completedStart() const { return m_completedStart; }
+    //! Returns the model time at the end of the last completed window.
+    Iterator::TimePoint completedEnd() const { return m_completedEnd; }
+
+    //! Rounds the statistics of the last completed window for output.
+    void roundCompleted(const BitRounding& rounding, ThreadTeam& team = ThreadTeam::main);
+
+private:
+    Iterator::Duration m_window;
+    std::vector<FieldStatistics> m_current;
+    std::vector<FieldStatistics> m_completed;
+    // Whether the next update starts a window
+    bool m_newWindow;
+    Iterator::TimePoint m_currentStart;
+    bool m_windowCompleted;
+    Iterator::TimePoint m_completedStart;
+    Iterator::TimePoint m_completedEnd;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_STATISTICS_HPP */
@@ -0,0 +1,108 @@
+/*!
+ * @file TaskGraph.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_TASKGRAPH_HPP
+#define CORE_SRC_INCLUDE_TASKGRAPH_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A class to execute the stages of consecutive timesteps as a
+ * dependency graph.
+ *
+ * @details Each stage (reading forcing, computing the physics, writing
+ * output…) is declared once, together with the stages it depends on in the
+ * same timestep and in the previous timestep. The steps of any one stage are
+ * always executed in order and never concurrently with each other, but
+ * different stages, from the same or different timesteps, run concurrently
+ * on a small pool of threads as soon as their dependencies are met. This
+ * allows, for example, the output of one timestep to be written while the
+ * physics of the next timestep is being calculated.
+ *
+ * Dependencies on stages that have not been declared are ignored, so that
+ * the standard dependencies can be declared even when a stage is not present.
+ */
+class TaskGraph {
+public:
+    //! The function executed by a stage. The argument is the step index.
+    typedef std::function<void(int)> Stage;
+
+    TaskGraph();
+    ~TaskGraph() = default;
+
+    /*!
+     * @brief Declares a new stage.
+     *
+     * @param name The unique name of the stage.
+     * @param stage The function to execute for each timestep.
+     * @param dependencies The stages which must have completed the same
+     *        timestep before this stage can start.
+     * @param previousStepDependencies The stages which must have completed
+     *        the previous timestep before this stage can start.
+     */
+    void addStage(const std::string& name, const Stage& stage,
+        const std::vector<std::string>& dependencies = {},
+        const std::vector<std::string>& previousStepDependencies = {});
+
+    //! Returns whether a stage of the given name has been declared.
+    bool hasStage(const std::string& name) const;
+    //! Returns the number of declared stages.
+    int nStages() const { return m_nodes.size(); }
+    //! Removes all stages.
+    void clear() { m_nodes.clear(); }
+
+    /*!
+     * @brief Sets the maximum number of threads used to execute the stages.
+     *
+     * @details A value of zero or less uses the hardware concurrency. No
+     * more threads than stages are ever started.
+     *
+     * @param nThreads The maximum number of threads.
+     */
+    void setThreads(int nThreads) { m_nThreads = nThreads; }
+
+    /*!
+     * @brief Sets how many timesteps any stage may run ahead of the oldest
+     * timestep that is not yet complete.
+     *
+     * @param lead The maximum number of timesteps of lead. Must be at least
+     *        zero.
+     */
+    void setMaxLead(int lead) { m_maxLead = (lead < 0) ? 0 : lead; }
+
+    /*!
+     * @brief Executes all of the stages for a number of timesteps.
+     *
+     * @details Returns when every stage has completed every timestep. If any
+     * stage throws, no further stages are started and the first exception is
+     * rethrown once the running stages have finished. A std::logic_error is
+     * thrown if the dependencies contain a cycle.
+     *
+     * @param nSteps The number of timesteps to execute.
+     */
+    void run(int nSteps);
+
+private:
+    struct Node {
+        std::string name;
+        Stage stage;
+        std::vector<std::string> dependencies;
+        std::vector<std::string> previousStepDependencies;
+    };
+
+    std::vector<Node> m_nodes;
+    int m_nThreads;
+    int m_maxLead;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_TASKGRAPH_HPP */
@@ -0,0 +1,149 @@
+/*!
+ * @file ThreadTeam.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_THREADTEAM_HPP
+#define CORE_SRC_INCLUDE_THREADTEAM_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief A persistent team of threads which divide work on the element data
+ * in a fixed way.
+ *
+ * @details The elements of a structure are divided into contiguous blocks,
+ * one per thread, by block(). The same division is used to first touch the
+ * memory of the elements, which on Linux places each page on the NUMA node
+ * of the thread that first writes to it, and to compute on the elements, so
+ * that each thread works on memory local to its own node. The threads
+ * persist between calls to run(), and may optionally be pinned to cores so
+ * that they do not migrate away from their memory.
+ *
+ * Each model has a team of its own, held in its ModelContext and configured
+ * with the model.threads and model.pin_threads settings before the data
+ * structure is initialized, so that models running concurrently do not
+ * share or reconfigure each other's threads. The main team serves elements
+ * and callers outside any model.
+ */
+class ThreadTeam {
+public:
+    //! A task executed by every thread of the team. The argument is the thread index.
+    typedef std::function<void(int)> Task;
+
+    //! Constructs a team of one thread, the calling thread.
+    ThreadTeam();
+    ~ThreadTeam();
+
+    ThreadTeam(const ThreadTeam&) = delete;
+    ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+    /*!
+     * @brief Sets the number of threads in the team, including the calling thread.
+     *
+     * @param nThreads The number of threads. Zero or less uses the hardware
+     * concurrency.
+     */
+    void setThreads(int nThreads);
+    //! Returns the number of threads in the team.
+    int nThreads() const { return m_nThreads; }
+
+    /*!
+     * @brief Sets whether each thread is pinned to a core.
+     *
+     * @details Thread i is pinned to the i-th core of the cores the process
+     * may run on, so that MPI ranks pinned to different sockets by the MPI
+     * launcher keep their threads on their own socket. The thread calling
+     * run() is pinned as thread 0 only while it executes the task, and its
+     * own affinity is then restored, so that threads it later creates are
+     * not confined to a single core. Pinning is only available on Linux, and
+     * is otherwise ignored.
+     */
+    void setPinning(bool pin);
+    //! Returns whether the threads are pinned to cores.
+    bool pinning() const { return m_pin; }
+
+    /*!
+     * @brief Executes a task on every thread of the team, returning when all
+     * have finished.
+     *
+     * @details The calling thread executes the task as thread 0. If any
+     * thread throws, the first exception is rethrown once all have finished.
+     * Calls from different threads are serialised, each waiting for the
+     * task of the previous one to finish, and the team is not reconfigured
+     * while a task runs. A task must not itself call run() on its own team.
+     */
+    void run(const Task& task);
+
+    /*!
+     * @brief Writes to every memory page of an array from the thread which
+     * will compute on that part of the array.
+     *
+     * @details The array is divided between the threads as by block(). On
+     * systems with first touch page placement, this places each page on the
+     * NUMA node of the thread. It must be called on freshly allocated,
+     * untouched memory, before the elements are constructed.
+     *
+     * @param storage The start of the array.
+     * @param nItems The number of items in the array.
+     * @param itemSize The size of each item in bytes.
+     */
+    void firstTouch(void* storage, std::size_t nItems, std::size_t itemSize);
+
+    /*!
+     * @brief Returns the range [first, last) of the items assigned to a thread.
+     *
+     * @details The items are divided into contiguous blocks, with the first
+     * (nItems % nThreads) threads holding one extra item.
+     */
+    static std::pair<std::size_t, std::size_t> block(std::size_t nItems, int thread, int nThreads);
+
+    //! The team of the default ModelContext and of callers outside any model.
+    static ThreadTeam main;
+
+private:
+    class CallerPin;
+
+    void startWorkers();
+    void stopWorkers();
+    void work(int thread, unsigned long done);
+    void execute(int thread);
+    void pinThread(int thread);
+    // Restricts the calling thread to the given cores
+    static void setAffinity(const std::vector<int>& cores);
+    // Returns the cores the calling thread may run on
+    static std::vector<int> affinity();
+
+    int m_nThreads;
+    bool m_pin;
+    std::vector<std::thread> m_workers;
+    // The cores the process may run on, for pinning
+    std::vector<int> m_cores;
+
+    // Held by run() and the reconfiguration, so that tasks do not overlap
+    std::mutex m_runMutex;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    const Task* m_task;
+    // Incremented for each task, so that each worker runs each task once
+    unsigned long m_generation;
+    int m_running;
+    bool m_stopping;
+    std::exception_ptr m_error;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_THREADTEAM_HPP */
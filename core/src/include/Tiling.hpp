@@ -0,0 +1,112 @@
+/*!
+ * @file Tiling.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_TILING_HPP
+#define CORE_SRC_INCLUDE_TILING_HPP
+
+#include "include/ElementData.hpp"
+#include "include/IStructure.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace Nextsim {
+
+/*!
+ * @brief Runs several passes over the elements of a structure one tile of
+ * elements at a time.
+ *
+ * @details A step made of several passes over the whole structure reads
+ * every element from main memory once per pass. Here the elements are
+ * divided into tiles of consecutive elements in cursor order, and all of the
+ * passes are run on one tile before moving to the next, so that a tile small
+ * enough to stay in cache is read from memory only once. For the structured
+ * grids the cursor order is the storage order, so each tile is a contiguous
+ * block of memory.
+ *
+ * The passes of a tile run in the order they were added. Each pass may
+ * depend on the results of the earlier passes for the elements of the same
+ * tile, but not on the elements of other tiles, as there are no halos.
+ *
+ * When the ThreadTeam of the model context of the structure has more than
+ * one thread, each thread runs the passes on the tiles of its own block of
+ * elements, so the passes must be safe to call concurrently on different
+ * tiles.
+ */
+class Tiling {
+public:
+    //! The elements of one tile.
+    typedef std::vector<ElementData*> Tile;
+    //! A pass over the elements of one tile.
+    typedef std::function<void(const Tile&)> Pass;
+
+    //! Constructs a tiling with the default tile size.
+    Tiling();
+    /*!
+     * @brief Constructs a tiling with the given tile size.
+     *
+     * @throws std::invalid_argument if the tile size is less than one.
+     */
+    Tiling(int tileSize);
+
+    /*!
+     * @brief Sets the number of elements in each tile.
+     *
+     * @details The best size is the largest for which the data of a tile
+     * used by all of the passes fits in the cache.
+     *
+     * @throws std::invalid_argument if the tile size is less than one.
+     */
+    void setTileSize(int tileSize);
+    //! Returns the number of elements in each tile.
+    int tileSize() const { return m_tileSize; }
+
+    //! Adds a pass, which runs after the existing passes on each tile.
+    void addPass(const Pass& pass) { m_passes.push_back(pass); }
+    //! Returns the number of passes.
+    int nPasses() const { return m_passes.size(); }
+    //! Removes all passes.
+    void clearPasses() { m_passes.clear(); }
+
+    /*!
+     * @brief Runs all of the passes on each tile of the structure in turn.
+     *
+     * @details The final tile holds the remaining elements, and may be
+     * smaller than the tile size.
+     *
+     * @param structure The structure holding the elements.
+     */
+    void run(IStructure& structure);
+
+    /*!
+     * @brief Lists the elements of a structure in cursor order.
+     *
+     * @details The elements are taken from the element storage of the
+     * structure when it has one, so that the cursor, which is shared by all
+     * users of the structure, is left untouched.
+     *
+     * @param structure The structure holding the elements.
+     * @param elements Replaced by the addresses of the elements.
+     */
+    static void elements(IStructure& structure, std::vector<ElementData*>& elements);
+
+    //! The default number of elements in each tile.
+    static const int defaultTileSize = 32;
+
+private:
+    void runPasses(Tile& tile) const;
+
+    int m_tileSize;
+    std::vector<Pass> m_passes;
+    Tile m_tile;
+    // All of the elements, in cursor order
+    std::vector<ElementData*> m_elements;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_TILING_HPP */
@@ -57,15 +57,22 @@ public:
     void tock();
 
     /*!
-     * @brief Returns the elapsed time without stopping the timer.
+     * @brief Returns the wall time in seconds since the timer was last
+     * started, without stopping the timer.
+     *
+     * @details Returns zero if the timer is not running. If several timers
+     * share the name, the first found in a depth first search is used.
      *
      * @param timerName the name of the timer to interrogate.
+     * @throws std::out_of_range if there is no timer of that name.
      */
     double lap(const Key& timerName) const;
     /*!
-     * @brief Returns the elapsed time.
+     * @brief Returns the cumulative wall time in seconds of all activations
+     * of the timer, including any current activation.
      *
      * @param timerName the name of the timer to interrogate.
+     * @throws std::out_of_range if there is no timer of that name.
      */
     double elapsed(const Key& timerName) const;
 
@@ -124,9 +131,11 @@ private:
         std::ostream& reportAll(std::ostream& os, const std::string& prefix) const;
 
         TimerPath searchDescendants(const Key& timerName) const;
+        const TimerNode* findDescendant(const Key& timerName) const;
     };
 
     TimerPath pathToFirstMatch(const Key&) const;
+    const TimerNode& firstMatch(const Key&) const;
 
     TimerNode root;
     TimerNode* current;
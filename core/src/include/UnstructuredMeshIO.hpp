@@ -0,0 +1,41 @@
+/*!
+ * @file UnstructuredMeshIO.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_UNSTRUCTUREDMESHIO_HPP
+#define CORE_SRC_INCLUDE_UNSTRUCTUREDMESHIO_HPP
+
+#include "include/ElementData.hpp"
+#include "include/IUnstructuredMeshIO.hpp"
+
+namespace Nextsim {
+
+class UnstructuredMesh;
+
+/*!
+ * @brief The netCDF IO of UnstructuredMesh.
+ *
+ * @details The data group holds the node coordinates node_x and node_y, the
+ * element_nodes connectivity, with unused vertices set to the fill value of
+ * UnstructuredMesh::noNode(), and a variable for each field, with the
+ * elements as the first dimension.
+ */
+class UnstructuredMeshIO : public IUnstructuredMeshIO {
+public:
+    UnstructuredMeshIO(UnstructuredMesh& mesh)
+        : IUnstructuredMeshIO(mesh)
+    {
+    }
+    virtual ~UnstructuredMeshIO() = default;
+
+    void init(ElementVector& data, const std::string& filePath) const override;
+    void dump(const ElementVector& data, const std::string& filePath) const override;
+    void dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const override;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_UNSTRUCTUREDMESHIO_HPP */
@@ -6,6 +6,10 @@
 
 #include <iostream>
 
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
 #include "include/CommandLineParser.hpp"
 #include "include/Configurator.hpp"
 #include "include/ConfiguredModule.hpp"
@@ -13,6 +17,9 @@
 
 int main(int argc, char* argv[])
 {
+#ifdef USE_MPI
+    MPI_Init(&argc, &argv);
+#endif
 
     // Pass the command line to Configurator to handle
     Nextsim::Configurator::setCommandLine(argc, argv);
@@ -32,6 +39,13 @@ int main(int argc, char* argv[])
     model.configure();
     // Run the Model
     model.run();
+    // Start writing the restart file in the background. Any post-run work
+    // placed before the drain overlaps with the writing.
+    model.finalize();
+    bool restartWritten = model.drainRestart().success;
 
-    return 0;
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
+    return restartWritten ? 0 : 1;
 }
@@ -8,6 +8,11 @@
 #include "include/DevGrid.hpp"
 #include "include/ElementData.hpp"
 
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -21,11 +26,18 @@ const int DevGrid::nx = 10;
 
 void DevGrid::init(const std::string& filePath)
 {
-    ElementData configureMe;
+    ElementData configureMe(1, context());
     configureMe.configure();
-    data.resize(nx * nx);
+    decompose();
+    // The IO allocates the elements with the number of layers of the file
     if (pio && !filePath.empty()) {
         pio->init(data, filePath);
+    } else {
+        // A mask set for different rows is replaced by one without land
+        if (m_mask.nxLocal() != m_nxLocal || m_mask.ny() != nx) {
+            m_mask = LandMask(m_nxLocal, nx);
+        }
+        allocateElements(data, m_mask.nOcean(), 1, context());
     }
 };
 
@@ -36,6 +48,54 @@ void DevGrid::dump(const std::string& filePath) const
     }
 };
 
+void DevGrid::dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const
+{
+    if (pio && !filePath.empty()) {
+        pio->dumpSnapshot(snapshot, filePath);
+    }
+}
+
+void DevGrid::dumpStatistics(
+    const Statistics& statistics, const std::string& filePath, int deflateLevel) const
+{
+    if (pio && !filePath.empty()) {
+        pio->dumpStatistics(statistics, filePath, deflateLevel);
+    }
+}
+
+void DevGrid::coarsen(Coarsening& coarsening) const
+{
+    if (pio) {
+        pio->coarsen(data, coarsening);
+    }
+}
+
+void DevGrid::dumpCoarsened(
+    const Coarsening& coarsening, const std::string& filePath, int deflateLevel) const
+{
+    if (pio && !filePath.empty()) {
+        pio->dumpCoarsened(coarsening, filePath, deflateLevel);
+    }
+}
+
+void DevGrid::decompose()
+{
+#ifdef USE_MPI
+    int rank;
+    int nRanks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+    // The first nx % nRanks ranks hold one extra row
+    int base = nx / nRanks;
+    int extra = nx % nRanks;
+    m_nxLocal = base + ((rank < extra) ? 1 : 0);
+    m_xStart = rank * base + std::min(rank, extra);
+#else
+    m_xStart = 0;
+    m_nxLocal = nx;
+#endif
+}
+
 // Cursor manipulation override functions
 int DevGrid::resetCursor()
 {
@@ -0,0 +1,232 @@
+/*!
+ * @file UnstructuredMesh.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/UnstructuredMesh.hpp"
+#include "include/ElementData.hpp"
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Nextsim {
+
+const std::string UnstructuredMesh::structureName = "mesh";
+const std::string UnstructuredMesh::nodeDimName = "nNodes";
+const std::string UnstructuredMesh::elementDimName = "nElements";
+const std::string UnstructuredMesh::vertexDimName = "nMaxVertices";
+const std::string UnstructuredMesh::nIceLayersName = "nLayers";
+
+void UnstructuredMesh::init(const std::string& filePath)
+{
+#ifdef USE_MPI
+    int nRanks;
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+    if (nRanks > 1) {
+        throw std::runtime_error(
+            "UnstructuredMesh: the mesh cannot be divided between MPI ranks");
+    }
+#endif
+    ElementData configureMe(1, context());
+    configureMe.configure();
+    // The IO allocates the elements with the number of layers of the file
+    if (pio && !filePath.empty()) {
+        pio->init(data, filePath);
+    } else {
+        allocate(1);
+    }
+}
+
+void UnstructuredMesh::dump(const std::string& filePath) const
+{
+    if (pio && !filePath.empty()) {
+        pio->dump(data, filePath);
+    }
+}
+
+void UnstructuredMesh::dumpSnapshot(
+    const RestartSnapshot& snapshot, const std::string& filePath) const
+{
+    if (pio && !filePath.empty()) {
+        pio->dumpSnapshot(snapshot, filePath);
+    }
+}
+
+void UnstructuredMesh::setMesh(const std::vector<double>& nodeX, const std::vector<double>& nodeY,
+    const std::vector<int>& elementNodes, int nMaxVertices)
+{
+    const std::size_t nNodesIn = nodeX.size();
+    if (nodeY.size() != nNodesIn) {
+        throw std::invalid_argument("UnstructuredMesh: " + std::to_string(nodeX.size())
+            + " x coordinates and " + std::to_string(nodeY.size()) + " y coordinates");
+    }
+    if (nMaxVertices < 3 || elementNodes.size() % nMaxVertices != 0) {
+        throw std::invalid_argument("UnstructuredMesh: " + std::to_string(elementNodes.size())
+            + " vertices for elements of at most " + std::to_string(nMaxVertices));
+    }
+    const std::size_t nElementsIn = elementNodes.size() / nMaxVertices;
+
+    // Check the vertices and find the centroid of each element
+    std::vector<int> nVerticesIn(nElementsIn);
+    std::vector<double> centroidX(nElementsIn);
+    std::vector<double> centroidY(nElementsIn);
+    for (std::size_t element = 0; element < nElementsIn; ++element) {
+        const int* nodes = &elementNodes[element * nMaxVertices];
+        int n = 0;
+        while (n < nMaxVertices && nodes[n] != noNode()) {
+            if (nodes[n] < 0 || std::size_t(nodes[n]) >= nNodesIn) {
+                throw std::invalid_argument("UnstructuredMesh: element "
+                    + std::to_string(element) + " has node " + std::to_string(nodes[n]) + " of "
+                    + std::to_string(nNodesIn));
+            }
+            centroidX[element] += nodeX[nodes[n]];
+            centroidY[element] += nodeY[nodes[n]];
+            ++n;
+        }
+        if (n < 3 || std::count(nodes + n, nodes + nMaxVertices, noNode()) != nMaxVertices - n) {
+            throw std::invalid_argument(
+                "UnstructuredMesh: element " + std::to_string(element) + " is not a polygon");
+        }
+        nVerticesIn[element] = n;
+        centroidX[element] /= n;
+        centroidY[element] /= n;
+    }
+
+    m_nMaxVertices = nMaxVertices;
+    m_elementIndex = SpaceFillingCurve::sortOrder(centroidX, centroidY, m_curve);
+
+    // Number the nodes in the order of their first use by the reordered elements
+    const std::size_t unnumbered = nNodesIn;
+    std::vector<std::size_t> newNode(nNodesIn, unnumbered);
+    m_nodeIndex.clear();
+    m_nodeIndex.reserve(nNodesIn);
+    m_vertexStart.assign(1, 0);
+    m_vertices.clear();
+    for (std::size_t index : m_elementIndex) {
+        const int* nodes = &elementNodes[index * nMaxVertices];
+        for (int i = 0; i < nVerticesIn[index]; ++i) {
+            if (newNode[nodes[i]] == unnumbered) {
+                newNode[nodes[i]] = m_nodeIndex.size();
+                m_nodeIndex.push_back(nodes[i]);
+            }
+            m_vertices.push_back(newNode[nodes[i]]);
+        }
+        m_vertexStart.push_back(m_vertices.size());
+    }
+    for (std::size_t node = 0; node < nNodesIn; ++node) {
+        if (newNode[node] == unnumbered) {
+            newNode[node] = m_nodeIndex.size();
+            m_nodeIndex.push_back(node);
+        }
+    }
+    m_nodeX.resize(nNodesIn);
+    m_nodeY.resize(nNodesIn);
+    for (std::size_t node = 0; node < nNodesIn; ++node) {
+        m_nodeX[node] = nodeX[m_nodeIndex[node]];
+        m_nodeY[node] = nodeY[m_nodeIndex[node]];
+    }
+
+    // The area of each element, by the shoelace formula
+    m_area.resize(nElementsIn);
+    for (std::size_t element = 0; element < nElementsIn; ++element) {
+        double twiceArea = 0;
+        const int n = nVertices(element);
+        for (int i = 0; i < n; ++i) {
+            std::size_t a = vertex(element, i);
+            std::size_t b = vertex(element, (i + 1) % n);
+            twiceArea += m_nodeX[a] * m_nodeY[b] - m_nodeX[b] * m_nodeY[a];
+        }
+        m_area[element] = 0.5 * std::fabs(twiceArea);
+    }
+
+    findNeighbours();
+}
+
+void UnstructuredMesh::originalMesh(
+    std::vector<double>& nodeX, std::vector<double>& nodeY, std::vector<int>& elementNodes) const
+{
+    nodeX.resize(nNodes());
+    nodeY.resize(nNodes());
+    for (std::size_t node = 0; node < nNodes(); ++node) {
+        nodeX[m_nodeIndex[node]] = m_nodeX[node];
+        nodeY[m_nodeIndex[node]] = m_nodeY[node];
+    }
+    elementNodes.assign(nElements() * m_nMaxVertices, noNode());
+    for (std::size_t element = 0; element < nElements(); ++element) {
+        int* nodes = &elementNodes[m_elementIndex[element] * m_nMaxVertices];
+        for (int i = 0; i < nVertices(element); ++i) {
+            nodes[i] = m_nodeIndex[vertex(element, i)];
+        }
+    }
+}
+
+void UnstructuredMesh::allocate(int nLayers)
+{
+    allocateElements(data, nElements(), nLayers, context());
+}
+
+void UnstructuredMesh::findNeighbours()
+{
+    // Each side as its pair of nodes, lower first, and its element. The two
+    // elements sharing a side are adjacent once the sides are sorted.
+    std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> sides;
+    sides.reserve(m_vertices.size());
+    for (std::size_t element = 0; element < nElements(); ++element) {
+        const int n = nVertices(element);
+        for (int i = 0; i < n; ++i) {
+            std::size_t a = vertex(element, i);
+            std::size_t b = vertex(element, (i + 1) % n);
+            sides.emplace_back(std::min(a, b), std::max(a, b), element);
+        }
+    }
+    std::sort(sides.begin(), sides.end());
+
+    std::vector<std::vector<std::size_t>> adjacent(nElements());
+    for (std::size_t first = 0; first < sides.size();) {
+        std::size_t last = first + 1;
+        while (last < sides.size() && std::get<0>(sides[last]) == std::get<0>(sides[first])
+            && std::get<1>(sides[last]) == std::get<1>(sides[first])) {
+            ++last;
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            for (std::size_t j = first; j < last; ++j) {
+                if (std::get<2>(sides[i]) != std::get<2>(sides[j]))
+                    adjacent[std::get<2>(sides[i])].push_back(std::get<2>(sides[j]));
+            }
+        }
+        first = last;
+    }
+
+    m_neighbourStart.assign(1, 0);
+    m_neighbours.clear();
+    for (auto& neighbours : adjacent) {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        m_neighbours.insert(m_neighbours.end(), neighbours.begin(), neighbours.end());
+        m_neighbourStart.push_back(m_neighbours.size());
+    }
+}
+
+// Cursor manipulation override functions
+int UnstructuredMesh::resetCursor()
+{
+    iCursor = data.begin();
+    return IStructure::resetCursor();
+}
+bool UnstructuredMesh::validCursor() const { return iCursor != data.end(); }
+ElementData& UnstructuredMesh::cursorData() { return *iCursor; }
+const ElementData& UnstructuredMesh::cursorData() const { return *iCursor; }
+void UnstructuredMesh::incrCursor() { ++iCursor; }
+
+} /* namespace Nextsim */
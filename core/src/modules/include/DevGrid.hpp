@@ -12,6 +12,7 @@
 
 #include "include/ElementData.hpp"
 #include "include/IDevGridIO.hpp"
+#include "include/LandMask.hpp"
 #include "include/PrognosticData.hpp"
 
 #include <map>
@@ -20,11 +21,22 @@ namespace Nextsim {
 
 class DevGridIO;
 
-//! A class to hold a grid of ElementData instances in a fixed sized square grid.
+/*!
+ * @brief A class to hold a grid of ElementData instances in a fixed sized square grid.
+ *
+ * @details When built with MPI (USE_MPI), the x rows of the grid are divided
+ * into contiguous blocks, one per rank, and each process holds only the
+ * elements of its own rows.
+ *
+ * If the restart file has a land mask, only the ocean cells of the rows hold
+ * elements, compressed as described by LandMask.
+ */
 class DevGrid : public IStructure {
 public:
     DevGrid()
-        : pio(nullptr)
+        : m_xStart(0)
+        , m_nxLocal(nx)
+        , pio(nullptr)
     {
     }
 
@@ -44,9 +56,39 @@ public:
 
     void dump(const std::string& filePath) const override;
 
+    void dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const override;
+
+    bool hasStatisticsOutput() const override { return true; }
+    void dumpStatistics(const Statistics& statistics, const std::string& filePath,
+        int deflateLevel) const override;
+
+    bool hasCoarsenedOutput() const override { return true; }
+    void coarsen(Coarsening& coarsening) const override;
+
+    void dumpCoarsened(const Coarsening& coarsening, const std::string& filePath,
+        int deflateLevel) const override;
+
     std::string structureType() const override { return structureName; };
 
-    int nIceLayers() const override { return 1; };
+    int nIceLayers() const override { return data.empty() ? 1 : data.front().nIceLayers(); };
+
+    //! The first x index of the rows of the grid held by this process.
+    int xStart() const { return m_xStart; }
+    //! The number of rows of the grid held by this process.
+    int nxLocal() const { return m_nxLocal; }
+
+    //! Returns the land mask of the rows of the grid held by this process.
+    const LandMask& landMask() const { return m_mask; }
+    /*!
+     * @brief Sets the land mask of the rows held, which applies to the
+     * elements of later calls to init() without a restart file.
+     *
+     * @details Initialization from a restart file replaces the mask with that
+     * of the file, or with a mask without land if the file has none.
+     *
+     * @param mask The land mask of the rows of the grid held by this process.
+     */
+    void setLandMask(const LandMask& mask) { m_mask = mask; }
 
     // Cursor manipulation override functions
     int resetCursor() override;
@@ -55,17 +97,25 @@ public:
     const ElementData& cursorData() const override;
     void incrCursor() override;
 
+    ElementVector* elementStorage() override { return &data; }
+
     //! Sets the pointer to the class that will perform the IO. Should be an instance of DevGridIO
     void setIO(IDevGridIO* p) { pio = p; }
 
 private:
+    // Divides the rows of the grid between the MPI ranks
+    void decompose();
+
     const static std::string xDimName;
     const static std::string yDimName;
     const static std::string nIceLayersName;
 
-    std::vector<ElementData> data;
+    int m_xStart;
+    int m_nxLocal;
+    LandMask m_mask;
+    ElementVector data;
 
-    std::vector<ElementData>::iterator iCursor;
+    ElementVector::iterator iCursor;
 
     IDevGridIO* pio;
 
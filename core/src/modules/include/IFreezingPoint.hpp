@@ -8,6 +8,8 @@
 #ifndef SRC_INCLUDE_IFREEZINGPOINT_HPP_
 #define SRC_INCLUDE_IFREEZINGPOINT_HPP_
 
+#include <cstddef>
+
 namespace Nextsim {
 
 //! The interface class for calculation of the freezing point of seawater.
@@ -25,6 +27,23 @@ public:
      * @param sss Sea surface salinity [PSU]
      */
     virtual double operator()(double sss) const = 0;
+    /*!
+     * @brief Calculates the freezing points of a block of seawater salinities.
+     *
+     * @details The default implementation calls operator() for each
+     * salinity. Implementations override it with a loop which the compiler
+     * can vectorize, giving the same values as operator().
+     *
+     * @param sss Sea surface salinities [PSU]
+     * @param freezingPoint The freezing points [˚C], written by the function.
+     * @param n The number of salinities.
+     */
+    virtual void blockFreezingPoint(const double* sss, double* freezingPoint, std::size_t n) const
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            freezingPoint[i] = (*this)(sss[i]);
+        }
+    }
 };
 }
 #endif /* SRC_INCLUDE_IFREEZINGPOINT_HPP_ */
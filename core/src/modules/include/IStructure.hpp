@@ -9,8 +9,11 @@
 #define CORE_SRC_INCLUDE_ISTRUCTURE_HPP
 
 #include "include/ElementData.hpp"
+#include "include/ModelContext.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <cstddef>
+#include <stdexcept>
 #include <string>
 
 // See https://isocpp.org/wiki/faq/pointers-to-members#macro-for-ptr-to-memfn
@@ -18,6 +21,10 @@
 
 namespace Nextsim {
 
+class Coarsening;
+class RestartSnapshot;
+class Statistics;
+
 /*!
  * @brief Interface class for the model structure.
  *
@@ -33,6 +40,7 @@ class IStructure {
 public:
     IStructure()
         : cursor(*this)
+        , pContext(&ModelContext::defaultContext())
     {
     }
     virtual ~IStructure() = default;
@@ -66,6 +74,66 @@ public:
      * @param filePath The path to attempt writing the data to.
      */
     virtual void dump(const std::string& filePath) const = 0;
+    /*!
+     * @brief Writes a snapshot of the restart fields to a file path, in the
+     * format written by dump().
+     *
+     * @details The snapshot is independent of the data of the structure, so
+     * the writing may overlap with changes to the data. Structures without
+     * snapshot output write their current data with dump() instead, so the
+     * data must then be unchanged until the writing is complete.
+     *
+     * @param snapshot The snapshot of the element data of this structure.
+     * @param filePath The path to attempt writing the data to.
+     */
+    virtual void dumpSnapshot(const RestartSnapshot&, const std::string& filePath) const
+    {
+        dump(filePath);
+    }
+    //! Returns whether the structure writes statistics with dumpStatistics().
+    virtual bool hasStatisticsOutput() const { return false; }
+    /*!
+     * @brief Writes the statistics of the last completed window to a file path.
+     *
+     * @details With MPI the call is collective, and must be made on every
+     * rank by the thread which initialized MPI.
+     *
+     * @param statistics The statistics of the element data of this structure.
+     * @param filePath The path to attempt writing the statistics to.
+     * @param deflateLevel The deflate compression level of the output, 0 for none.
+     * @throws std::logic_error if the structure has no statistics output.
+     */
+    virtual void dumpStatistics(const Statistics&, const std::string&, int) const
+    {
+        throw std::logic_error("The " + structureType() + " structure has no statistics output");
+    }
+    //! Returns whether the structure writes coarsened fields with coarsen() and dumpCoarsened().
+    virtual bool hasCoarsenedOutput() const { return false; }
+    /*!
+     * @brief Coarsens the output fields of the data.
+     *
+     * @param coarsening The coarsening to hold the coarsened fields.
+     * @throws std::logic_error if the structure has no coarsened output.
+     */
+    virtual void coarsen(Coarsening&) const
+    {
+        throw std::logic_error("The " + structureType() + " structure has no coarsened output");
+    }
+    /*!
+     * @brief Writes the fields coarsened by coarsen() to a file path.
+     *
+     * @details With MPI the call is collective, and must be made on every
+     * rank by the thread which initialized MPI.
+     *
+     * @param coarsening The coarsened fields of this structure.
+     * @param filePath The path to attempt writing the fields to.
+     * @param deflateLevel The deflate compression level of the output, 0 for none.
+     * @throws std::logic_error if the structure has no coarsened output.
+     */
+    virtual void dumpCoarsened(const Coarsening&, const std::string&, int) const
+    {
+        throw std::logic_error("The " + structureType() + " structure has no coarsened output");
+    }
     /*!
      * @brief Resets the data cursor.
      *
@@ -93,6 +161,42 @@ public:
      */
     virtual void incrCursor() = 0;
 
+    /*!
+     * @brief Returns the area of the element at the cursor [m²].
+     *
+     * @details Structures without a geometry treat every element as having
+     * unit area, so that area integrals are sums over the elements.
+     */
+    virtual double cursorArea() const { return 1.; }
+    /*!
+     * @brief Returns the area of an element of the element storage [m²].
+     *
+     * @details The argument is the index of the element in elementStorage().
+     * As for cursorArea(), structures without a geometry return unit area.
+     */
+    virtual double elementArea(std::size_t) const { return 1.; }
+
+    /*!
+     * @brief Returns the storage of the elements, if the structure holds all
+     * of them in a single ElementVector, and nullptr otherwise.
+     *
+     * @details The storage allows views of whole fields without copying, as
+     * returned by FieldRegistry::view().
+     */
+    virtual ElementVector* elementStorage() { return nullptr; }
+
+    /*!
+     * @brief Sets the model context of the elements of the structure.
+     *
+     * @details The context applies to the elements created by later calls to
+     * init(). Structures which are not given a context use the default one.
+     *
+     * @param context The context, which must outlive the structure.
+     */
+    void setContext(ModelContext& context) { pContext = &context; }
+    //! Returns the model context of the elements of the structure.
+    ModelContext& context() const { return *pContext; }
+
     class Cursor {
     public:
         Cursor(IStructure& ownerer)
@@ -134,6 +238,7 @@ public:
 private:
     //! Name of the structure type processed by this class.
     const std::string processedStructureName = "none";
+    ModelContext* pContext;
 };
 
 }
@@ -32,6 +32,14 @@ public:
         // μ is positive, so a negative sign is needed so that the freezing point is below zero.
         return -Water::mu * sss;
     }
+
+    //! Calculates the freezing points of a block of salinities, as operator().
+    void blockFreezingPoint(const double* sss, double* freezingPoint, std::size_t n) const override
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            freezingPoint[i] = -Water::mu * sss[i];
+        }
+    }
 };
 }
 
@@ -25,9 +25,25 @@ class UnescoFreezing : public IFreezingPoint {
      *
      * @param sss Sea surface salinity [PSU]
      */
-    inline double operator()(double sss) const override
+    inline double operator()(double sss) const override { return fofonoffMillard(sss); }
+
+    /*!
+     * @brief Calculates the freezing points of a block of salinities, as
+     * operator().
+     *
+     * @details The loop vectorizes, including the square root, when the math
+     * functions are not required to set errno.
+     */
+    void blockFreezingPoint(const double* sss, double* freezingPoint, std::size_t n) const override
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            freezingPoint[i] = fofonoffMillard(sss[i]);
+        }
+    }
+
+    // Fofonoff and Millard, Unesco technical papers in marine science 44, (1983)
+    static inline double fofonoffMillard(double sss)
     {
-        // Fofonoff and Millard, Unesco technical papers in marine science 44, (1983)
         const double a0 = -0.0575;
         const double a1 = +1.710523e-3;
         const double a2 = -2.154996e-4;
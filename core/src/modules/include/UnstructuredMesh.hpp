@@ -0,0 +1,239 @@
+/*!
+ * @file UnstructuredMesh.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef CORE_SRC_INCLUDE_UNSTRUCTUREDMESH_HPP
+#define CORE_SRC_INCLUDE_UNSTRUCTUREDMESH_HPP
+
+#include "include/IStructure.hpp"
+
+#include "include/ElementData.hpp"
+#include "include/IUnstructuredMeshIO.hpp"
+#include "include/SpaceFillingCurve.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Nextsim {
+
+class UnstructuredMeshIO;
+
+/*!
+ * @brief A class to hold ElementData instances on the triangles or polygons
+ * of an unstructured mesh.
+ *
+ * @details The mesh is defined by the coordinates of its nodes and the nodes
+ * at the vertices of each element. The elements are stored in the order of a
+ * space-filling curve through their centroids, and the nodes in the order of
+ * their first use by the elements, so that kernels over the neighbours of
+ * each element find them nearby in memory. The original index of each node
+ * and element is kept, so that files are written in the order of the file
+ * from which the mesh was read.
+ *
+ * The mesh is not divided between MPI ranks.
+ */
+class UnstructuredMesh : public IStructure {
+public:
+    UnstructuredMesh()
+        : m_curve(SpaceFillingCurve::Curve::HILBERT)
+        , m_nMaxVertices(3)
+        , pio(nullptr)
+    {
+    }
+
+    //! Destructor. The lifetime of pio should be the lifetime of the instance.
+    virtual ~UnstructuredMesh()
+    {
+        if (pio) {
+            delete pio;
+        }
+    }
+
+    const static std::string structureName;
+
+    //! The node index of the unused vertices of elements with fewer than the maximum.
+    static int noNode() { return -1; }
+
+    // Read/write override functions
+    void init(const std::string& filePath) override;
+
+    void dump(const std::string& filePath) const override;
+
+    void dumpSnapshot(const RestartSnapshot& snapshot, const std::string& filePath) const override;
+
+    std::string structureType() const override { return structureName; };
+
+    int nIceLayers() const override { return data.empty() ? 1 : data.front().nIceLayers(); };
+
+    /*!
+     * @brief Replaces the mesh, which applies to the elements of later calls
+     * to init() without a restart file.
+     *
+     * @details The elements are reordered along the curve set by
+     * setOrdering(), and the nodes renumbered in the order of their first use
+     * by the reordered elements. Nodes used by no element follow, in their
+     * original order.
+     *
+     * @param nodeX The x coordinate of each node [m].
+     * @param nodeY The y coordinate of each node [m].
+     * @param elementNodes The nodes of the vertices of each element, in order
+     * around the element, nMaxVertices for each element. Elements with fewer
+     * vertices are completed with noNode().
+     * @param nMaxVertices The maximum number of vertices of an element.
+     * @throws std::invalid_argument if the elements are not polygons of at
+     * least three existing nodes.
+     */
+    void setMesh(const std::vector<double>& nodeX, const std::vector<double>& nodeY,
+        const std::vector<int>& elementNodes, int nMaxVertices);
+
+    /*!
+     * @brief Returns the mesh in the order of the nodes and elements of the
+     * original mesh, in the form taken by setMesh().
+     */
+    void originalMesh(std::vector<double>& nodeX, std::vector<double>& nodeY,
+        std::vector<int>& elementNodes) const;
+
+    //! Sets the curve along which the elements of later meshes are ordered.
+    void setOrdering(SpaceFillingCurve::Curve curve) { m_curve = curve; }
+    //! Returns the curve along which the elements are ordered.
+    SpaceFillingCurve::Curve ordering() const { return m_curve; }
+
+    //! Returns the number of elements of the mesh.
+    std::size_t nElements() const { return m_elementIndex.size(); }
+    //! Returns the number of nodes of the mesh.
+    std::size_t nNodes() const { return m_nodeIndex.size(); }
+    //! Returns the maximum number of vertices of an element.
+    int nMaxVertices() const { return m_nMaxVertices; }
+
+    //! Returns the x coordinate of a node [m].
+    double nodeX(std::size_t node) const { return m_nodeX[node]; }
+    //! Returns the y coordinate of a node [m].
+    double nodeY(std::size_t node) const { return m_nodeY[node]; }
+
+    //! Returns the number of vertices of an element.
+    int nVertices(std::size_t element) const
+    {
+        return m_vertexStart[element + 1] - m_vertexStart[element];
+    }
+    //! Returns the node of a vertex of an element.
+    std::size_t vertex(std::size_t element, int i) const
+    {
+        return m_vertices[m_vertexStart[element] + i];
+    }
+    //! Returns the number of elements which share a side with an element.
+    int nNeighbours(std::size_t element) const
+    {
+        return m_neighbourStart[element + 1] - m_neighbourStart[element];
+    }
+    //! Returns a neighbour of an element, in increasing order of the neighbours.
+    std::size_t neighbour(std::size_t element, int i) const
+    {
+        return m_neighbours[m_neighbourStart[element] + i];
+    }
+    //! Returns the area of an element [m²].
+    double area(std::size_t element) const { return m_area[element]; }
+
+    //! Returns the index of an element in the original mesh.
+    std::size_t elementIndex(std::size_t element) const { return m_elementIndex[element]; }
+    //! Returns the index of a node in the original mesh.
+    std::size_t nodeIndex(std::size_t node) const { return m_nodeIndex[node]; }
+
+    /*!
+     * @brief Copies values from the elements to the elements of the original mesh.
+     *
+     * @param elements The values of the elements, nValues for each element,
+     * with consecutive elements separated by stride.
+     * @param stride The separation of the values of consecutive elements.
+     * @param nValues The number of values of each element.
+     * @param original The values in the original order, indexed by element
+     * then value.
+     */
+    template <typename T>
+    void toOriginalOrder(const T* elements, std::ptrdiff_t stride, int nValues, T* original) const
+    {
+        for (std::size_t element = 0; element < nElements(); ++element) {
+            const std::size_t index = m_elementIndex[element];
+            for (int value = 0; value < nValues; ++value) {
+                original[index * nValues + value] = elements[element * stride + value];
+            }
+        }
+    }
+
+    /*!
+     * @brief Copies values from the elements of the original mesh to the elements.
+     *
+     * @param original The values in the original order, indexed by element
+     * then value.
+     * @param nValues The number of values of each element.
+     * @param elements The values of the elements, nValues for each element,
+     * with consecutive elements separated by stride.
+     * @param stride The separation of the values of consecutive elements.
+     */
+    template <typename T>
+    void fromOriginalOrder(const T* original, int nValues, T* elements, std::ptrdiff_t stride) const
+    {
+        for (std::size_t element = 0; element < nElements(); ++element) {
+            const std::size_t index = m_elementIndex[element];
+            for (int value = 0; value < nValues; ++value) {
+                elements[element * stride + value] = original[index * nValues + value];
+            }
+        }
+    }
+
+    // Cursor manipulation override functions
+    int resetCursor() override;
+    bool validCursor() const override;
+    ElementData& cursorData() override;
+    const ElementData& cursorData() const override;
+    void incrCursor() override;
+
+    double cursorArea() const override { return m_area[iCursor - data.begin()]; }
+    double elementArea(std::size_t element) const override { return m_area[element]; }
+
+    ElementVector* elementStorage() override { return &data; }
+
+    //! Sets the pointer to the class that will perform the IO. Should be an
+    //! instance of UnstructuredMeshIO
+    void setIO(IUnstructuredMeshIO* p) { pio = p; }
+
+private:
+    // Replaces the element data with an element for each element of the mesh
+    void allocate(int nLayers);
+    // Finds the elements which share each side
+    void findNeighbours();
+
+    const static std::string nodeDimName;
+    const static std::string elementDimName;
+    const static std::string vertexDimName;
+    const static std::string nIceLayersName;
+
+    SpaceFillingCurve::Curve m_curve;
+    int m_nMaxVertices;
+    std::vector<double> m_nodeX;
+    std::vector<double> m_nodeY;
+    // The vertices of element i are m_vertices[m_vertexStart[i]] to
+    // m_vertices[m_vertexStart[i + 1] - 1], and similarly for the neighbours
+    std::vector<int> m_vertexStart;
+    std::vector<std::size_t> m_vertices;
+    std::vector<int> m_neighbourStart;
+    std::vector<std::size_t> m_neighbours;
+    std::vector<double> m_area;
+    // The original index of each element and node
+    std::vector<std::size_t> m_elementIndex;
+    std::vector<std::size_t> m_nodeIndex;
+    ElementVector data;
+
+    ElementVector::iterator iCursor;
+
+    IUnstructuredMeshIO* pio;
+
+    friend UnstructuredMeshIO;
+};
+
+} /* namespace Nextsim */
+
+#endif /* CORE_SRC_INCLUDE_UNSTRUCTUREDMESH_HPP */
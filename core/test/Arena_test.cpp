@@ -0,0 +1,177 @@
+/*!
+ * @file Arena_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/Arena.hpp"
+#include "include/ElementData.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Allocations are counted by group", "[Arena]")
+{
+    Arena arena;
+    REQUIRE(arena.group("fields") == Arena::fields);
+    REQUIRE(arena.group("physics") == Arena::physics);
+    REQUIRE(arena.group("scratch") == Arena::scratch);
+    int other = arena.group("other");
+    REQUIRE(other == arena.group("other"));
+
+    void* a = arena.allocate(100, 8, Arena::fields);
+    void* b = arena.allocate(24, 64, Arena::fields);
+    void* c = arena.allocate(40, 8, other);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    REQUIRE(arena.bytes("fields") == 124);
+    REQUIRE(arena.bytes("other") == 40);
+    REQUIRE(arena.bytes("scratch") == 0);
+    REQUIRE(arena.bytes("missing") == 0);
+    auto report = arena.report();
+    REQUIRE(report.size() == 4);
+    REQUIRE(report["fields"] == 124);
+    // One chunk for each group with allocations
+    REQUIRE(arena.reservedBytes() == 2 * Arena::hugePageSize);
+
+    // The most recent allocation is reused
+    arena.deallocate(b, 24, Arena::fields);
+    REQUIRE(arena.bytes("fields") == 100);
+    void* d = arena.allocate(24, 64, Arena::fields);
+    REQUIRE(d == b);
+
+    // Once the whole chunk is free, it is reused from the start
+    arena.deallocate(a, 100, Arena::fields);
+    arena.deallocate(d, 24, Arena::fields);
+    REQUIRE(arena.bytes("fields") == 0);
+    REQUIRE(arena.allocate(8, 8, Arena::fields) == a);
+
+    REQUIRE_THROWS_AS(arena.deallocate(c, 40, Arena::fields), std::invalid_argument);
+    REQUIRE_THROWS_AS(arena.setChunkSize(0), std::invalid_argument);
+}
+
+TEST_CASE("Large allocations and huge pages", "[Arena]")
+{
+    Arena arena;
+    arena.setChunkSize(4096);
+    // An allocation larger than the chunk size has a chunk of its own
+    char* big = static_cast<char*>(arena.allocate(10000, 8, Arena::scratch));
+    big[0] = 1;
+    big[9999] = 1;
+    REQUIRE(arena.reservedBytes() >= 10000);
+    REQUIRE(arena.reservedBytes() < 10000 + 4096);
+    // Too large for the remainder of the first chunk
+    void* next = arena.allocate(4000, 8, Arena::scratch);
+    REQUIRE(arena.bytes("scratch") == 14000);
+    // Empty chunks other than the most recent are returned to the system
+    arena.deallocate(big, 10000, Arena::scratch);
+    REQUIRE(arena.reservedBytes() == 4096);
+    arena.deallocate(next, 4000, Arena::scratch);
+
+    for (auto hugePages : { Arena::HugePages::TRANSPARENT, Arena::HugePages::EXPLICIT }) {
+        Arena hugeArena;
+        hugeArena.setHugePages(hugePages);
+        char* p = static_cast<char*>(hugeArena.allocate(3 * 1024 * 1024, 64, Arena::fields));
+        p[0] = 1;
+        p[3 * 1024 * 1024 - 1] = 1;
+        // Whole huge pages, aligned to the huge page size
+        REQUIRE(hugeArena.reservedBytes() == 2 * Arena::hugePageSize);
+#ifdef __linux__
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % Arena::hugePageSize == 0);
+#endif
+        // Without reserved huge pages, explicit falls back to transparent
+        REQUIRE(hugeArena.hugePages() != Arena::HugePages::NONE);
+    }
+}
+
+TEST_CASE("Reserved memory holds the following allocations", "[Arena]")
+{
+    Arena arena;
+    arena.setChunkSize(4096);
+    arena.allocate(1000, 8, Arena::physics);
+    // Too large for the remainder of the chunk, so a new chunk is started
+    char* reserved = static_cast<char*>(arena.reserve(3 * 2000, 16, Arena::physics));
+    REQUIRE(arena.bytes("physics") == 1000);
+    REQUIRE(arena.reservedBytes() >= 4096 + 6000);
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(arena.allocate(2000, 16, Arena::physics) == reserved + 2000 * i);
+    }
+}
+
+TEST_CASE("Each thread has its own arena", "[Arena]")
+{
+    Arena* mainThreadArena = &Arena::local();
+    REQUIRE(mainThreadArena != &Arena::main);
+    REQUIRE(&Arena::local() == mainThreadArena);
+
+    const std::size_t mainScratch = Arena::main.bytes("scratch");
+    std::vector<Arena*> arenas(4);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < arenas.size(); ++i) {
+        threads.emplace_back([&arenas, i]() {
+            Arena& arena = Arena::local();
+            arenas[i] = &arena;
+            std::vector<double, ArenaAllocator<double>> buffer(
+                1000, 0., ArenaAllocator<double>(arena, Arena::scratch));
+            if (arena.bytes("scratch") != 1000 * sizeof(double)) {
+                arenas[i] = nullptr;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t i = 0; i < arenas.size(); ++i) {
+        REQUIRE(arenas[i] != nullptr);
+        REQUIRE(arenas[i] != mainThreadArena);
+        for (std::size_t j = 0; j < i; ++j) {
+            REQUIRE(arenas[i] != arenas[j]);
+        }
+    }
+    REQUIRE(Arena::main.bytes("scratch") == mainScratch);
+}
+
+TEST_CASE("The deleter holds sizes of 4 GiB and more", "[Arena]")
+{
+    const std::size_t size = std::size_t(5) << 30;
+    Arena::Deleter deleter { &Arena::main, size, Arena::physics };
+    REQUIRE(deleter.size == size);
+}
+
+TEST_CASE("Element data is allocated from the main arena", "[Arena]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    std::size_t fieldBytes = Arena::main.bytes("fields");
+    std::size_t physicsBytes = Arena::main.bytes("physics");
+    const std::size_t nElements = 100;
+    std::size_t instanceSize
+        = ModuleLoader::getLoader().getImplementation<IPhysics1d>().instanceSize();
+    REQUIRE(instanceSize > 0);
+    {
+        ElementVector data;
+        data.reserve(nElements);
+        for (std::size_t i = 0; i < nElements; ++i) {
+            data.emplace_back(1);
+        }
+        REQUIRE(Arena::main.bytes("fields") == fieldBytes + nElements * sizeof(ElementData));
+        REQUIRE(Arena::main.bytes("physics") == physicsBytes + nElements * instanceSize);
+
+        // Copies have their own physics implementation instances
+        ElementData copy(data[0]);
+        REQUIRE(copy.physicsColumn().impl != data[0].physicsColumn().impl);
+        REQUIRE(Arena::main.bytes("physics") == physicsBytes + (nElements + 1) * instanceSize);
+    }
+    // Everything is returned when the elements are destroyed
+    REQUIRE(Arena::main.bytes("fields") == fieldBytes);
+    REQUIRE(Arena::main.bytes("physics") == physicsBytes);
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,86 @@
+/*!
+ * @file BitRounding_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/BitRounding.hpp"
+#include "include/ThreadTeam.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Rounding single values", "[BitRounding]")
+{
+    // 1 + 2^-52 is unchanged by keeping all the bits
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    REQUIRE(BitRounding::round(1. + epsilon, 52) == 1. + epsilon);
+    REQUIRE(BitRounding::round(1. + epsilon, 51) == 1.);
+
+    // 1.75 is 1.11 in binary. Keeping one bit is a tie, rounded to even.
+    REQUIRE(BitRounding::round(1.75, 2) == 1.75);
+    REQUIRE(BitRounding::round(1.75, 1) == 2.);
+    REQUIRE(BitRounding::round(1.25, 1) == 1.);
+    REQUIRE(BitRounding::round(-1.75, 1) == -2.);
+    REQUIRE(BitRounding::round(1.3, 0) == 1.);
+    REQUIRE(BitRounding::round(1.6, 0) == 2.);
+
+    // The relative error is at most 2^-(bits + 1)
+    for (int bits : { 3, 10, 23 }) {
+        for (double value : { 0.1, -273.15, 1.2345e-7, 6.02e23 }) {
+            double rounded = BitRounding::round(value, bits);
+            REQUIRE(std::fabs(rounded - value) <= std::ldexp(std::fabs(value), -bits - 1));
+            // Rounding again changes nothing
+            REQUIRE(BitRounding::round(rounded, bits) == rounded);
+        }
+    }
+
+    REQUIRE(BitRounding::round(0., 5) == 0.);
+    const double inf = std::numeric_limits<double>::infinity();
+    REQUIRE(BitRounding::round(inf, 5) == inf);
+    REQUIRE(std::isnan(BitRounding::round(std::numeric_limits<double>::quiet_NaN(), 5)));
+}
+
+TEST_CASE("Rounding variables", "[BitRounding]")
+{
+    REQUIRE_THROWS_AS(BitRounding(53), std::invalid_argument);
+    BitRounding lossless;
+    REQUIRE(lossless.isLossless());
+    REQUIRE(lossless.keepBits("hice") == BitRounding::allBits);
+
+    BitRounding rounding(10);
+    rounding.setKeepBits("tice", 3);
+    REQUIRE_THROWS_AS(rounding.setKeepBits("hice", -1), std::invalid_argument);
+    REQUIRE(!rounding.isLossless());
+    REQUIRE(rounding.keepBits("hice") == 10);
+    REQUIRE(rounding.keepBits("tice") == 3);
+
+    std::vector<double> values(1001);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = 0.001 * i + 1.;
+    }
+    std::vector<double> serial = values;
+    for (double& value : serial) {
+        value = BitRounding::round(value, 3);
+    }
+
+    // Divided between threads, with the same result
+    ThreadTeam::main.setThreads(3);
+    rounding.round("tice", values.data(), values.size());
+    ThreadTeam::main.setThreads(1);
+    REQUIRE(values == serial);
+
+    std::vector<double> unchanged = { 0.1, 0.2 };
+    lossless.round("hice", unchanged.data(), unchanged.size());
+    REQUIRE(unchanged[0] == 0.1);
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,177 @@
+/*!
+ * @file Coarsening_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/Coarsening.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/ThreadTeam.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+static const int nx = 5;
+static const int ny = 4;
+
+// A grid of nx × ny elements, with the x index varying slowest
+static ElementVector makeGrid(int xStart, int nxLocal)
+{
+    ElementVector data(nxLocal * ny, ElementData(2));
+    for (int x = 0; x < nxLocal; ++x) {
+        for (int y = 0; y < ny; ++y) {
+            int gx = xStart + x;
+            data[x * ny + y] = PrognosticGenerator()
+                                   .hice(10. * gx + y)
+                                   .cice(0.5)
+                                   .hsnow(0.)
+                                   .sst(-1.)
+                                   .sss(32.)
+                                   .tice({ -1. * gx, -1. * y });
+        }
+    }
+    return data;
+}
+
+static const Coarsening::Field& findField(const Coarsening& coarsening, const std::string& name)
+{
+    for (auto& field : coarsening.fields()) {
+        if (field.description->name == name)
+            return field;
+    }
+    throw std::out_of_range("No coarsened field " + name);
+}
+
+TEST_CASE("Block means and subsamples", "[Coarsening]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    REQUIRE_THROWS_AS(Coarsening(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(Coarsening::methodFromString("median"), std::invalid_argument);
+    REQUIRE(Coarsening::methodFromString("subsample") == Coarsening::Method::SUBSAMPLE);
+
+    ElementVector data = makeGrid(0, nx);
+    Coarsening mean(2, Coarsening::Method::MEAN);
+    mean.coarsen(data, 0, nx, nx, ny);
+    REQUIRE(mean.nx() == 3);
+    REQUIRE(mean.ny() == 2);
+    REQUIRE(mean.nxLocal() == 3);
+    REQUIRE(mean.xStart() == 0);
+
+    // No external data is coarsened
+    REQUIRE_THROWS_AS(findField(mean, "tair"), std::out_of_range);
+
+    const Coarsening::Field& hice = findField(mean, "hice");
+    REQUIRE(hice.nLayers == 1);
+    REQUIRE(hice.values.size() == 6);
+    // The block of x 0-1, y 2-3
+    REQUIRE(hice.values[1] == 7.5);
+    // The partial block of x 4, y 0-1
+    REQUIRE(hice.values[4] == 40.5);
+    REQUIRE(hice.values[5] == 42.5);
+
+    const Coarsening::Field& tice = findField(mean, "tice");
+    REQUIRE(tice.nLayers == 2);
+    // Indexed by coarse x, coarse y, then layer
+    REQUIRE(tice.values[(1 * 2 + 1) * 2 + 0] == -2.5);
+    REQUIRE(tice.values[(1 * 2 + 1) * 2 + 1] == -2.5);
+    REQUIRE(tice.values[(2 * 2 + 0) * 2 + 0] == -4.);
+
+    Coarsening subsample(2, Coarsening::Method::SUBSAMPLE);
+    subsample.coarsen(data, 0, nx, nx, ny);
+    const Coarsening::Field& hiceSub = findField(subsample, "hice");
+    REQUIRE(hiceSub.values[1] == 2.);
+    REQUIRE(hiceSub.values[4] == 40.);
+    REQUIRE(hiceSub.values[5] == 42.);
+
+    // A factor of one copies the fields
+    Coarsening identity;
+    identity.coarsen(data, 0, nx, nx, ny);
+    REQUIRE(findField(identity, "hice").values[3 * ny + 2] == 32.);
+}
+
+TEST_CASE("Coarsening on several threads", "[Coarsening]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ElementVector data = makeGrid(0, nx);
+    Coarsening single(2);
+    single.coarsen(data, 0, nx, nx, ny);
+
+    ThreadTeam::main.setThreads(3);
+    Coarsening threaded(2);
+    threaded.coarsen(data, 0, nx, nx, ny);
+    ThreadTeam::main.setThreads(1);
+
+    for (std::size_t i = 0; i < single.fields().size(); ++i) {
+        REQUIRE(threaded.fields()[i].values == single.fields()[i].values);
+    }
+}
+
+TEST_CASE("Coarsening the rows held by a process", "[Coarsening]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    Coarsening coarsening(2);
+
+    // Rows 2-4 of the grid, ending at the edge of the grid
+    ElementVector data = makeGrid(2, 3);
+    coarsening.coarsen(data, 2, 3, nx, ny);
+    REQUIRE(coarsening.xStart() == 1);
+    REQUIRE(coarsening.nxLocal() == 2);
+    REQUIRE(coarsening.nx() == 3);
+    REQUIRE(findField(coarsening, "hice").values[2] == 40.5);
+
+    // Blocks divided between processes
+    ElementVector offset = makeGrid(1, 2);
+    REQUIRE_THROWS_AS(coarsening.coarsen(offset, 1, 2, nx, ny), std::invalid_argument);
+    ElementVector partial = makeGrid(0, 3);
+    REQUIRE_THROWS_AS(coarsening.coarsen(partial, 0, 3, nx, ny), std::invalid_argument);
+}
+
+TEST_CASE("Coarsening a grid with land", "[Coarsening]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    // Land in the first cell, and in all of the block of rows 2-3 and columns 2-3
+    std::vector<int> ocean(nx * ny, 1);
+    ocean[0] = 0;
+    for (int x = 2; x < 4; ++x) {
+        for (int y = 2; y < 4; ++y) {
+            ocean[x * ny + y] = 0;
+        }
+    }
+    LandMask mask(nx, ny, ocean);
+
+    // The elements of the ocean cells only
+    ElementVector full = makeGrid(0, nx);
+    ElementVector data;
+    for (std::size_t i = 0; i < mask.nOcean(); ++i) {
+        data.push_back(full[mask.cell(i)]);
+    }
+
+    Coarsening mean(2, Coarsening::Method::MEAN);
+    mean.coarsen(data, 0, nx, nx, ny, &mask);
+    const std::vector<double>& hice = findField(mean, "hice").values;
+    // The mean of the ocean cells 1, 10 and 11
+    REQUIRE(hice[0] == Approx(22. / 3));
+    REQUIRE(hice[1] == 7.5);
+    REQUIRE(hice[2] == 25.5);
+    REQUIRE(hice[3] == LandMask::fillValue());
+
+    Coarsening subsample(2, Coarsening::Method::SUBSAMPLE);
+    subsample.coarsen(data, 0, nx, nx, ny, &mask);
+    REQUIRE(findField(subsample, "hice").values[0] == LandMask::fillValue());
+    REQUIRE(findField(subsample, "hice").values[1] == 2.);
+
+    // The fill value is unchanged by rounding
+    BitRounding rounding(0);
+    mean.round(rounding);
+    REQUIRE(findField(mean, "hice").values[3] == LandMask::fillValue());
+
+    REQUIRE_THROWS_AS(mean.coarsen(data, 0, nx - 1, nx, ny, &mask), std::invalid_argument);
+}
+
+} /* namespace Nextsim */
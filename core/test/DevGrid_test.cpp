@@ -16,8 +16,10 @@
 
 #include <cstdio>
 #include <fstream>
+#include <vector>
 
 const std::string filename = "DevGrid_test.nc";
+const std::string maskedFilename = "DevGrid_land_test.nc";
 
 namespace Nextsim {
 
@@ -101,4 +103,55 @@ TEST_CASE("Write out a DevGrid restart file", "[DevGrid]")
 
     std::remove(filename.c_str());
 }
+TEST_CASE("Write and read a DevGrid restart file with land", "[DevGrid]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    // Land in the first three rows and in the last column
+    int nx = DevGrid::nx;
+    std::vector<int> ocean(nx * nx, 1);
+    for (int i = 0; i < nx; ++i) {
+        for (int j = 0; j < nx; ++j) {
+            if (i < 3 || j == nx - 1)
+                ocean[i * nx + j] = 0;
+        }
+    }
+
+    DevGrid grid;
+    grid.setLandMask(LandMask(nx, nx, ocean));
+    grid.init("");
+    grid.setIO(new DevGridIO(grid));
+    const LandMask& mask = grid.landMask();
+    REQUIRE(mask.nOcean() == std::size_t(7 * (nx - 1)));
+
+    // Only the ocean cells have elements
+    std::size_t nElements = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor = PrognosticGenerator()
+                           .hice(1 + 0.01 * mask.cell(nElements))
+                           .cice(0.5)
+                           .sst(-1.)
+                           .sss(32.)
+                           .hsnow(0.)
+                           .tice({ -1. });
+        ++nElements;
+    }
+    REQUIRE(nElements == mask.nOcean());
+
+    grid.dump(maskedFilename);
+
+    DevGrid grid2;
+    grid2.setIO(new DevGridIO(grid2));
+    grid2.init(maskedFilename);
+    REQUIRE(grid2.landMask().values() == ocean);
+
+    nElements = 0;
+    for (grid2.cursor = 0; grid2.cursor; ++grid2.cursor) {
+        REQUIRE(grid2.cursor->iceThickness() == 1 + 0.01 * mask.cell(nElements));
+        ++nElements;
+    }
+    REQUIRE(nElements == mask.nOcean());
+
+    std::remove(maskedFilename.c_str());
+}
 }
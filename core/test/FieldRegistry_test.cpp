@@ -0,0 +1,99 @@
+/*!
+ * @file FieldRegistry_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/FieldRegistry.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace Nextsim {
+
+TEST_CASE("Registered fields", "[FieldRegistry]")
+{
+    const FieldRegistry::Field& hice = FieldRegistry::field("hice");
+    REQUIRE(hice.units == "m");
+    REQUIRE(hice.group == FieldRegistry::Group::PROGNOSTIC);
+    REQUIRE(hice.dimensions == FieldRegistry::Dimensions::HORIZONTAL);
+    REQUIRE(FieldRegistry::field("tice").dimensions == FieldRegistry::Dimensions::LAYERED);
+    REQUIRE(FieldRegistry::field("tair").group == FieldRegistry::Group::EXTERNAL);
+
+    REQUIRE_THROWS_AS(FieldRegistry::field("not a field"), std::out_of_range);
+    REQUIRE_THROWS_AS(FieldRegistry::add(hice), std::invalid_argument);
+}
+
+TEST_CASE("Views refer to the element storage", "[FieldRegistry]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    const int nLayers = 3;
+    const int nElements = 5;
+    ElementVector data(nElements, ElementData(nLayers));
+    for (int i = 0; i < nElements; ++i) {
+        data[i] = PrognosticGenerator().hice(0.1 * i).cice(0.5).hsnow(0.).sst(-1.).sss(32.).tice(
+            { -1. * i, -2. * i, -3. * i });
+        data[i].setAirTemperature(10. + i);
+    }
+
+    FieldView<const double> hice = FieldRegistry::view(data, "hice");
+    REQUIRE(hice.size() == nElements);
+    REQUIRE(hice.nLayers() == 1);
+    for (int i = 0; i < nElements; ++i) {
+        REQUIRE(&hice[i] == &data[i].iceThickness());
+    }
+
+    FieldView<const double> tice = FieldRegistry::view(data, "tice");
+    REQUIRE(tice.nLayers() == nLayers);
+    REQUIRE(tice(3, 0) == -3.);
+    REQUIRE(tice(3, 2) == -9.);
+    REQUIRE(&tice(4, 1) == &data[4].iceTemperature(1));
+
+    FieldView<const double> tair = FieldRegistry::view(data, "tair");
+    REQUIRE(tair[2] == 12.);
+
+    // Writing through a view changes the data and updates the external data versions
+    unsigned long version = data[1].version();
+    FieldView<double> tairOut = FieldRegistry::mutableView(data, "tair");
+    tairOut[1] = -5.;
+    REQUIRE(data[1].airTemperature() == -5.);
+    REQUIRE(data[1].version() != version);
+
+    FieldView<double> sst = FieldRegistry::mutableView(data, "sst");
+    sst[0] = 2.;
+    REQUIRE(data[0].seaSurfaceTemperature() == 2.);
+}
+
+TEST_CASE("Additional fields", "[FieldRegistry]")
+{
+    FieldRegistry::Field qia = { "qia", "W m-2", FieldRegistry::Dimensions::HORIZONTAL,
+        FieldRegistry::Group::DIAGNOSTIC,
+        [](const ElementData& e) { return &e.snowThickness(); } };
+    size_t nFields = FieldRegistry::fields().size();
+    const FieldRegistry::Field* hice = &FieldRegistry::field("hice");
+    FieldRegistry::add(qia);
+    REQUIRE(FieldRegistry::fields().size() == nFields + 1);
+    REQUIRE(FieldRegistry::field("qia").group == FieldRegistry::Group::DIAGNOSTIC);
+
+    // Adding fields leaves the existing descriptions in place
+    for (int i = 0; i < 100; ++i) {
+        qia.name = "qia" + std::to_string(i);
+        FieldRegistry::add(qia);
+    }
+    REQUIRE(&FieldRegistry::field("hice") == hice);
+    REQUIRE(hice->name == "hice");
+
+    // Once frozen, as by the configuration of a model, no fields can be added
+    FieldRegistry::freeze();
+    qia.name = "qia_frozen";
+    REQUIRE_THROWS_AS(FieldRegistry::add(qia), std::logic_error);
+    REQUIRE(FieldRegistry::fields().size() == nFields + 101);
+}
+
+} /* namespace Nextsim */
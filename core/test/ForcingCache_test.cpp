@@ -0,0 +1,217 @@
+/*!
+ * @file ForcingCache_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/DevGrid.hpp"
+#include "include/ForcingCache.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Nextsim {
+
+// A source name unique to this process
+static std::string sourceName(const std::string& test)
+{
+    return "/data/forcing/" + test + "_" + std::to_string(getpid()) + ".nc";
+}
+
+// Fills a record with values identifying the record, field and element
+static void decodeTest(int index, double* fields, std::size_t nElements)
+{
+    for (int field = 0; field < SharedMemoryCoupler::N_FORCING; ++field) {
+        for (std::size_t i = 0; i < nElements; ++i) {
+            fields[field * nElements + i] = 1000 * index + 100 * field + i;
+        }
+    }
+}
+
+static bool segmentExists(const std::string& name)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return false;
+    close(fd);
+    return true;
+}
+
+TEST_CASE("Records are decoded once and shared", "[ForcingCache]")
+{
+    const std::string source = sourceName("shared");
+    const std::size_t n = 7;
+    int decodes = 0;
+    auto counting = [&decodes](int index, double* fields, std::size_t nElements) {
+        ++decodes;
+        decodeTest(index, fields, nElements);
+    };
+    // Two caches of the same source, as in two model processes
+    ForcingCache first(source, n, counting);
+    ForcingCache second(source, n, counting);
+    REQUIRE(first.segmentName(3) == second.segmentName(3));
+    REQUIRE(first.segmentName(3) != first.segmentName(4));
+
+    {
+        auto a = first.record(3);
+        auto b = second.record(3);
+        REQUIRE(decodes == 1);
+        REQUIRE(a->decodedHere());
+        REQUIRE(!b->decodedHere());
+        REQUIRE(b->index() == 3);
+        for (int field = 0; field < SharedMemoryCoupler::N_FORCING; ++field) {
+            auto forcing = SharedMemoryCoupler::Forcing(field);
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(b->field(forcing)[i] == 3000 + 100 * field + i);
+            }
+        }
+        // Another record is decoded separately
+        auto c = second.record(4);
+        REQUIRE(decodes == 2);
+        REQUIRE(c->field(SharedMemoryCoupler::AIR_TEMPERATURE)[0] == 4000);
+
+        REQUIRE(segmentExists(first.segmentName(3)));
+        a.reset();
+        REQUIRE(segmentExists(first.segmentName(3)));
+    }
+    // The segments are removed with the last user
+    REQUIRE(!segmentExists(first.segmentName(3)));
+    REQUIRE(!segmentExists(first.segmentName(4)));
+    REQUIRE(second.record(3)->decodedHere());
+    REQUIRE(decodes == 3);
+}
+
+TEST_CASE("Other processes map the record read-only", "[ForcingCache]")
+{
+    const std::string source = sourceName("process");
+    const std::size_t n = 100;
+    ForcingCache cache(source, n, decodeTest);
+    auto record = cache.record(0);
+
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        // Decoding again would be a failure of the cache
+        ForcingCache childCache(source, n, [](int, double*, std::size_t) { _exit(2); });
+        bool correct = true;
+        {
+            auto shared = childCache.record(0);
+            correct = !shared->decodedHere();
+            for (std::size_t i = 0; i < n; ++i) {
+                correct = correct && shared->field(SharedMemoryCoupler::SNOWFALL)[i] == 700 + i;
+            }
+            // Writing to the record must fault
+            pid_t writer = fork();
+            if (writer == 0) {
+                const_cast<double*>(shared->field(SharedMemoryCoupler::SNOWFALL))[0] = 0;
+                _exit(0);
+            }
+            int status = 0;
+            waitpid(writer, &status, 0);
+            correct = correct && WIFSIGNALED(status);
+        }
+        _exit(correct ? 0 : 1);
+    }
+    int status = -1;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    // The record is unchanged, and still held by this process
+    REQUIRE(record->field(SharedMemoryCoupler::SNOWFALL)[0] == 700);
+    REQUIRE(segmentExists(cache.segmentName(0)));
+    record.reset();
+    REQUIRE(!segmentExists(cache.segmentName(0)));
+}
+
+TEST_CASE("Failures and mismatches", "[ForcingCache]")
+{
+    const std::string source = sourceName("failures");
+    REQUIRE_THROWS_AS(ForcingCache(source, 0, decodeTest), std::invalid_argument);
+
+    // A failed decoding leaves no record behind
+    ForcingCache failing(
+        source, 10, [](int, double*, std::size_t) { throw std::runtime_error("bad file"); });
+    REQUIRE_THROWS_AS(failing.record(0), std::runtime_error);
+    REQUIRE(!segmentExists(failing.segmentName(0)));
+
+    ForcingCache cache(source, 10, decodeTest);
+    auto record = cache.record(0);
+    REQUIRE(record->decodedHere());
+    ForcingCache otherSize(source, 11, decodeTest);
+    REQUIRE_THROWS_AS(otherSize.record(0), std::runtime_error);
+
+    // Applying to a structure with a different number of elements
+    ModuleLoader::getLoader().setAllDefaults();
+    DevGrid grid;
+    grid.init("");
+    REQUIRE_THROWS_AS(record->apply(grid), std::runtime_error);
+}
+
+TEST_CASE("Stale records and changed sources", "[ForcingCache]")
+{
+    const std::string source = sourceName("stale");
+    const std::size_t n = 5;
+
+    // A process which dies while decoding leaves its record behind
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        ForcingCache childCache(source, n, [](int, double*, std::size_t) { _exit(3); });
+        childCache.record(0);
+        _exit(0);
+    }
+    int status = -1;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WEXITSTATUS(status) == 3);
+    ForcingCache cache(source, n, decodeTest);
+    REQUIRE(segmentExists(cache.segmentName(0)));
+    {
+        auto record = cache.record(0);
+        REQUIRE(record->decodedHere());
+        REQUIRE(record->field(SharedMemoryCoupler::SNOWFALL)[n - 1] == 700 + n - 1);
+    }
+    REQUIRE(!segmentExists(cache.segmentName(0)));
+
+    // A source file which changes has different records
+    const std::string fileName = "ForcingCache_test_" + std::to_string(getpid()) + ".nc";
+    std::ofstream(fileName) << "first";
+    ForcingCache before(fileName, n, decodeTest);
+    std::ofstream(fileName) << "second version";
+    ForcingCache after(fileName, n, decodeTest);
+    REQUIRE(before.segmentName(0) != after.segmentName(0));
+    std::remove(fileName.c_str());
+}
+
+TEST_CASE("Records are applied to the external data", "[ForcingCache]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    DevGrid grid;
+    grid.init("");
+    const std::size_t nElements = DevGrid::nx * DevGrid::nx;
+
+    ForcingCache cache(sourceName("apply"), nElements, decodeTest);
+    auto record = cache.record(2);
+    record->apply(grid);
+    std::size_t i = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor, ++i) {
+        const ElementData& data = *grid.cursor;
+        REQUIRE(data.airTemperature() == 2000 + i);
+        REQUIRE(data.dewPoint2m() == 2100 + i);
+        REQUIRE(data.mixedLayerDepth() == 2600 + i);
+        REQUIRE(data.snowfall() == 2700 + i);
+    }
+}
+
+} /* namespace Nextsim */
@@ -64,4 +64,31 @@ TEST_CASE("Count iterator testing", "[Iterator]")
     REQUIRE(cant.stopCount == 1);
 }
 
+TEST_CASE("Stepping through a run", "[Iterator]")
+{
+    Counterant cant = Counterant();
+    Iterator iterator = Iterator(&cant);
+
+    Iterator::Duration dt = 2;
+    iterator.setStartStopStep(10, 20, dt);
+    iterator.start();
+    REQUIRE(cant.startCount == 1);
+    REQUIRE(iterator.currentTime() == 10);
+
+    REQUIRE(iterator.step(1) == 1);
+    REQUIRE(cant.count == 1);
+    REQUIRE(iterator.currentTime() == 12);
+    REQUIRE(iterator.step(3) == 3);
+    REQUIRE(iterator.currentTime() == 18);
+    REQUIRE(!iterator.finished());
+    // Only one timestep remains before the stop time
+    REQUIRE(iterator.step(3) == 1);
+    REQUIRE(iterator.finished());
+    REQUIRE(iterator.step(1) == 0);
+    REQUIRE(cant.count == 5);
+
+    iterator.stop();
+    REQUIRE(cant.stopCount == 1);
+}
+
 } /* namespace Nextsim */
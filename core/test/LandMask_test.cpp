@@ -0,0 +1,94 @@
+/*!
+ * @file LandMask_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/FieldRegistry.hpp"
+#include "include/LandMask.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+// Three rows of four cells, with the middle row entirely land
+static const int nx = 3;
+static const int ny = 4;
+static const std::vector<int> ocean = { 1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 1 };
+
+TEST_CASE("Elements of the ocean cells", "[LandMask]")
+{
+    LandMask mask(nx, ny, ocean);
+    REQUIRE(mask.nCells() == nx * ny);
+    REQUIRE(mask.nOcean() == 6);
+    REQUIRE(!mask.allOcean());
+    REQUIRE(mask.values() == ocean);
+
+    // The elements are in the order of their cells
+    const std::vector<std::size_t> cells = { 0, 2, 3, 8, 9, 11 };
+    for (std::size_t element = 0; element < cells.size(); ++element) {
+        REQUIRE(mask.cell(element) == cells[element]);
+        REQUIRE(mask.isOcean(cells[element]));
+        REQUIRE(mask.element(cells[element]) == element);
+    }
+    REQUIRE(!mask.isOcean(1));
+    REQUIRE(!mask.isOcean(5));
+
+    // Without land, the elements and cells coincide
+    LandMask allOcean(nx, ny);
+    REQUIRE(allOcean.allOcean());
+    REQUIRE(allOcean.nOcean() == nx * ny);
+    REQUIRE(allOcean.element(7) == 7);
+    REQUIRE(allOcean.values() == std::vector<int>(nx * ny, 1));
+
+    REQUIRE_THROWS_AS(LandMask(nx + 1, ny, ocean), std::invalid_argument);
+}
+
+TEST_CASE("Gathering and scattering values", "[LandMask]")
+{
+    LandMask mask(nx, ny, ocean);
+    const int nValues = 2;
+    std::vector<double> cells(mask.nCells() * nValues);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        cells[i] = i;
+    }
+
+    // Contiguous values of the elements
+    std::vector<double> elements(mask.nOcean() * nValues);
+    mask.gather(cells.data(), nValues, elements.data(), nValues);
+    for (std::size_t element = 0; element < mask.nOcean(); ++element) {
+        for (int value = 0; value < nValues; ++value) {
+            REQUIRE(elements[element * nValues + value] == mask.cell(element) * nValues + value);
+        }
+    }
+    const double fill = LandMask::fillValue();
+    std::vector<double> scattered(cells.size());
+    mask.scatter(elements.data(), nValues, nValues, scattered.data(), fill);
+    for (std::size_t cell = 0; cell < mask.nCells(); ++cell) {
+        for (int value = 0; value < nValues; ++value) {
+            double expected = mask.isOcean(cell) ? cells[cell * nValues + value] : fill;
+            REQUIRE(scattered[cell * nValues + value] == expected);
+        }
+    }
+
+    // A layered field of the element data
+    ModuleLoader::getLoader().setAllDefaults();
+    ElementVector data(mask.nOcean(), ElementData(nValues));
+    mask.gather(cells.data(), nValues, FieldRegistry::mutableView(data, "tice").data(),
+        FieldView<double>::elementStride);
+    for (std::size_t element = 0; element < mask.nOcean(); ++element) {
+        REQUIRE(data[element].iceTemperature(1) == mask.cell(element) * nValues + 1);
+    }
+    std::vector<double> field(cells.size());
+    mask.scatter(FieldRegistry::view(data, "tice").data(), FieldView<const double>::elementStride,
+        nValues, field.data(), fill);
+    REQUIRE(field == scattered);
+}
+
+} /* namespace Nextsim */
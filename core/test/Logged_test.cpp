@@ -6,6 +6,132 @@
 
 #include "Logged.hpp"
 
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace Nextsim {
-// TODO: write tests when there is something in the class to test.
+
+static const std::string logFile = "Logged_test.log";
+
+// Reads the lines of the log file
+static std::vector<std::string> readLog()
+{
+    std::vector<std::string> lines;
+    std::ifstream is(logFile);
+    std::string line;
+    while (std::getline(is, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+TEST_CASE("Level names", "[Logged]")
+{
+    REQUIRE(Logged::levelFromString("debug") == Logged::DEBUG);
+    REQUIRE(Logged::levelFromString("Warning") == Logged::WARNING);
+    REQUIRE(Logged::levelFromString("EMERGENCY") == Logged::EMERGENCY);
+    REQUIRE_THROWS_AS(Logged::levelFromString("verbose"), std::invalid_argument);
+    REQUIRE(Logged::levelName(Logged::NOTICE) == "NOTICE");
+}
+
+TEST_CASE("Messages are filtered by level", "[Logged]")
+{
+    std::remove(logFile.c_str());
+    Logged::setOutputFile(logFile);
+    Logged::setMinimumLevel(Logged::NOTICE);
+    REQUIRE(!Logged::isEnabled(Logged::INFO));
+    REQUIRE(Logged::isEnabled(Logged::WARNING));
+
+    Logged::setModelTime(3600);
+    Logged::debug("debug message");
+    Logged::info("info message");
+    Logged::notice("notice message");
+    Logged::log("alert message", Logged::ALERT);
+    Logged::flush();
+
+    std::vector<std::string> lines = readLog();
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines[0].find("[model 3600] NOTICE: notice message") != std::string::npos);
+    REQUIRE(lines[1].find("ALERT: alert message") != std::string::npos);
+
+    Logged::setOutputFile("");
+    std::remove(logFile.c_str());
+}
+
+TEST_CASE("Messages from several threads", "[Logged]")
+{
+    std::remove(logFile.c_str());
+    Logged::setOutputFile(logFile);
+    Logged::setMinimumLevel(Logged::DEBUG);
+
+    const int nThreads = 4;
+    const int nMessages = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < nMessages; ++i) {
+                Logged::debug("thread " + std::to_string(t) + " message " + std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logged::flush();
+
+    std::vector<std::string> lines = readLog();
+    REQUIRE(lines.size() == nThreads * nMessages);
+    // The messages of each thread remain in order
+    int lastMessage = -1;
+    for (auto& line : lines) {
+        if (line.find("thread 2 message ") != std::string::npos) {
+            int message = std::stoi(line.substr(line.rfind(' ') + 1));
+            REQUIRE(message == lastMessage + 1);
+            lastMessage = message;
+        }
+    }
+    REQUIRE(lastMessage == nMessages - 1);
+
+    Logged::setOutputFile("");
+    Logged::setMinimumLevel(Logged::INFO);
+    std::remove(logFile.c_str());
+}
+
+TEST_CASE("Each thread stamps its own model time", "[Logged]")
+{
+    std::remove(logFile.c_str());
+    Logged::setOutputFile(logFile);
+
+    Logged::setModelTime(3600);
+    std::thread other([]() {
+        REQUIRE(Logged::modelTime() != 3600);
+        Logged::setModelTime(7200);
+        Logged::info("other thread");
+    });
+    other.join();
+    Logged::info("this thread");
+    REQUIRE(Logged::modelTime() == 3600);
+    Logged::flush();
+
+    std::vector<std::string> lines = readLog();
+    REQUIRE(lines.size() == 2);
+    for (auto& line : lines) {
+        if (line.find("other thread") != std::string::npos) {
+            REQUIRE(line.find("[model 7200]") != std::string::npos);
+        } else {
+            REQUIRE(line.find("[model 3600]") != std::string::npos);
+        }
+    }
+
+    Logged::setOutputFile("");
+    std::remove(logFile.c_str());
+}
+
 } /* namespace Nextsim */
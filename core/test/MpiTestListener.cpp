@@ -0,0 +1,46 @@
+/*!
+ * @file MpiTestListener.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_EXTERNAL_INTERFACES
+#include <catch2/catch.hpp>
+
+#include <mpi.h>
+#include <unistd.h>
+
+namespace Nextsim {
+
+/*
+ * Initializes MPI for the duration of the test run, for the tests of code
+ * which calls MPI when built with USE_MPI. The tests are then run by mpirun,
+ * for example mpirun -n 1 ./testDevGrid.
+ */
+class MpiTestListener : public Catch::TestEventListenerBase {
+public:
+    using Catch::TestEventListenerBase::TestEventListenerBase;
+
+    void testRunStarting(const Catch::TestRunInfo& testRunInfo) override
+    {
+        Catch::TestEventListenerBase::testRunStarting(testRunInfo);
+        MPI_Init(nullptr, nullptr);
+        m_mpiProcess = getpid();
+    }
+    void testRunEnded(const Catch::TestRunStats& testRunStats) override
+    {
+        Catch::TestEventListenerBase::testRunEnded(testRunStats);
+        // A process forked by a test also ends the run if it is killed by a
+        // signal, but MPI belongs to its parent
+        if (getpid() == m_mpiProcess)
+            MPI_Finalize();
+    }
+
+private:
+    pid_t m_mpiProcess = 0;
+};
+
+CATCH_REGISTER_LISTENER(MpiTestListener)
+
+} /* namespace Nextsim */
@@ -0,0 +1,107 @@
+/*!
+ * @file ParallelDevGridIO_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/DevGrid.hpp"
+#include "include/DevGridIO.hpp"
+#include "include/ElementData.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <cstdio>
+#include <mpi.h>
+
+// MPI is initialized by MpiTestListener
+const std::string filename = "ParallelDevGrid_test.nc";
+
+namespace Nextsim {
+
+// A value unique to each element and layer of the whole grid
+static double testValue(int x, int y, int layer = 0) { return x + 0.01 * y + 0.0001 * layer; }
+
+TEST_CASE("Decomposition covers the grid", "[DevGrid]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    int nxTotal;
+    int nxLocal = grid.nxLocal();
+    MPI_Allreduce(&nxLocal, &nxTotal, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    REQUIRE(nxTotal == DevGrid::nx);
+
+    // Each rank's rows follow on from the previous rank's
+    int rank;
+    int nRanks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+    int xEnd = grid.xStart() + grid.nxLocal();
+    int previousEnd = 0;
+    MPI_Status status;
+    if (rank > 0)
+        MPI_Recv(&previousEnd, 1, MPI_INT, rank - 1, 0, MPI_COMM_WORLD, &status);
+    if (rank < nRanks - 1)
+        MPI_Send(&xEnd, 1, MPI_INT, rank + 1, 0, MPI_COMM_WORLD);
+    REQUIRE(grid.xStart() == previousEnd);
+}
+
+TEST_CASE("Parallel restart round trip", "[DevGrid]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    grid.setIO(new DevGridIO(grid));
+
+    const int nLayers = 3;
+    grid.resetCursor();
+    for (int i = 0; i < grid.nxLocal(); ++i) {
+        for (int j = 0; j < DevGrid::nx; ++j) {
+            int x = grid.xStart() + i;
+            grid.cursorData() = PrognosticGenerator()
+                                    .hice(1 + testValue(x, j))
+                                    .cice(testValue(x, j) / DevGrid::nx)
+                                    .hsnow(testValue(x, j) / 100)
+                                    .sst(-testValue(x, j))
+                                    .sss(30 + testValue(x, j))
+                                    .tice({ -testValue(x, j, 0), -testValue(x, j, 1),
+                                        -testValue(x, j, 2) });
+            grid.incrCursor();
+        }
+    }
+    REQUIRE(!grid.validCursor());
+
+    grid.dump(filename);
+
+    DevGrid grid2;
+    grid2.init("");
+    grid2.setIO(new DevGridIO(grid2));
+    grid2.init(filename);
+
+    REQUIRE(grid2.nxLocal() == grid.nxLocal());
+    grid2.resetCursor();
+    for (int i = 0; i < grid2.nxLocal(); ++i) {
+        for (int j = 0; j < DevGrid::nx; ++j) {
+            int x = grid2.xStart() + i;
+            const ElementData& elem = grid2.cursorData();
+            REQUIRE(elem.nIceLayers() == nLayers);
+            REQUIRE(elem.iceThickness() == 1 + testValue(x, j));
+            REQUIRE(elem.seaSurfaceSalinity() == 30 + testValue(x, j));
+            REQUIRE(elem.iceTemperature(2) == -testValue(x, j, 2));
+            grid2.incrCursor();
+        }
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    if (rank == 0)
+        std::remove(filename.c_str());
+}
+
+} /* namespace Nextsim */
@@ -7,9 +7,13 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 
+#include "include/LinearFreezing.hpp"
 #include "include/ModuleLoader.hpp"
 #include "include/PrognosticData.hpp"
 #include "include/PrognosticGenerator.hpp"
+#include "include/UnescoFreezing.hpp"
+
+#include <vector>
 
 namespace Nextsim {
 
@@ -24,6 +28,66 @@ TEST_CASE("Ice-layer access function", "[PrognosticData]")
     REQUIRE(pd.iceTemperature(0) == tice[0]);
     REQUIRE(pd.iceTemperature(1) == tice[1]);
     REQUIRE(pd.iceTemperature(2) == tice[2]);
+    REQUIRE(pd.nIceLayers() == 3);
+
+    // An element generated for a model refers to the context of the model
+    ModelContext context;
+    context.setTimestep(600.);
+    PrognosticData inModel(PrognosticGenerator().hice(0.1).tice(tice), context);
+    REQUIRE(inModel.timestep() == 600.);
+    REQUIRE(inModel.nIceLayers() == 3);
+    REQUIRE(inModel.iceTemperature(1) == tice[1]);
+}
+
+TEST_CASE("Block and cached freezing points", "[PrognosticData]")
+{
+    std::vector<double> sss = { 0., 5., 32., 35., 40. };
+    std::vector<double> tf(sss.size());
+
+    // The block evaluation is identical to the evaluation of single values
+    LinearFreezing linearImpl;
+    UnescoFreezing unescoImpl;
+    const IFreezingPoint& linear = linearImpl;
+    const IFreezingPoint& unesco = unescoImpl;
+    linear.blockFreezingPoint(sss.data(), tf.data(), sss.size());
+    for (std::size_t i = 0; i < sss.size(); ++i) {
+        REQUIRE(tf[i] == linear(sss[i]));
+    }
+    unesco.blockFreezingPoint(sss.data(), tf.data(), sss.size());
+    for (std::size_t i = 0; i < sss.size(); ++i) {
+        REQUIRE(tf[i] == unesco(sss[i]));
+    }
+
+    ModuleLoader::getLoader().setImplementation(
+        "Nextsim::IFreezingPoint", "Nextsim::UnescoFreezing");
+    std::vector<PrognosticData> data;
+    for (double salinity : sss) {
+        data.push_back(PrognosticGenerator().hice(0.1).cice(0.5).sst(-1.).sss(salinity));
+    }
+    tryConfigure(data[0]);
+    std::vector<PrognosticData*> block;
+    for (auto& element : data) {
+        block.push_back(&element);
+    }
+    PrognosticData::updateFreezingPoints(block);
+    for (std::size_t i = 0; i < sss.size(); ++i) {
+        REQUIRE(data[i].freezingPoint() == unesco(sss[i]));
+    }
+
+    // Changing the salinity discards the cached value
+    data[2].setSeaSurface(-1., 20.);
+    REQUIRE(data[2].freezingPoint() == unesco(20.));
+    data[3] = PrognosticGenerator().sst(-1.).sss(10.);
+    REQUIRE(data[3].freezingPoint() == unesco(10.));
+
+    // The cached value lasts only until the end of the timestep, after which
+    // a salinity written directly to the field in memory is used
+    PrognosticData::updateFreezingPoints(block);
+    data[4].updateAndIntegrate(PrognosticGenerator().hice(0.1).cice(0.5));
+    const_cast<double&>(data[4].seaSurfaceSalinity()) = 5.;
+    REQUIRE(data[4].freezingPoint() == unesco(5.));
+
+    ModuleLoader::getLoader().setAllDefaults();
 }
 
 } /* namespace Nextsim */
@@ -0,0 +1,125 @@
+/*!
+ * @file Reduction_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/DevGrid.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/Reduction.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Reproducible sums are independent of order", "[Reduction]")
+{
+    std::mt19937 gen(20261019);
+    std::uniform_real_distribution<double> mantissa(-1., 1.);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    std::vector<double> values(10000);
+    for (double& v : values) {
+        v = std::ldexp(mantissa(gen), exponent(gen));
+    }
+
+    ReproducibleSum forward;
+    for (double v : values) {
+        forward += v;
+    }
+
+    ReproducibleSum reverse;
+    for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
+        reverse += *iter;
+    }
+    REQUIRE(reverse.value() == forward.value());
+
+    std::shuffle(values.begin(), values.end(), gen);
+    // Partial sums, as from several threads or ranks
+    const int nParts = 7;
+    std::vector<ReproducibleSum> parts(nParts);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        parts[i % nParts] += values[i];
+    }
+    ReproducibleSum combined;
+    for (int i = nParts - 1; i >= 0; --i) {
+        combined += parts[i];
+    }
+    REQUIRE(combined.value() == forward.value());
+}
+
+TEST_CASE("Reproducible sums are exact", "[Reduction]")
+{
+    ReproducibleSum sum;
+    sum += 1e20;
+    sum += 1.;
+    sum += -1e20;
+    REQUIRE(sum.value() == 1.);
+
+    // Enough values to require carries between the limbs
+    ReproducibleSum tenths;
+    for (int i = 0; i < 200000; ++i) {
+        tenths += 0.1;
+        tenths += -0.1;
+    }
+    tenths += 0.5;
+    REQUIRE(tenths.value() == 0.5);
+
+    REQUIRE_THROWS_AS(sum += std::numeric_limits<double>::quiet_NaN(), std::domain_error);
+    REQUIRE_THROWS_AS(sum += 1e45, std::overflow_error);
+}
+
+TEST_CASE("Reductions over a structure", "[Reduction]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    int nElements = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        *grid.cursor = PrognosticGenerator()
+                           .hice(0.01 * nElements)
+                           .cice(0.5)
+                           .hsnow(0.)
+                           .sst(-1.)
+                           .sss(32.)
+                           .tice({ -1. });
+        ++nElements;
+    }
+    REQUIRE(nElements == DevGrid::nx * DevGrid::nx);
+
+    auto hice = [](const ElementData& data) { return data.iceThickness(); };
+    double expected = 0.01 * nElements * (nElements - 1) / 2;
+    REQUIRE(Reduction::sum(grid, hice) == Approx(expected).epsilon(1e-15));
+    // DevGrid elements have unit area
+    REQUIRE(Reduction::areaIntegral(grid, hice) == Reduction::sum(grid, hice));
+    REQUIRE(Reduction::areaWeightedMean(grid, hice) == Approx(expected / nElements));
+    REQUIRE(Reduction::minimum(grid, hice) == 0.);
+    REQUIRE(Reduction::maximum(grid, hice) == 0.01 * (nElements - 1));
+    REQUIRE(Reduction::areaIntegral(grid, [](const ElementData& data) {
+        return data.iceConcentration();
+    }) == 0.5 * nElements);
+
+    // Several integrals in one pass match the separate integrals
+    std::vector<double> integrals = Reduction::areaIntegrals(
+        grid, { hice, [](const ElementData& data) { return data.iceConcentration(); } });
+    REQUIRE(integrals.size() == 2);
+    REQUIRE(integrals[0] == Reduction::areaIntegral(grid, hice));
+    REQUIRE(integrals[1] == 0.5 * nElements);
+
+    // As do the integrals read directly from the fields
+    const ElementVector& storage = *grid.elementStorage();
+    std::vector<double> fieldIntegrals = Reduction::fieldAreaIntegrals(
+        grid, { FieldRegistry::view(storage, "hice"), FieldRegistry::view(storage, "cice") });
+    REQUIRE(fieldIntegrals == integrals);
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,68 @@
+/*!
+ * @file Reproducibility_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/Reproducibility.hpp"
+
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace Nextsim {
+
+TEST_CASE("Portable exponential", "[Reproducibility]")
+{
+    REQUIRE(Reproducibility::portableExp(0.) == 1.);
+    REQUIRE(Reproducibility::portableExp(1000.) == std::numeric_limits<double>::infinity());
+    REQUIRE(Reproducibility::portableExp(-1000.) == 0.);
+    REQUIRE(std::isnan(Reproducibility::portableExp(std::nan(""))));
+
+    // Within a few ulp of the library function
+    for (double x = -700.; x < 700.; x += 0.37) {
+        double expected = std::exp(x);
+        double ulp = std::nextafter(expected, std::numeric_limits<double>::infinity()) - expected;
+        REQUIRE(std::fabs(Reproducibility::portableExp(x) - expected) <= 2 * ulp);
+    }
+}
+
+TEST_CASE("Portable integer power", "[Reproducibility]")
+{
+    double x = 271.15;
+    REQUIRE(Reproducibility::portablePow(x, 0) == 1.);
+    REQUIRE(Reproducibility::portablePow(x, 1) == x);
+    REQUIRE(Reproducibility::portablePow(x, 2) == x * x);
+    REQUIRE(Reproducibility::portablePow(x, 4) == (x * x) * (x * x));
+}
+
+TEST_CASE("Reproducibility switch", "[Reproducibility]")
+{
+    double x = -1.234;
+    REQUIRE(!Reproducibility::isEnabled());
+    {
+        Reproducibility::Scope reproducible(true);
+        REQUIRE(Reproducibility::isEnabled());
+        REQUIRE(Reproducibility::exp(x) == Reproducibility::portableExp(x));
+        REQUIRE(Reproducibility::pow(x, 4) == Reproducibility::portablePow(x, 4));
+        {
+            Reproducibility::Scope notReproducible(false);
+            REQUIRE(!Reproducibility::isEnabled());
+        }
+        REQUIRE(Reproducibility::isEnabled());
+
+        // The setting applies only to the thread of the scope
+        bool otherThread = true;
+        std::thread([&otherThread]() { otherThread = Reproducibility::isEnabled(); }).join();
+        REQUIRE(!otherThread);
+    }
+    REQUIRE(!Reproducibility::isEnabled());
+    REQUIRE(Reproducibility::exp(x) == std::exp(x));
+    REQUIRE(Reproducibility::pow(x, 4) == std::pow(x, 4));
+}
+
+} /* namespace Nextsim */
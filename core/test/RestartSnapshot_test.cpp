@@ -0,0 +1,127 @@
+/*!
+ * @file RestartSnapshot_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/IStructure.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/RestartSnapshot.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace Nextsim {
+
+static ElementVector makeData(int n)
+{
+    ElementVector data(n, ElementData(2));
+    for (int i = 0; i < n; ++i) {
+        data[i] = PrognosticGenerator()
+                      .hice(0.1 * i)
+                      .cice(0.5)
+                      .hsnow(0.)
+                      .sst(-1.)
+                      .sss(32.)
+                      .tice({ -1. * i, -2. * i });
+    }
+    return data;
+}
+
+TEST_CASE("Snapshot of the restart fields", "[RestartSnapshot]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    const std::size_t n = 7;
+    ElementVector data = makeData(n);
+
+    RestartSnapshot snapshot;
+    REQUIRE(snapshot.empty());
+    snapshot.take(data);
+    REQUIRE(!snapshot.empty());
+    REQUIRE(snapshot.size() == n);
+
+    std::size_t bytes = 0;
+    for (auto& field : snapshot.fields()) {
+        // Only the prognostic fields are held
+        REQUIRE(field.description->group == FieldRegistry::Group::PROGNOSTIC);
+        REQUIRE(field.values.size() == n * field.nLayers);
+        bytes += field.values.size() * sizeof(double);
+        if (field.description->name == "tice") {
+            REQUIRE(field.nLayers == 2);
+            // Indexed by element then layer
+            REQUIRE(field.values[3 * 2 + 1] == -6.);
+        } else if (field.description->name == "hice") {
+            REQUIRE(field.values[4] == 0.1 * 4);
+        }
+    }
+    REQUIRE(snapshot.bytes() == bytes);
+
+    // The snapshot is independent of later changes to the data
+    const std::uint64_t checksum = snapshot.checksum();
+    ElementVector changed = makeData(n);
+    changed[2] = PrognosticGenerator().hice(5.).cice(0.5).hsnow(0.).sst(-1.).sss(32.).tice(
+        { -2., -4. });
+    snapshot.take(changed);
+    REQUIRE(snapshot.checksum() != checksum);
+    snapshot.take(data);
+    REQUIRE(snapshot.checksum() == checksum);
+
+    // Restoring the snapshot recovers the restart fields
+    snapshot.restore(changed);
+    REQUIRE(changed[2].iceThickness() == data[2].iceThickness());
+    REQUIRE(changed[2].iceTemperature(1) == -4.);
+    ElementVector shorter = makeData(n - 1);
+    REQUIRE_THROWS_AS(snapshot.restore(shorter), std::invalid_argument);
+
+    snapshot.clear();
+    REQUIRE(snapshot.empty());
+    REQUIRE(snapshot.bytes() == 0);
+    REQUIRE(snapshot.checksum() == RestartSnapshot::initialChecksum);
+}
+
+// A structure without snapshot output, which records the files it dumps
+class DumpingStructure : public IStructure {
+public:
+    void init(const std::string&) override { }
+    void dump(const std::string& filePath) const override { dumped = filePath; }
+    int nIceLayers() const override { return 1; }
+
+    bool validCursor() const override { return false; }
+    ElementData& cursorData() override { throw std::out_of_range("No elements"); }
+    const ElementData& cursorData() const override { throw std::out_of_range("No elements"); }
+    void incrCursor() override { }
+
+    mutable std::string dumped;
+};
+
+TEST_CASE("Structures without snapshot output", "[RestartSnapshot]")
+{
+    // The snapshot is written from the data of the structure
+    DumpingStructure structure;
+    RestartSnapshot snapshot;
+    structure.dumpSnapshot(snapshot, "restart.nc");
+    REQUIRE(structure.dumped == "restart.nc");
+}
+
+TEST_CASE("Checksums of values", "[RestartSnapshot]")
+{
+    const double values[] = { 1., 2., 3. };
+    REQUIRE(RestartSnapshot::checksum(values, 0) == RestartSnapshot::initialChecksum);
+    // Continuing a checksum is the same as checksumming all the values
+    REQUIRE(RestartSnapshot::checksum(values + 1, 2, RestartSnapshot::checksum(values, 1))
+        == RestartSnapshot::checksum(values, 3));
+    // The checksum depends on the order of the values
+    const double swapped[] = { 2., 1., 3. };
+    REQUIRE(RestartSnapshot::checksum(swapped, 3) != RestartSnapshot::checksum(values, 3));
+    // and distinguishes the signs of zero
+    const double zero = 0.;
+    const double negativeZero = -0.;
+    REQUIRE(RestartSnapshot::checksum(&zero, 1) != RestartSnapshot::checksum(&negativeZero, 1));
+}
+
+} /* namespace Nextsim */
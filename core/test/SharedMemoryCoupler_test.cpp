@@ -0,0 +1,147 @@
+/*!
+ * @file SharedMemoryCoupler_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/DevGrid.hpp"
+#include "include/DevStep.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/PrognosticGenerator.hpp"
+#include "include/SharedMemoryCoupler.hpp"
+#include "include/SlabPartner.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Nextsim {
+
+// A segment name unique to this process
+static std::string segmentName(const std::string& test)
+{
+    return "/nextsim_test_" + test + "_" + std::to_string(getpid());
+}
+
+TEST_CASE("Fields pass between the two sides", "[SharedMemoryCoupler]")
+{
+    const std::string name = segmentName("fields");
+    const std::size_t n = 5;
+    SharedMemoryCoupler model(name, SharedMemoryCoupler::Side::MODEL, n, 1.);
+    REQUIRE(model.nElements() == n);
+
+    std::thread partnerThread([&name]() {
+        SharedMemoryCoupler partner(name, SharedMemoryCoupler::Side::PARTNER, 0, 5.);
+        for (int step = 0; step < 3; ++step) {
+            for (int field = 0; field < SharedMemoryCoupler::N_FORCING; ++field) {
+                double* values = partner.forcing(SharedMemoryCoupler::Forcing(field));
+                for (std::size_t i = 0; i < partner.nElements(); ++i) {
+                    values[i] = 100 * step + 10 * field + i;
+                }
+            }
+            partner.sendForcing();
+            partner.receiveFluxes();
+            // Visible to the model side after the partner has finished
+            partner.forcing(SharedMemoryCoupler::SNOWFALL)[0]
+                = partner.flux(SharedMemoryCoupler::NEW_ICE)[0];
+        }
+    });
+
+    for (int step = 0; step < 3; ++step) {
+        model.receiveForcing();
+        for (int field = 0; field < SharedMemoryCoupler::N_FORCING; ++field) {
+            double* values = model.forcing(SharedMemoryCoupler::Forcing(field));
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(values[i] == 100 * step + 10 * field + i);
+            }
+        }
+        for (int field = 0; field < SharedMemoryCoupler::N_FLUX; ++field) {
+            double* values = model.flux(SharedMemoryCoupler::Flux(field));
+            for (std::size_t i = 0; i < n; ++i) {
+                values[i] = -(100. * step + 10. * field + i);
+            }
+        }
+        model.sendFluxes();
+    }
+    partnerThread.join();
+    REQUIRE(model.forcing(SharedMemoryCoupler::SNOWFALL)[0] == -220);
+
+    // Neither side waits forever
+    REQUIRE_THROWS_AS(model.receiveForcing(), std::runtime_error);
+    REQUIRE_THROWS_AS(
+        SharedMemoryCoupler(segmentName("missing"), SharedMemoryCoupler::Side::PARTNER, 0, 0.05),
+        std::runtime_error);
+}
+
+TEST_CASE("A slab partner process forces the model", "[SharedMemoryCoupler]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ElementData configureMe;
+    configureMe.configure();
+
+    DevGrid grid;
+    grid.init("");
+    const std::size_t nElements = DevGrid::nx * DevGrid::nx;
+    // Open water and ice, with the wind driving evaporation
+    std::size_t i = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        double fraction = static_cast<double>(i++) / nElements;
+        ElementData& data = *grid.cursor;
+        data = PrognosticGenerator().hice(fraction).cice(fraction).sst(-1.5).sss(32.).tice(
+            { -5. });
+        data.windSpeed() = 5.;
+    }
+    const int nSteps = 4;
+    const double dt = 600;
+
+    const std::string name = segmentName("slab");
+    SharedMemoryCoupler coupler(name, SharedMemoryCoupler::Side::MODEL, nElements, 30.);
+
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        int status = 0;
+        try {
+            SlabPartner partner(name, dt, 30.);
+            partner.run(nSteps);
+        } catch (std::exception& e) {
+            status = 1;
+        }
+        _exit(status);
+    }
+
+    // The stages as configured by Model
+    DevStep step;
+    step.setInitialData(grid);
+    step.stages().setThreads(2);
+    step.addStage(DevStep::forcingStage, [&coupler, &grid](int) { coupler.receiveForcing(grid); });
+    step.addStage(DevStep::diagnosticsStage, [&coupler, &grid](int) { coupler.sendFluxes(grid); });
+    step.start(0);
+    step.iterateSteps(Iterator::Duration(dt), nSteps);
+
+    int status = -1;
+    REQUIRE(waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+
+    // The forcing of the last step comes from the evolved slab atmosphere
+    bool warmed = false;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        const ElementData& data = *grid.cursor;
+        REQUIRE(data.airPressure() == 1e5);
+        REQUIRE(data.mixedLayerDepth() == SlabPartner::mixedLayerDepth);
+        REQUIRE(data.dewPoint2m() == data.airTemperature() - 3.);
+        if (data.evaporationRate() > 0)
+            warmed = warmed || data.airTemperature() > SlabPartner::referenceAirTemperature;
+    }
+    REQUIRE(warmed);
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,94 @@
+/*!
+ * @file SpaceFillingCurve_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/SpaceFillingCurve.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Morton indices", "[SpaceFillingCurve]")
+{
+    REQUIRE(SpaceFillingCurve::mortonIndex(0, 0) == 0);
+    REQUIRE(SpaceFillingCurve::mortonIndex(1, 0) == 1);
+    REQUIRE(SpaceFillingCurve::mortonIndex(0, 1) == 2);
+    REQUIRE(SpaceFillingCurve::mortonIndex(1, 1) == 3);
+    REQUIRE(SpaceFillingCurve::mortonIndex(2, 0) == 4);
+    // x = 011, y = 101 interleave to 100111
+    REQUIRE(SpaceFillingCurve::mortonIndex(3, 5) == 39);
+    const std::uint32_t last = (std::uint32_t(1) << SpaceFillingCurve::order()) - 1;
+    REQUIRE(SpaceFillingCurve::mortonIndex(last, last) == 0xFFFFFFFFULL);
+}
+
+TEST_CASE("Hilbert indices", "[SpaceFillingCurve]")
+{
+    // The curve fills each aligned square block before leaving it, so the
+    // cells of the first 8 × 8 block have the first 64 indices
+    const std::uint32_t n = 8;
+    std::vector<std::uint32_t> xOf(n * n, n);
+    std::vector<std::uint32_t> yOf(n * n, n);
+    for (std::uint32_t x = 0; x < n; ++x) {
+        for (std::uint32_t y = 0; y < n; ++y) {
+            std::uint64_t index = SpaceFillingCurve::hilbertIndex(x, y);
+            REQUIRE(index < n * n);
+            REQUIRE(xOf[index] == n);
+            xOf[index] = x;
+            yOf[index] = y;
+        }
+    }
+    // Consecutive cells along the curve share a side
+    for (std::uint32_t index = 1; index < n * n; ++index) {
+        int dx = std::abs(int(xOf[index]) - int(xOf[index - 1]));
+        int dy = std::abs(int(yOf[index]) - int(yOf[index - 1]));
+        REQUIRE(dx + dy == 1);
+    }
+
+    const std::uint32_t last = (std::uint32_t(1) << SpaceFillingCurve::order()) - 1;
+    REQUIRE(SpaceFillingCurve::hilbertIndex(0, 0) == 0);
+    REQUIRE(SpaceFillingCurve::hilbertIndex(last, 0) == 0xFFFFFFFFULL);
+}
+
+TEST_CASE("Ordering points", "[SpaceFillingCurve]")
+{
+    // The corners of a square, and the centre, which is in the upper right
+    // quadrant of the lattice
+    const std::vector<double> x = { 10., -10., 10., -10., 0. };
+    const std::vector<double> y = { -5., -5., 5., 5., 0. };
+
+    std::vector<std::size_t> original = { 0, 1, 2, 3, 4 };
+    REQUIRE(SpaceFillingCurve::sortOrder(x, y, SpaceFillingCurve::Curve::NONE) == original);
+
+    std::vector<std::size_t> morton = { 1, 0, 3, 4, 2 };
+    REQUIRE(SpaceFillingCurve::sortOrder(x, y, SpaceFillingCurve::Curve::MORTON) == morton);
+
+    std::vector<std::size_t> hilbert = { 1, 3, 4, 2, 0 };
+    REQUIRE(SpaceFillingCurve::sortOrder(x, y, SpaceFillingCurve::Curve::HILBERT) == hilbert);
+
+    // Coincident points keep their order
+    const std::vector<double> same(3, 1.);
+    std::vector<std::size_t> stable = { 0, 1, 2 };
+    REQUIRE(SpaceFillingCurve::sortOrder(same, same, SpaceFillingCurve::Curve::HILBERT) == stable);
+
+    REQUIRE_THROWS_AS(SpaceFillingCurve::sortOrder(x, same, SpaceFillingCurve::Curve::MORTON),
+        std::invalid_argument);
+}
+
+TEST_CASE("Curve names", "[SpaceFillingCurve]")
+{
+    REQUIRE(SpaceFillingCurve::curve("none") == SpaceFillingCurve::Curve::NONE);
+    REQUIRE(SpaceFillingCurve::curve("Morton") == SpaceFillingCurve::Curve::MORTON);
+    REQUIRE(SpaceFillingCurve::curve("HILBERT") == SpaceFillingCurve::Curve::HILBERT);
+    REQUIRE_THROWS_AS(SpaceFillingCurve::curve("peano"), std::invalid_argument);
+}
+
+} /* namespace Nextsim */
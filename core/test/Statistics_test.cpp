@@ -0,0 +1,167 @@
+/*!
+ * @file Statistics_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/ModuleLoader.hpp"
+#include "include/Statistics.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+namespace Nextsim {
+
+// Sets the ice thickness and temperatures of each element from the step
+static void setData(ElementVector& data, int step)
+{
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = PrognosticGenerator()
+                      .hice(0.1 * i + step)
+                      .cice(0.5)
+                      .hsnow(0.)
+                      .sst(-1.)
+                      .sss(32.)
+                      .tice({ -1. * step, -2. * step, -3. * i });
+    }
+}
+
+TEST_CASE("Running statistics of a field", "[Statistics]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    const int nElements = 4;
+    ElementVector data(nElements, ElementData(3));
+
+    REQUIRE_THROWS_AS(FieldStatistics("not a field"), std::out_of_range);
+    REQUIRE_THROWS_AS(FieldStatistics("hice", { 1., 0., 4 }), std::invalid_argument);
+
+    // Bins of width 1 from 0 to 4
+    FieldStatistics hice("hice", { 0., 4., 4 });
+    FieldStatistics tice("tice");
+    REQUIRE(hice.hasHistogram());
+    REQUIRE(!tice.hasHistogram());
+
+    const std::vector<int> steps = { 1, 2, 3, 6 };
+    for (int step : steps) {
+        setData(data, step);
+        hice.update(data);
+        tice.update(data);
+    }
+    REQUIRE(hice.count() == steps.size());
+    REQUIRE(hice.size() == nElements);
+    REQUIRE(hice.nLayers() == 1);
+    REQUIRE(tice.nLayers() == 3);
+
+    // Mean 3, variance (4 + 1 + 0 + 9) / 4
+    for (int i = 0; i < nElements; ++i) {
+        REQUIRE(hice.mean(i) == Approx(3. + 0.1 * i));
+        REQUIRE(hice.variance(i) == Approx(3.5));
+        REQUIRE(hice.minimum(i) == 1. + 0.1 * i);
+        REQUIRE(hice.maximum(i) == 6. + 0.1 * i);
+        REQUIRE(hice.meanData()[i] == hice.mean(i));
+        REQUIRE(hice.varianceData()[i] == hice.variance(i));
+        // The value above the range is counted in the last bin
+        const std::uint32_t* counts = hice.histogram(i);
+        REQUIRE(counts[0] == 0);
+        REQUIRE(counts[1] == 1);
+        REQUIRE(counts[2] == 1);
+        REQUIRE(counts[3] == 2);
+    }
+    REQUIRE(hice.histogramData()[4 * 2 + 3] == 2);
+
+    REQUIRE(tice.mean(2, 0) == Approx(-3.));
+    REQUIRE(tice.mean(2, 1) == Approx(-6.));
+    REQUIRE(tice.minimum(2, 1) == -12.);
+    REQUIRE(tice.maximum(2, 1) == -2.);
+    REQUIRE(tice.mean(3, 2) == -9.);
+    REQUIRE(tice.variance(3, 2) == 0.);
+    // Indexed by element then layer
+    REQUIRE(tice.minimumData()[2 * 3 + 1] == -12.);
+
+    // Values below the range are counted in the first bin
+    hice.reset();
+    REQUIRE(hice.count() == 0);
+    setData(data, -2);
+    hice.update(data);
+    REQUIRE(hice.histogram(0)[0] == 1);
+    REQUIRE(hice.mean(0) == -2.);
+    REQUIRE(hice.variance(0) == 0.);
+
+    ElementVector other(nElements + 1, ElementData(3));
+    setData(other, 0);
+    REQUIRE_THROWS_AS(hice.update(other), std::invalid_argument);
+}
+
+TEST_CASE("Statistics windows", "[Statistics]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ElementVector data(3, ElementData(3));
+
+    Statistics statistics;
+    REQUIRE(statistics.empty());
+    REQUIRE_THROWS_AS(statistics.setWindow(0), std::invalid_argument);
+    statistics.add("hice");
+    statistics.add("cice", { 0., 1., 10 });
+    REQUIRE(!statistics.empty());
+    statistics.setWindow(30);
+
+    // Timesteps of 10 from time 100, so each window holds three timesteps
+    const int dt = 10;
+    int time = 100;
+    for (int step = 0; step < 7; ++step, time += dt) {
+        setData(data, step);
+        bool completed = statistics.update(data, time, dt);
+        REQUIRE(completed == (step % 3 == 2));
+        REQUIRE(statistics.windowCompleted() == completed);
+        if (completed) {
+            const FieldStatistics& hice = statistics.completed()[0];
+            REQUIRE(hice.name() == "hice");
+            REQUIRE(hice.count() == 3);
+            // The mean over the three steps of the window
+            REQUIRE(hice.mean(0) == Approx(step - 1.));
+            REQUIRE(hice.minimum(1) == step - 2 + 0.1);
+            REQUIRE(statistics.completed()[1].histogram(2)[5] == 3);
+            REQUIRE(statistics.completedEnd() == time + dt);
+            REQUIRE(statistics.completedStart() == time + dt - 30);
+            // The next window starts afresh
+            REQUIRE(statistics.current()[0].count() == 0);
+        }
+    }
+    // The partial window is still accumulating
+    REQUIRE(statistics.current()[0].count() == 1);
+    REQUIRE(statistics.current()[0].mean(0) == 6.);
+    REQUIRE(statistics.completed()[0].mean(0) == Approx(4.));
+}
+
+TEST_CASE("Rounding completed statistics", "[Statistics]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ElementVector data(3, ElementData(3));
+
+    Statistics statistics;
+    statistics.add("hice");
+    statistics.add("tice");
+    statistics.setWindow(2);
+    setData(data, 1);
+    statistics.update(data, 0, 1);
+    setData(data, 2);
+    REQUIRE(statistics.update(data, 1, 1));
+
+    BitRounding rounding(52);
+    rounding.setKeepBits("hice", 2);
+    statistics.roundCompleted(rounding);
+    const FieldStatistics& hice = statistics.completed()[0];
+    // Element 1 has a mean of 1.6, variance 0.25, minimum 1.1 and maximum 2.1
+    REQUIRE(hice.meanData()[1] == 1.5);
+    REQUIRE(hice.varianceData()[1] == 0.25);
+    REQUIRE(hice.minimumData()[1] == 1.);
+    REQUIRE(hice.maximumData()[1] == 2.);
+    // Other fields keep all their bits
+    REQUIRE(statistics.completed()[1].meanData()[0] == -1.5);
+}
+
+} /* namespace Nextsim */
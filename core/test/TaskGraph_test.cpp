@@ -0,0 +1,160 @@
+/*!
+ * @file TaskGraph_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "TaskGraph.hpp"
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Nextsim {
+
+// Records the order in which the stages execute
+class Recorder {
+public:
+    TaskGraph::Stage stage(const std::string& name)
+    {
+        return [this, name](int step) {
+            std::lock_guard<std::mutex> lock(mtx);
+            log.push_back({ name, step });
+        };
+    }
+
+    // Position of the given stage and step in the log, or -1
+    int position(const std::string& name, int step) const
+    {
+        auto iter = std::find(log.begin(), log.end(), std::make_pair(name, step));
+        return (iter == log.end()) ? -1 : iter - log.begin();
+    }
+
+    std::vector<std::pair<std::string, int>> log;
+    std::mutex mtx;
+};
+
+TEST_CASE("Single stage", "[TaskGraph]")
+{
+    TaskGraph graph;
+    std::vector<int> steps;
+    graph.addStage("only", [&steps](int step) { steps.push_back(step); });
+
+    const int nSteps = 5;
+    graph.run(nSteps);
+    REQUIRE(steps.size() == nSteps);
+    for (int i = 0; i < nSteps; ++i) {
+        REQUIRE(steps[i] == i);
+    }
+
+    // Running again restarts from step zero
+    steps.clear();
+    graph.run(2);
+    REQUIRE(steps.size() == 2);
+    REQUIRE(steps[0] == 0);
+}
+
+TEST_CASE("Dependencies are respected", "[TaskGraph]")
+{
+    Recorder rec;
+    TaskGraph graph;
+    graph.setThreads(3);
+    graph.addStage("forcing", rec.stage("forcing"), {}, { "physics" });
+    graph.addStage("physics", rec.stage("physics"), { "forcing" }, { "diagnostics" });
+    graph.addStage("diagnostics", rec.stage("diagnostics"), { "physics" });
+    graph.addStage("output", rec.stage("output"), { "diagnostics" });
+    REQUIRE(graph.nStages() == 4);
+    REQUIRE(graph.hasStage("output"));
+    REQUIRE(!graph.hasStage("checkpoint"));
+
+    const int nSteps = 10;
+    graph.run(nSteps);
+    REQUIRE(rec.log.size() == 4 * nSteps);
+
+    for (int i = 0; i < nSteps; ++i) {
+        REQUIRE(rec.position("forcing", i) < rec.position("physics", i));
+        REQUIRE(rec.position("physics", i) < rec.position("diagnostics", i));
+        REQUIRE(rec.position("diagnostics", i) < rec.position("output", i));
+        if (i > 0) {
+            REQUIRE(rec.position("physics", i - 1) < rec.position("forcing", i));
+            REQUIRE(rec.position("diagnostics", i - 1) < rec.position("physics", i));
+            REQUIRE(rec.position("output", i - 1) < rec.position("output", i));
+        }
+    }
+}
+
+TEST_CASE("Undeclared dependencies are ignored", "[TaskGraph]")
+{
+    Recorder rec;
+    TaskGraph graph;
+    graph.addStage("physics", rec.stage("physics"), { "forcing" }, { "checkpoint" });
+    graph.run(3);
+    REQUIRE(rec.log.size() == 3);
+    REQUIRE(graph.nStages() == 1);
+
+    REQUIRE_THROWS_AS(graph.addStage("physics", rec.stage("physics")), std::invalid_argument);
+}
+
+TEST_CASE("Stages overlap across timesteps", "[TaskGraph]")
+{
+    // The output of step n can only finish once the compute of step n+1 has
+    // started, which is only possible if the two stages run concurrently.
+    std::mutex mtx;
+    std::condition_variable cv;
+    int computeStarted = -1;
+
+    TaskGraph graph;
+    graph.setThreads(2);
+    graph.setMaxLead(1);
+    graph.addStage("compute", [&](int step) {
+        std::lock_guard<std::mutex> lock(mtx);
+        computeStarted = step;
+        cv.notify_all();
+    });
+    graph.addStage(
+        "output",
+        [&](int step) {
+            std::unique_lock<std::mutex> lock(mtx);
+            bool overlapped = cv.wait_for(lock, std::chrono::seconds(10),
+                [&]() { return computeStarted > step || step == 3; });
+            if (!overlapped)
+                throw std::runtime_error("stages did not overlap");
+        },
+        { "compute" });
+
+    REQUIRE_NOTHROW(graph.run(4));
+}
+
+TEST_CASE("Exceptions are propagated", "[TaskGraph]")
+{
+    int afterCount = 0;
+    TaskGraph graph;
+    graph.addStage("fails", [](int step) {
+        if (step == 2)
+            throw std::runtime_error("stage failed");
+    });
+    graph.addStage("after", [&afterCount](int) { ++afterCount; }, { "fails" });
+
+    REQUIRE_THROWS_AS(graph.run(5), std::runtime_error);
+    REQUIRE(afterCount <= 2);
+}
+
+TEST_CASE("Cycles are detected", "[TaskGraph]")
+{
+    TaskGraph graph;
+    graph.setThreads(2);
+    graph.addStage("a", [](int) {}, { "b" });
+    graph.addStage("b", [](int) {}, { "a" });
+    REQUIRE_THROWS_AS(graph.run(1), std::logic_error);
+}
+
+} /* namespace Nextsim */
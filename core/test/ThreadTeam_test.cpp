@@ -0,0 +1,263 @@
+/*!
+ * @file ThreadTeam_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/DevGrid.hpp"
+#include "include/DevStep.hpp"
+#include "include/ModelContext.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/ThreadTeam.hpp"
+#include "include/Tiling.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Nextsim {
+
+TEST_CASE("Blocks divide the items between the threads", "[ThreadTeam]")
+{
+    const std::size_t nItems = 10;
+    const int nThreads = 4;
+    // The first two threads hold one extra item
+    std::vector<std::size_t> sizes = { 3, 3, 2, 2 };
+    std::size_t next = 0;
+    for (int t = 0; t < nThreads; ++t) {
+        auto items = ThreadTeam::block(nItems, t, nThreads);
+        REQUIRE(items.first == next);
+        REQUIRE(items.second - items.first == sizes[t]);
+        next = items.second;
+    }
+    REQUIRE(next == nItems);
+
+    // More threads than items
+    auto items = ThreadTeam::block(2, 3, 4);
+    REQUIRE(items.first == items.second);
+}
+
+TEST_CASE("Tasks run once on every thread", "[ThreadTeam]")
+{
+    ThreadTeam team;
+    REQUIRE(team.nThreads() == 1);
+    team.setThreads(3);
+    REQUIRE(team.nThreads() == 3);
+
+    for (int repeat = 0; repeat < 10; ++repeat) {
+        std::vector<int> calls(team.nThreads(), 0);
+        team.run([&calls](int thread) { ++calls[thread]; });
+        for (int count : calls) {
+            REQUIRE(count == 1);
+        }
+    }
+
+    // Exceptions are passed to the calling thread, and the team remains usable
+    REQUIRE_THROWS_AS(team.run([](int thread) {
+        if (thread == 2)
+            throw std::runtime_error("thread 2");
+    }),
+        std::runtime_error);
+    std::atomic<int> total(0);
+    team.run([&total](int thread) { total += thread; });
+    REQUIRE(total == 0 + 1 + 2);
+
+    // Pinning restarts the threads, which still all run
+#ifdef __linux__
+    cpu_set_t before;
+    pthread_getaffinity_np(pthread_self(), sizeof(before), &before);
+#endif
+    team.setPinning(true);
+    REQUIRE(team.pinning());
+    total = 0;
+    team.run([&total](int) { total += 1; });
+    REQUIRE(total == 3);
+#ifdef __linux__
+    // The calling thread is only pinned while it runs the task
+    cpu_set_t after;
+    pthread_getaffinity_np(pthread_self(), sizeof(after), &after);
+    REQUIRE(CPU_EQUAL(&before, &after));
+#endif
+    team.setPinning(false);
+
+    team.setThreads(0);
+    REQUIRE(team.nThreads() >= 1);
+}
+
+TEST_CASE("Concurrent callers take turns", "[ThreadTeam]")
+{
+    ThreadTeam team;
+    team.setThreads(3);
+
+    // No two tasks are executing on the team at once
+    std::atomic<int> active(0);
+    std::atomic<bool> overlapped(false);
+    std::atomic<int> total(0);
+    auto caller = [&]() {
+        for (int repeat = 0; repeat < 100; ++repeat) {
+            team.run([&](int thread) {
+                if (thread == 0 && active.fetch_add(1) != 0)
+                    overlapped = true;
+                total += 1;
+                if (thread == 0)
+                    --active;
+            });
+        }
+    };
+    std::thread other(caller);
+    caller();
+    other.join();
+    REQUIRE(!overlapped);
+    REQUIRE(total == 2 * 100 * 3);
+}
+
+TEST_CASE("Threaded tiles visit every element once", "[ThreadTeam]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    ThreadTeam::main.setThreads(3);
+
+    // The elements are first touched by the threads of the main team
+    DevGrid grid;
+    grid.init("");
+    const std::size_t nElements = DevGrid::nx * DevGrid::nx;
+
+    std::mutex mutex;
+    std::map<ElementData*, int> visits;
+    Tiling tiling(8);
+    tiling.addPass([&mutex, &visits](const Tiling::Tile& tile) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (ElementData* pData : tile) {
+            ++visits[pData];
+        }
+    });
+    tiling.run(grid);
+
+    REQUIRE(visits.size() == nElements);
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        REQUIRE(visits[&*grid.cursor] == 1);
+    }
+    ThreadTeam::main.setThreads(1);
+}
+
+// Sets a state which varies across the grid
+static void initialize(DevGrid& grid)
+{
+    const int nElements = DevGrid::nx * DevGrid::nx;
+    int i = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        double fraction = static_cast<double>(i++) / nElements;
+        ElementData& data = *grid.cursor;
+        data = PrognosticGenerator()
+                   .hice(2. * fraction)
+                   .cice(fraction)
+                   .hsnow(0.1)
+                   .sst(-1.5)
+                   .sss(32.)
+                   .tice({ -10. + 5. * fraction });
+        data.setAirTemperature(-20. + 10. * fraction);
+        data.setDewPoint2m(-21. + 10. * fraction);
+        data.setAirPressure(101000.);
+        data.setMixedLayerDepth(10.);
+        data.setIncomingLongwave(250.);
+        data.setIncomingShortwave(50.);
+        data.windSpeed() = 5.;
+    }
+}
+
+TEST_CASE("Models run concurrently on their own teams", "[ThreadTeam]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    const int nModels = 3;
+    const int nSteps = 5;
+    const Iterator::Duration dt = 3600;
+
+    // The last model is calculated alone, on one thread
+    std::vector<ModelContext> contexts(nModels);
+    std::vector<DevGrid> grids(nModels);
+    for (int m = 0; m < nModels; ++m) {
+        contexts[m].threadTeam().setThreads(m < nModels - 1 ? 3 : 1);
+        ElementData configureMe(1, contexts[m]);
+        configureMe.configure();
+        grids[m].setContext(contexts[m]);
+        grids[m].init("");
+        initialize(grids[m]);
+    }
+    REQUIRE(&contexts[0].threadTeam() != &contexts[1].threadTeam());
+    REQUIRE(&ModelContext::defaultContext().threadTeam() == &ThreadTeam::main);
+
+    auto runModel = [&grids, nSteps, dt](int m) {
+        DevStep step;
+        step.setFusedPhysics(true);
+        step.setInitialData(grids[m]);
+        step.start(0);
+        step.iterateSteps(dt, nSteps);
+    };
+    runModel(nModels - 1);
+    std::vector<std::thread> threads;
+    for (int m = 0; m < nModels - 1; ++m) {
+        threads.emplace_back(runModel, m);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Each concurrently calculated model matches the serial calculation
+    REQUIRE(ThreadTeam::main.nThreads() == 1);
+    DevGrid& serial = grids[nModels - 1];
+    for (int m = 0; m < nModels - 1; ++m) {
+        ElementVector& data = *grids[m].elementStorage();
+        ElementVector& expected = *serial.elementStorage();
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            REQUIRE(data[i].iceThickness() == expected[i].iceThickness());
+            REQUIRE(data[i].iceConcentration() == expected[i].iceConcentration());
+            REQUIRE(data[i].iceTemperature(0) == expected[i].iceTemperature(0));
+        }
+    }
+}
+
+TEST_CASE("Threaded modular physics matches the serial calculation", "[ThreadTeam]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    const Iterator::Duration dt = 3600;
+
+    // The same model on three threads and on one
+    std::vector<ModelContext> contexts(2);
+    std::vector<DevGrid> grids(2);
+    for (int m = 0; m < 2; ++m) {
+        contexts[m].threadTeam().setThreads(m == 0 ? 3 : 1);
+        ElementData configureMe(1, contexts[m]);
+        configureMe.configure();
+        grids[m].setContext(contexts[m]);
+        grids[m].init("");
+        initialize(grids[m]);
+
+        DevStep step;
+        step.setFusedPhysics(false);
+        step.setInitialData(grids[m]);
+        step.start(0);
+        step.iterateSteps(dt, 5);
+    }
+
+    ElementVector& data = *grids[0].elementStorage();
+    ElementVector& expected = *grids[1].elementStorage();
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        REQUIRE(data[i].iceThickness() == expected[i].iceThickness());
+        REQUIRE(data[i].iceConcentration() == expected[i].iceConcentration());
+        REQUIRE(data[i].iceTemperature(0) == expected[i].iceTemperature(0));
+    }
+}
+
+} /* namespace Nextsim */
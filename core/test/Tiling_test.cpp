@@ -0,0 +1,101 @@
+/*!
+ * @file Tiling_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/DevGrid.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/Tiling.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Passes run on each tile in turn", "[Tiling]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+
+    DevGrid grid;
+    grid.init("");
+    const std::size_t nElements = DevGrid::nx * DevGrid::nx;
+    const int tileSize = 16;
+
+    Tiling tiling(tileSize);
+    REQUIRE(tiling.tileSize() == tileSize);
+
+    // Record the pass and the elements of each call
+    std::vector<std::pair<int, Tiling::Tile>> calls;
+    tiling.addPass([&calls](const Tiling::Tile& tile) {
+        calls.push_back({ 0, tile });
+        for (ElementData* pData : tile) {
+            *pData = PrognosticGenerator().hice(1.).cice(0.5);
+        }
+    });
+    tiling.addPass([&calls](const Tiling::Tile& tile) {
+        calls.push_back({ 1, tile });
+        // The first pass has already run on the elements of this tile
+        for (ElementData* pData : tile) {
+            REQUIRE(pData->iceThickness() == 1.);
+        }
+    });
+    REQUIRE(tiling.nPasses() == 2);
+    tiling.run(grid);
+
+    // Both passes on each tile, the final tile holding the remainder
+    const std::size_t nTiles = (nElements + tileSize - 1) / tileSize;
+    REQUIRE(calls.size() == 2 * nTiles);
+    std::vector<ElementData*> visited;
+    for (std::size_t i = 0; i < nTiles; ++i) {
+        REQUIRE(calls[2 * i].first == 0);
+        REQUIRE(calls[2 * i + 1].first == 1);
+        REQUIRE(calls[2 * i].second == calls[2 * i + 1].second);
+        std::size_t expectedSize
+            = (i < nTiles - 1) ? std::size_t(tileSize) : nElements - (nTiles - 1) * tileSize;
+        REQUIRE(calls[2 * i].second.size() == expectedSize);
+        visited.insert(visited.end(), calls[2 * i].second.begin(), calls[2 * i].second.end());
+    }
+
+    // Every element once, in cursor order
+    REQUIRE(visited.size() == nElements);
+    int i = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        REQUIRE(visited[i++] == &*grid.cursor);
+    }
+}
+
+TEST_CASE("Tile sizes", "[Tiling]")
+{
+    Tiling tiling;
+    REQUIRE(tiling.tileSize() == Tiling::defaultTileSize);
+    REQUIRE_THROWS_AS(tiling.setTileSize(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(Tiling(-1), std::invalid_argument);
+
+    ModuleLoader::getLoader().setAllDefaults();
+    DevGrid grid;
+    grid.init("");
+    int nCalls = 0;
+    tiling.addPass([&nCalls](const Tiling::Tile&) { ++nCalls; });
+
+    // A tile larger than the structure holds all of the elements
+    tiling.setTileSize(1000);
+    tiling.run(grid);
+    REQUIRE(nCalls == 1);
+
+    nCalls = 0;
+    tiling.setTileSize(1);
+    tiling.run(grid);
+    REQUIRE(nCalls == DevGrid::nx * DevGrid::nx);
+
+    tiling.clearPasses();
+    REQUIRE(tiling.nPasses() == 0);
+}
+
+} /* namespace Nextsim */
@@ -13,6 +13,7 @@
 #include <chrono>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <thread>
 
 TEST_CASE("Test a timer", "[Timer]")
@@ -84,3 +85,23 @@ TEST_CASE("Test the scope dependent timer", "[LocalTimer]")
 
     std::cout << Nextsim::Timer::main << std::endl;
 }
+
+TEST_CASE("Elapsed and lap times", "[Timer]")
+{
+    Nextsim::Timer::main.reset();
+    Nextsim::Timer::main.tick("outer");
+    for (int i = 0; i < 3; ++i) {
+        Nextsim::Timer::main.tick("inner");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Nextsim::Timer::main.tock();
+    }
+    // The inner timer is stopped, so has no current lap
+    REQUIRE(Nextsim::Timer::main.lap("inner") == 0);
+    REQUIRE(Nextsim::Timer::main.elapsed("inner") >= 0.030);
+    // The outer timer is still running
+    REQUIRE(Nextsim::Timer::main.lap("outer") >= Nextsim::Timer::main.elapsed("inner"));
+    REQUIRE(Nextsim::Timer::main.elapsed("outer") >= Nextsim::Timer::main.lap("outer"));
+    Nextsim::Timer::main.tock();
+
+    REQUIRE_THROWS_AS(Nextsim::Timer::main.elapsed("no such timer"), std::out_of_range);
+}
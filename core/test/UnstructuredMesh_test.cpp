@@ -0,0 +1,268 @@
+/*!
+ * @file UnstructuredMesh_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/Coarsening.hpp"
+#include "include/ElementData.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/Statistics.hpp"
+#include "include/UnstructuredMesh.hpp"
+#include "include/UnstructuredMeshIO.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+const std::string filename = "UnstructuredMesh_test.nc";
+
+namespace Nextsim {
+
+// A square of n × n cells of side 1 m, with the cells of the first row as
+// quadrilaterals and the others divided into two triangles. The elements are
+// shuffled, so that neighbouring elements are far apart in the original order.
+struct TestMesh {
+    TestMesh(int n)
+        : nMaxVertices(4)
+    {
+        for (int j = 0; j <= n; ++j) {
+            for (int i = 0; i <= n; ++i) {
+                nodeX.push_back(i);
+                nodeY.push_back(j);
+            }
+        }
+        std::vector<std::vector<int>> elements;
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                int sw = j * (n + 1) + i;
+                int se = sw + 1;
+                int nw = sw + n + 1;
+                int ne = nw + 1;
+                if (j == 0) {
+                    elements.push_back({ sw, se, ne, nw });
+                } else {
+                    elements.push_back({ sw, se, ne, UnstructuredMesh::noNode() });
+                    elements.push_back({ sw, ne, nw, UnstructuredMesh::noNode() });
+                }
+            }
+        }
+        // A deterministic shuffle
+        unsigned int state = 12345;
+        for (std::size_t i = elements.size() - 1; i > 0; --i) {
+            state = state * 1103515245 + 12345;
+            std::swap(elements[i], elements[(state >> 8) % (i + 1)]);
+        }
+        for (auto& element : elements) {
+            elementNodes.insert(elementNodes.end(), element.begin(), element.end());
+        }
+    }
+    std::vector<double> nodeX;
+    std::vector<double> nodeY;
+    std::vector<int> elementNodes;
+    int nMaxVertices;
+};
+
+// The mean separation in memory of neighbouring elements
+static double meanSeparation(const UnstructuredMesh& mesh)
+{
+    double total = 0;
+    int count = 0;
+    for (std::size_t element = 0; element < mesh.nElements(); ++element) {
+        for (int i = 0; i < mesh.nNeighbours(element); ++i) {
+            total += std::abs(double(mesh.neighbour(element, i)) - double(element));
+            ++count;
+        }
+    }
+    return total / count;
+}
+
+TEST_CASE("Building a mesh", "[UnstructuredMesh]")
+{
+    const int n = 8;
+    TestMesh test(n);
+    UnstructuredMesh mesh;
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+
+    REQUIRE(mesh.nNodes() == (n + 1) * (n + 1));
+    REQUIRE(mesh.nElements() == n + 2 * n * (n - 1));
+    REQUIRE(mesh.nMaxVertices() == 4);
+
+    // The elements cover the square
+    double total = 0;
+    int nQuads = 0;
+    for (std::size_t element = 0; element < mesh.nElements(); ++element) {
+        int nVertices = mesh.nVertices(element);
+        REQUIRE(mesh.area(element) == (nVertices == 4 ? 1. : 0.5));
+        nQuads += (nVertices == 4) ? 1 : 0;
+        total += mesh.area(element);
+    }
+    REQUIRE(nQuads == n);
+    REQUIRE(total == n * n);
+
+    // The nodes are numbered in the order of their first use
+    REQUIRE(mesh.vertex(0, 0) == 0);
+    REQUIRE(mesh.vertex(0, 1) == 1);
+    REQUIRE(mesh.vertex(0, 2) == 2);
+
+    // The original mesh is recovered exactly
+    std::vector<double> nodeX;
+    std::vector<double> nodeY;
+    std::vector<int> elementNodes;
+    mesh.originalMesh(nodeX, nodeY, elementNodes);
+    REQUIRE(nodeX == test.nodeX);
+    REQUIRE(nodeY == test.nodeY);
+    REQUIRE(elementNodes == test.elementNodes);
+    for (std::size_t node = 0; node < mesh.nNodes(); ++node) {
+        REQUIRE(mesh.nodeX(node) == test.nodeX[mesh.nodeIndex(node)]);
+    }
+
+    REQUIRE_THROWS_AS(mesh.setMesh(test.nodeX, test.nodeY, { 0, 1, 99 }, 3),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(mesh.setMesh(test.nodeX, test.nodeY, { 0, 1, -1 }, 3),
+        std::invalid_argument);
+    REQUIRE_THROWS_AS(mesh.setMesh(test.nodeX, test.nodeY, { 0, 1, 2, 3 }, 3),
+        std::invalid_argument);
+}
+
+TEST_CASE("Neighbours of the elements", "[UnstructuredMesh]")
+{
+    const int n = 8;
+    TestMesh test(n);
+    UnstructuredMesh mesh;
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+
+    // The neighbour relation is symmetric, and each interior side is shared
+    int nShared = 0;
+    for (std::size_t element = 0; element < mesh.nElements(); ++element) {
+        REQUIRE(mesh.nNeighbours(element) <= mesh.nVertices(element));
+        for (int i = 0; i < mesh.nNeighbours(element); ++i) {
+            std::size_t other = mesh.neighbour(element, i);
+            REQUIRE(other != element);
+            if (i > 0)
+                REQUIRE(other > mesh.neighbour(element, i - 1));
+            bool found = false;
+            for (int j = 0; j < mesh.nNeighbours(other); ++j) {
+                found |= mesh.neighbour(other, j) == element;
+            }
+            REQUIRE(found);
+            ++nShared;
+        }
+    }
+    // Interior grid lines, and the diagonals of the triangulated cells
+    const int nInterior = 2 * n * (n - 1) + n * (n - 1);
+    REQUIRE(nShared == 2 * nInterior);
+
+    // The curves bring neighbours closer together in memory than the
+    // shuffled original order
+    mesh.setOrdering(SpaceFillingCurve::Curve::NONE);
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+    double shuffled = meanSeparation(mesh);
+    mesh.setOrdering(SpaceFillingCurve::Curve::MORTON);
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+    double morton = meanSeparation(mesh);
+    mesh.setOrdering(SpaceFillingCurve::Curve::HILBERT);
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+    double hilbert = meanSeparation(mesh);
+    REQUIRE(morton < shuffled / 4);
+    REQUIRE(hilbert < shuffled / 4);
+}
+
+TEST_CASE("Elements of a mesh", "[UnstructuredMesh]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    const int n = 4;
+    TestMesh test(n);
+    UnstructuredMesh mesh;
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+    mesh.init("");
+    REQUIRE(mesh.elementStorage()->size() == mesh.nElements());
+
+    double total = 0;
+    for (mesh.cursor = 0; mesh.cursor; ++mesh.cursor) {
+        total += mesh.cursorArea();
+    }
+    REQUIRE(total == n * n);
+
+    // Values in the original order are placed on the reordered elements
+    std::vector<double> original(mesh.nElements());
+    for (std::size_t i = 0; i < original.size(); ++i) {
+        original[i] = i;
+    }
+    FieldView<double> hice = FieldRegistry::mutableView(*mesh.elementStorage(), "hice");
+    mesh.fromOriginalOrder(original.data(), 1, hice.data(), FieldView<double>::elementStride);
+    for (std::size_t element = 0; element < mesh.nElements(); ++element) {
+        REQUIRE(hice[element] == mesh.elementIndex(element));
+    }
+    std::vector<double> back(mesh.nElements());
+    mesh.toOriginalOrder(hice.data(), FieldView<double>::elementStride, 1, back.data());
+    REQUIRE(back == original);
+
+    // The mesh has no statistics or coarsened output
+    REQUIRE(!mesh.hasStatisticsOutput());
+    REQUIRE(!mesh.hasCoarsenedOutput());
+    Statistics statistics;
+    REQUIRE_THROWS_AS(mesh.dumpStatistics(statistics, "statistics.nc", 0), std::logic_error);
+    Coarsening coarsening(2);
+    REQUIRE_THROWS_AS(mesh.coarsen(coarsening), std::logic_error);
+    REQUIRE_THROWS_AS(mesh.dumpCoarsened(coarsening, "output.nc", 0), std::logic_error);
+}
+
+TEST_CASE("Write and read an UnstructuredMesh restart file", "[UnstructuredMesh]")
+{
+    ModuleLoader::getLoader().setAllDefaults();
+    const int n = 4;
+    TestMesh test(n);
+    UnstructuredMesh mesh;
+    mesh.setIO(new UnstructuredMeshIO(mesh));
+    mesh.setMesh(test.nodeX, test.nodeY, test.elementNodes, test.nMaxVertices);
+    mesh.init("");
+    ElementVector& data = *mesh.elementStorage();
+    for (std::size_t element = 0; element < mesh.nElements(); ++element) {
+        double fractional = 0.01 * mesh.elementIndex(element);
+        data[element] = PrognosticGenerator()
+                            .hice(1 + fractional)
+                            .cice(0.5 + fractional)
+                            .sst(-1 - fractional)
+                            .sss(32 + fractional)
+                            .hsnow(0.1 + fractional)
+                            .tice({ -(2. + fractional) });
+    }
+    mesh.dump(filename);
+
+    // Read the file into a mesh ordered along a different curve
+    UnstructuredMesh mesh2;
+    mesh2.setIO(new UnstructuredMeshIO(mesh2));
+    mesh2.setOrdering(SpaceFillingCurve::Curve::MORTON);
+    mesh2.init(filename);
+
+    std::vector<double> nodeX;
+    std::vector<double> nodeY;
+    std::vector<int> elementNodes;
+    mesh2.originalMesh(nodeX, nodeY, elementNodes);
+    REQUIRE(nodeX == test.nodeX);
+    REQUIRE(nodeY == test.nodeY);
+    REQUIRE(elementNodes == test.elementNodes);
+
+    ElementVector& data2 = *mesh2.elementStorage();
+    REQUIRE(data2.size() == mesh.nElements());
+    for (std::size_t element = 0; element < mesh2.nElements(); ++element) {
+        double fractional = 0.01 * mesh2.elementIndex(element);
+        REQUIRE(data2[element].iceThickness() == 1 + fractional);
+        REQUIRE(data2[element].iceConcentration() == 0.5 + fractional);
+        REQUIRE(data2[element].seaSurfaceTemperature() == -1 - fractional);
+        REQUIRE(data2[element].iceTemperature(0) == -(2. + fractional));
+    }
+
+    std::remove(filename.c_str());
+}
+
+} /* namespace Nextsim */
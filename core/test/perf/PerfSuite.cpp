@@ -0,0 +1,351 @@
+/*!
+ * @file PerfSuite.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/Configurator.hpp"
+#include "include/ConfiguredModule.hpp"
+#include "include/DevStep.hpp"
+#include "include/ElementData.hpp"
+#include "include/IStructure.hpp"
+#include "include/Logged.hpp"
+#include "include/ModuleLoader.hpp"
+#include "include/PrognosticGenerator.hpp"
+#include "include/Timer.hpp"
+
+#include <boost/program_options.hpp>
+
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+ * Performance regression suite. Each scenario runs the model timestep at a
+ * fixed problem size and records the wall time per step with Timer. The
+ * timing is compared with a baseline from a file of lines
+ *
+ *     <scenario name> <seconds per step>
+ *
+ * and the run fails if it is slower than the baseline by more than the
+ * tolerance. Baselines depend on the machine and the build type, so they
+ * should be recorded with --update on the machine that runs the comparison,
+ * using an optimized build. A scenario without a baseline reports its
+ * timing, and unless another scenario regressed the run exits with the code
+ * skipCode, which ctest reports as a skipped test.
+ *
+ * The scenarios listed by --list are registered with ctest, once the suite
+ * is built, with the label "performance":
+ *
+ *     ctest -L performance
+ */
+
+namespace Nextsim {
+
+// The exit code of a run in which some scenario has no baseline
+static const int skipCode = 77;
+
+// A structure of an arbitrary number of elements, for timing at fixed sizes
+class PerfGrid : public IStructure {
+public:
+    PerfGrid(int nElements, int nLayers)
+        : m_nLayers(nLayers)
+    {
+        data.reserve(nElements);
+        for (int i = 0; i < nElements; ++i) {
+            data.emplace_back(nLayers);
+        }
+    }
+
+    void init(const std::string&) override { }
+    void dump(const std::string&) const override { }
+    int nIceLayers() const override { return m_nLayers; };
+
+    int resetCursor() override
+    {
+        iCursor = data.begin();
+        return IStructure::resetCursor();
+    }
+    bool validCursor() const override { return iCursor != data.end(); }
+    ElementData& cursorData() override { return *iCursor; }
+    const ElementData& cursorData() const override { return *iCursor; }
+    void incrCursor() override { ++iCursor; }
+
+private:
+    ElementVector data;
+    ElementVector::iterator iCursor;
+    int m_nLayers;
+};
+
+struct Scenario {
+    std::string thermodynamics; // Implementation of IThermodynamics
+    int nx; // Elements along each side of the square domain
+    int nLayers; // Ice temperature layers
+    int nSteps; // Timesteps per timed repetition
+    bool fused; // Single pass physics calculation
+};
+
+// The standard scenarios. Renaming or resizing a scenario invalidates its baseline.
+static const std::map<std::string, Scenario> scenarios = {
+    { "physics_ThermoIce0_32x32", { "Nextsim::ThermoIce0", 32, 1, 100, false } },
+    { "physics_ThermoIce0_128x128", { "Nextsim::ThermoIce0", 128, 1, 8, false } },
+    { "physics_ThermoIceN_64x64", { "Nextsim::ThermoIceN", 64, 3, 30, false } },
+    { "physics_fused_ThermoIce0_128x128", { "Nextsim::ThermoIce0", 128, 1, 8, true } },
+};
+
+// Sets a winter state which varies across the domain, so that elements take
+// different branches of the physics: open water, thin and thick ice.
+static void initialize(IStructure& grid, const Scenario& scenario)
+{
+    const int nElements = scenario.nx * scenario.nx;
+    int i = 0;
+    for (grid.cursor = 0; grid.cursor; ++grid.cursor) {
+        double fraction = static_cast<double>(i++) / nElements;
+        std::vector<double> tice(scenario.nLayers);
+        for (int k = 0; k < scenario.nLayers; ++k) {
+            tice[k] = -20. + 16. * (k + 0.5) / scenario.nLayers;
+        }
+        ElementData& data = *grid.cursor;
+        data = PrognosticGenerator()
+                   .hice(2. * fraction * fraction)
+                   .cice(fraction)
+                   .hsnow(0.2 * fraction)
+                   .sst(-1.5)
+                   .sss(32.)
+                   .tice(tice);
+        data.setAirTemperature(-25. + 20. * fraction);
+        data.setDewPoint2m(-26. + 20. * fraction);
+        data.setAirPressure(101000.);
+        data.setMixedLayerDepth(10.);
+        data.setIncomingLongwave(250.);
+        data.setIncomingShortwave(50.);
+        data.setSnowfall(1e-5);
+        data.windSpeed() = 5.;
+    }
+}
+
+/*
+ * Runs a scenario and returns the wall time per timestep in seconds, the
+ * minimum over the repetitions, which is the least affected by other load on
+ * the machine.
+ */
+static double runScenario(const std::string& name, const Scenario& scenario, int nRepeats)
+{
+    Configurator::clear();
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "Nextsim::IThermodynamics = " << scenario.thermodynamics << std::endl;
+    Configurator::addStream(std::unique_ptr<std::istream>(new std::stringstream(config.str())));
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+
+    ElementData configureMe;
+    configureMe.configure();
+
+    PerfGrid grid(scenario.nx * scenario.nx, scenario.nLayers);
+    initialize(grid, scenario);
+
+    const Iterator::Duration dt = 3600;
+    DevStep step;
+    step.setFusedPhysics(scenario.fused);
+    step.setInitialData(grid);
+    step.start(0);
+    // One untimed step to allocate the reused buffers
+    step.iterate(dt);
+
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < nRepeats; ++r) {
+        Timer::main.tick(name);
+        for (int s = 0; s < scenario.nSteps; ++s) {
+            step.iterate(dt);
+        }
+        best = std::min(best, Timer::main.lap(name));
+        Timer::main.tock(name);
+    }
+    return best / scenario.nSteps;
+}
+
+static std::map<std::string, double> readBaselines(const std::string& filePath)
+{
+    std::map<std::string, double> baselines;
+    std::ifstream file(filePath);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+        std::istringstream fields(line);
+        std::string name;
+        double seconds;
+        if (!(fields >> name >> seconds)) {
+            throw std::runtime_error("Malformed baseline in " + filePath + ": " + line);
+        }
+        baselines[name] = seconds;
+    }
+    return baselines;
+}
+
+// Replaces or adds the baseline of one scenario, preserving the rest of the file
+static void writeBaseline(const std::string& filePath, const std::string& name, double seconds)
+{
+    std::vector<std::string> lines;
+    bool replaced = false;
+    {
+        std::ifstream file(filePath);
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string lineName;
+            if (!line.empty() && line[0] != '#' && (fields >> lineName) && lineName == name) {
+                if (replaced)
+                    continue;
+                std::ostringstream newLine;
+                newLine << name << " " << std::setprecision(6) << seconds;
+                line = newLine.str();
+                replaced = true;
+            }
+            lines.push_back(line);
+        }
+    }
+    if (!replaced) {
+        std::ostringstream newLine;
+        newLine << name << " " << std::setprecision(6) << seconds;
+        lines.push_back(newLine.str());
+    }
+    std::ofstream file(filePath);
+    if (!file) {
+        throw std::runtime_error("Cannot write baselines to " + filePath);
+    }
+    for (auto& line : lines) {
+        file << line << std::endl;
+    }
+}
+
+} /* namespace Nextsim */
+
+// Runs the suite as given by the command line, returning the exit code
+static int runSuite(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+    using namespace Nextsim;
+
+    po::options_description opt("neXtSIM_DG performance suite options:");
+    // clang-format off
+    opt.add_options()
+            ("help,h", "print help message")
+            ("list", "list the scenarios")
+            ("scenario", po::value<std::vector<std::string>>()->multitoken(),
+                    "scenarios to run (default all)")
+            ("baselines", po::value<std::string>(), "file of baseline timings")
+            ("tolerance", po::value<double>()->default_value(0.2),
+                    "allowed fractional slowdown relative to the baseline")
+            ("repeats", po::value<int>()->default_value(5), "timed repetitions of each scenario")
+            ("update", "record the timings as the new baselines")
+            ;
+    // clang-format on
+    po::variables_map arguments;
+    po::store(po::parse_command_line(argc, argv, opt), arguments);
+
+    if (arguments.count("help")) {
+        std::cerr << opt << std::endl;
+        return EXIT_SUCCESS;
+    }
+    if (arguments.count("list")) {
+        for (auto& scenario : scenarios) {
+            std::cout << scenario.first << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::vector<std::string> names;
+    if (arguments.count("scenario")) {
+        names = arguments["scenario"].as<std::vector<std::string>>();
+    } else {
+        for (auto& scenario : scenarios) {
+            names.push_back(scenario.first);
+        }
+    }
+    std::string baselinesPath
+        = arguments.count("baselines") ? arguments["baselines"].as<std::string>() : "";
+    double tolerance = arguments["tolerance"].as<double>();
+    int nRepeats = arguments["repeats"].as<int>();
+    bool update = arguments.count("update");
+    if (tolerance < 0 || nRepeats < 1) {
+        std::cerr << "The tolerance must be non-negative and the repeats positive" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (update && baselinesPath.empty()) {
+        std::cerr << "--update requires --baselines" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Messages logged during the timed timesteps are not wanted here
+    Logged::setMinimumLevel(Logged::WARNING);
+
+    std::map<std::string, double> baselines;
+    if (!baselinesPath.empty()) {
+        baselines = readBaselines(baselinesPath);
+    }
+
+    bool regressed = false;
+    bool missing = false;
+    for (auto& name : names) {
+        auto iter = scenarios.find(name);
+        if (iter == scenarios.end()) {
+            std::cerr << "Unknown scenario " << name << std::endl;
+            return EXIT_FAILURE;
+        }
+        double seconds = runScenario(name, iter->second, nRepeats);
+        std::cout << name << ": " << std::setprecision(4) << seconds * 1e3 << " ms per step";
+
+        if (update) {
+            writeBaseline(baselinesPath, name, seconds);
+            std::cout << " (recorded as baseline)" << std::endl;
+            continue;
+        }
+        auto baseline = baselines.find(name);
+        if (baseline == baselines.end()) {
+            std::cout << " (no baseline)" << std::endl;
+            missing = true;
+            continue;
+        }
+        double change = seconds / baseline->second - 1;
+        std::cout << ", " << std::showpos << change * 100 << std::noshowpos
+                  << "% relative to baseline " << baseline->second * 1e3 << " ms";
+        if (change > tolerance) {
+            std::cout << ": REGRESSION, exceeds tolerance of " << tolerance * 100 << "%";
+            regressed = true;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << Timer::main << std::endl;
+
+    if (regressed)
+        return EXIT_FAILURE;
+    return missing ? skipCode : EXIT_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+    // The structures and reductions of a build with MPI call it
+#ifdef USE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    int result = runSuite(argc, argv);
+#ifdef USE_MPI
+    MPI_Finalize();
+#endif
+    return result;
+}
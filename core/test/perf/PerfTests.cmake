@@ -0,0 +1,26 @@
+# Writes the ctest declarations of the performance suite, one test per
+# scenario listed by the suite. Run after each build of the suite with
+#   PERF_SUITE       the suite executable
+#   PERF_TESTS_FILE  the file of test declarations to write
+#   PERF_BASELINES   the file of baseline timings
+#   PERF_TOLERANCE   the allowed fractional slowdown
+
+execute_process(COMMAND "${PERF_SUITE}" --list
+    OUTPUT_VARIABLE scenarios
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Listing the performance scenarios failed: ${result}")
+endif()
+
+string(REGEX REPLACE "\n$" "" scenarios "${scenarios}")
+string(REPLACE "\n" ";" scenarios "${scenarios}")
+
+set(tests "")
+foreach(scenario ${scenarios})
+    string(APPEND tests
+        "add_test(\"perf_${scenario}\" \"${PERF_SUITE}\" --scenario \"${scenario}\""
+        " --baselines \"${PERF_BASELINES}\" --tolerance \"${PERF_TOLERANCE}\")\n"
+        "set_tests_properties(\"perf_${scenario}\" PROPERTIES LABELS performance"
+        " RUN_SERIAL TRUE SKIP_RETURN_CODE 77)\n")
+endforeach()
+file(WRITE "${PERF_TESTS_FILE}" "${tests}")
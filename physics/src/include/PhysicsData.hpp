@@ -8,6 +8,7 @@
 #define SRC_INCLUDE_PHYSICSDATA_HPP
 
 #include "include/BaseElementData.hpp"
+#include "include/ExternalData.hpp"
 #include "include/IPrognosticUpdater.hpp"
 #include "include/PrognosticData.hpp"
 
@@ -33,6 +34,12 @@ public:
         , m_hi_new(0)
         , m_hs(0)
         , m_TiceNew(nIceLayers, 0.)
+        , m_Qoce(0)
+        , m_Qio(0)
+        , m_evap(0)
+        , m_newice(0)
+        , m_derivedFrom(nullptr)
+        , m_derivedVersion(0)
     {
     }
 
@@ -67,6 +74,8 @@ public:
 
     //! Updated value of the ice surface temperature [˚C]
     inline double& updatedIceSurfaceTemperature() { return m_TiceNew[0]; }
+    //! Updated value of the ice temperature of a layer [˚C]. Layer 0 is the surface.
+    inline double& updatedIceTemperature(int layer) { return m_TiceNew[layer]; }
     //! Updated layer-wise ice temperatures [˚C]
     const std::vector<double>& updatedIceTemperatures() const override { return m_TiceNew; };
 
@@ -75,6 +84,41 @@ public:
     //! Updated value of the ice concentration [1]
     double updatedIceConcentration() const override { return m_conc_new; }
 
+    //! Net heat flux out of the ocean, averaged over the element [W m⁻²]
+    inline double& oceanHeatFlux() { return m_Qoce; }
+    //! Net heat flux out of the ocean, averaged over the element [W m⁻²]
+    inline const double& oceanHeatFlux() const { return m_Qoce; }
+
+    //! Heat flux from the ocean into the ice, over the ice covered fraction [W m⁻²]
+    inline double& iceOceanHeatFlux() { return m_Qio; }
+    //! Heat flux from the ocean into the ice, over the ice covered fraction [W m⁻²]
+    inline const double& iceOceanHeatFlux() const { return m_Qio; }
+    //! Evaporation rate from the open water [kg m⁻² s⁻¹]
+    inline double& evaporationRate() { return m_evap; }
+    //! Evaporation rate from the open water [kg m⁻² s⁻¹]
+    inline const double& evaporationRate() const { return m_evap; }
+    //! Thickness of new ice formed on the open water over the timestep [m]
+    inline double& newIceThickness() { return m_newice; }
+    //! Thickness of new ice formed on the open water over the timestep [m]
+    inline const double& newIceThickness() const { return m_newice; }
+
+    /*!
+     * @brief Returns whether the quantities derived only from the external
+     * data need to be recalculated.
+     *
+     * @param exter The ExternalData the quantities are derived from.
+     */
+    inline bool externalDataChanged(const ExternalData& exter) const
+    {
+        return (m_derivedFrom != &exter) || (m_derivedVersion != exter.version());
+    }
+    //! Records that the quantities derived only from the external data are up to date.
+    inline void setExternalDataCurrent(const ExternalData& exter)
+    {
+        m_derivedFrom = &exter;
+        m_derivedVersion = exter.version();
+    }
+
 private:
     double m_rho;
     double m_wspeed;
@@ -89,6 +133,15 @@ private:
     double m_hs;
     std::vector<double> m_TiceNew;
     double m_conc_new; // updated ice concentration
+    double m_Qoce; // net heat flux out of the ocean [W m⁻²]
+    // Fluxes passed to a coupled ocean
+    double m_Qio; // ice-ocean heat flux [W m⁻²]
+    double m_evap; // open water evaporation [kg m⁻² s⁻¹]
+    double m_newice; // new ice thickness [m]
+
+    // The external data that the cached derived values were calculated from
+    const ExternalData* m_derivedFrom;
+    unsigned long m_derivedVersion;
 };
 
 } /* namespace Nextsim */
@@ -0,0 +1,145 @@
+/*!
+ * @file TridiagonalSolver.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef PHYSICS_SRC_INCLUDE_TRIDIAGONALSOLVER_HPP
+#define PHYSICS_SRC_INCLUDE_TRIDIAGONALSOLVER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Declares that a pointer does not alias any other, where the compiler supports it
+#ifndef NEXTSIM_RESTRICT
+#if defined(__GNUC__) || defined(__clang__)
+#define NEXTSIM_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define NEXTSIM_RESTRICT __restrict
+#else
+#define NEXTSIM_RESTRICT
+#endif
+#endif
+
+namespace Nextsim {
+
+/*!
+ * @brief A batch of tridiagonal systems of equations of the same size, solved
+ * together by the Thomas algorithm.
+ *
+ * @details The coefficients are stored layer-major: the value for row k of
+ * column i is stored at index k * nColumns() + i. The forward and backward
+ * sweeps of the Thomas algorithm run over the rows, with the innermost loop
+ * over the contiguous columns, so that the compiler can vectorize the solution
+ * across columns. Row k of each system is
+ *
+ *     lower(k) x(k-1) + diag(k) x(k) + upper(k) x(k+1) = rhs(k)
+ *
+ * where lower(0) and upper(nRows()-1) are ignored. No pivoting is performed,
+ * so the systems should be diagonally dominant, as those of implicit heat
+ * conduction are.
+ *
+ * The coefficients are stored in vectors using the given allocator.
+ */
+template <class Allocator> class BasicTridiagonalBatch {
+public:
+    explicit BasicTridiagonalBatch(const Allocator& allocator = Allocator())
+        : BasicTridiagonalBatch(0, 0, allocator)
+    {
+    }
+    BasicTridiagonalBatch(
+        std::size_t nRows, std::size_t nColumns, const Allocator& allocator = Allocator())
+        : m_lower(allocator)
+        , m_diag(allocator)
+        , m_upper(allocator)
+        , m_rhs(allocator)
+    {
+        resize(nRows, nColumns);
+    }
+
+    //! Resizes the batch. The contents of the arrays are not preserved.
+    void resize(std::size_t nRows, std::size_t nColumns)
+    {
+        m_nRows = nRows;
+        m_nColumns = nColumns;
+        std::size_t n = nRows * nColumns;
+        m_lower.resize(n);
+        m_diag.resize(n);
+        m_upper.resize(n);
+        m_rhs.resize(n);
+    }
+
+    //! The number of rows of each system.
+    std::size_t nRows() const { return m_nRows; }
+    //! The number of systems in the batch.
+    std::size_t nColumns() const { return m_nColumns; }
+
+    //! Sub-diagonal coefficient of row k of column i.
+    double& lower(std::size_t k, std::size_t i) { return m_lower[k * m_nColumns + i]; }
+    //! Diagonal coefficient of row k of column i.
+    double& diag(std::size_t k, std::size_t i) { return m_diag[k * m_nColumns + i]; }
+    //! Super-diagonal coefficient of row k of column i.
+    double& upper(std::size_t k, std::size_t i) { return m_upper[k * m_nColumns + i]; }
+    //! Right hand side of row k of column i. Holds the solution after solve().
+    double& rhs(std::size_t k, std::size_t i) { return m_rhs[k * m_nColumns + i]; }
+    //! Solution for row k of column i, valid after solve().
+    double solution(std::size_t k, std::size_t i) const { return m_rhs[k * m_nColumns + i]; }
+
+    /*!
+     * @brief Solves all of the systems in the batch.
+     *
+     * @details The solution overwrites the right hand sides and the
+     * super-diagonal coefficients are overwritten by the elimination.
+     */
+    void solve()
+    {
+        const std::size_t nc = m_nColumns;
+        const double* NEXTSIM_RESTRICT a = m_lower.data();
+        const double* NEXTSIM_RESTRICT b = m_diag.data();
+        double* NEXTSIM_RESTRICT c = m_upper.data();
+        double* NEXTSIM_RESTRICT d = m_rhs.data();
+
+        if (m_nRows == 0)
+            return;
+        // Forward elimination, normalizing each row by its diagonal
+        for (std::size_t i = 0; i < nc; ++i) {
+            double rb = 1. / b[i];
+            c[i] *= rb;
+            d[i] *= rb;
+        }
+        for (std::size_t k = 1; k < m_nRows; ++k) {
+            const std::size_t row = k * nc;
+            const std::size_t prev = row - nc;
+            for (std::size_t i = 0; i < nc; ++i) {
+                double rb = 1. / (b[row + i] - a[row + i] * c[prev + i]);
+                c[row + i] *= rb;
+                d[row + i] = (d[row + i] - a[row + i] * d[prev + i]) * rb;
+            }
+        }
+        // Back substitution
+        for (std::size_t k = m_nRows - 1; k > 0; --k) {
+            const std::size_t row = (k - 1) * nc;
+            const std::size_t next = row + nc;
+            for (std::size_t i = 0; i < nc; ++i) {
+                d[row + i] -= c[row + i] * d[next + i];
+            }
+        }
+    }
+
+private:
+    std::size_t m_nRows;
+    std::size_t m_nColumns;
+    std::vector<double, Allocator> m_lower;
+    std::vector<double, Allocator> m_diag;
+    std::vector<double, Allocator> m_upper;
+    std::vector<double, Allocator> m_rhs;
+};
+
+//! A batch of tridiagonal systems with storage from the heap.
+typedef BasicTridiagonalBatch<std::allocator<double>> TridiagonalBatch;
+
+} /* namespace Nextsim */
+
+#endif /* PHYSICS_SRC_INCLUDE_TRIDIAGONALSOLVER_HPP */
@@ -22,8 +22,11 @@ namespace Nextsim {
 const double ICE_ALBEDO0 = 0.538;
 const double SNOW_ALBEDO0 = 0.8256;
 
-double CCSMIceAlbedo::iceAlbedo = ICE_ALBEDO0;
-double CCSMIceAlbedo::snowAlbedo = SNOW_ALBEDO0;
+CCSMIceAlbedo::CCSMIceAlbedo()
+    : iceAlbedo(ICE_ALBEDO0)
+    , snowAlbedo(SNOW_ALBEDO0)
+{
+}
 
 double CCSMIceAlbedo::albedo(double temperature, double snowThickness)
 {
@@ -35,6 +38,31 @@ double CCSMIceAlbedo::albedo(double temperature, double snowThickness)
     return snowCoverFraction * snowAlbedoT + (1 - snowCoverFraction) * iceAlbedoT;
 }
 
+void CCSMIceAlbedo::blockAlbedo(
+    const double* temperature, const double* snowThickness, double* albedo, std::size_t n)
+{
+    const double tLimit = -1.;
+    // Copies of the configured albedos, which cannot alias the output
+    const double iceAlbedo0 = iceAlbedo;
+    const double snowAlbedo0 = snowAlbedo;
+    for (std::size_t i = 0; i < n; ++i) {
+        /*
+         * Limiting the reduced albedo to the configured albedo gives the same
+         * value as limiting the reduction to zero with std::fmax, including
+         * for NaN. Selecting between values which are always calculated
+         * keeps the loop free of branches.
+         */
+        const double iceReducedAlbedo = iceAlbedo0 - 0.075 * (temperature[i] - tLimit);
+        const double snowReducedAlbedo = snowAlbedo0 - 0.124 * (temperature[i] - tLimit);
+        const double iceAlbedoT = (iceReducedAlbedo < iceAlbedo0) ? iceReducedAlbedo : iceAlbedo0;
+        const double snowAlbedoT
+            = (snowReducedAlbedo < snowAlbedo0) ? snowReducedAlbedo : snowAlbedo0;
+        const double snowCoverFraction = snowThickness[i] / (snowThickness[i] + 0.02);
+
+        albedo[i] = snowCoverFraction * snowAlbedoT + (1 - snowCoverFraction) * iceAlbedoT;
+    }
+}
+
 void CCSMIceAlbedo::configure()
 {
     iceAlbedo = Configured::getConfiguration("CCSMIceAlbedo.iceAlbedo", ICE_ALBEDO0);
@@ -10,42 +10,68 @@
 #include "include/ExternalData.hpp"
 #include "include/PhysicsData.hpp"
 #include "include/PrognosticData.hpp"
+#include <algorithm>
 #include <cmath>
 
+#include "include/BasicIceOceanHeatFlux.hpp"
+#include "include/HiblerConcentration.hpp"
 #include "include/IConcentrationModel.hpp"
 #include "include/IIceAlbedo.hpp"
 #include "include/IIceOceanHeatFlux.hpp"
 #include "include/IThermodynamics.hpp"
+#include "include/ThermoIce0.hpp"
 
 #include "include/ModuleLoader.hpp"
+#include "include/Reproducibility.hpp"
 
 #include "include/constants.hpp"
 
 namespace Nextsim {
 
-NextsimPhysics::SpecificHumidity NextsimPhysics::specHumWater;
-NextsimPhysics::SpecificHumidityIce NextsimPhysics::specHumIce;
-double NextsimPhysics::dragOcean_q;
-double NextsimPhysics::dragOcean_t;
-double NextsimPhysics::dragIce_t;
-double NextsimPhysics::m_oceanAlbedo;
-double NextsimPhysics::m_I0;
-double NextsimPhysics::minc;
-double NextsimPhysics::minh;
-
-IIceOceanHeatFlux* NextsimPhysics::iceOceanHeatFluxImpl = nullptr;
-IIceAlbedo* NextsimPhysics::iIceAlbedoImpl = nullptr;
-IThermodynamics* NextsimPhysics::iThermo = nullptr;
-IConcentrationModel* NextsimPhysics::iConcentrationModelImpl = nullptr;
+const NextsimPhysics::SpecificHumidity NextsimPhysics::specHumWater;
+const NextsimPhysics::SpecificHumidityIce NextsimPhysics::specHumIce;
 
 double stefanBoltzmannLaw(double temperature);
+double updateThickness(double& thick, double oldConc, double deltaC, double deltaV);
+
+// The snow thickness determining the albedo of the ice surface
+static double albedoSnowThickness(const PrognosticData& prog)
+{
+    return (prog.iceConcentration() > 0) ? (prog.snowThickness() / prog.iceConcentration()) : 0.;
+}
 
 NextsimPhysics::NextsimPhysics()
+    : NextsimPhysics(defaultContext())
+{
+}
+
+NextsimPhysics::NextsimPhysics(const std::shared_ptr<Context>& context)
     : m_Qio(0)
     , m_newice(0)
+    , m_context(context)
+{
+}
+
+NextsimPhysics::Context::Context()
+    : dragOcean_q(0)
+    , dragOcean_t(0)
+    , dragIce_t(0)
+    , oceanAlbedo(0)
+    , I0(0)
+    , minc(0)
+    , minh(0)
+    , fusable(false)
 {
 }
 
+const std::shared_ptr<NextsimPhysics::Context>& NextsimPhysics::defaultContext()
+{
+    static const std::shared_ptr<Context> context = std::make_shared<Context>();
+    return context;
+}
+
+void NextsimPhysics::detachContext() { m_context = std::make_shared<Context>(); }
+
 template <>
 const std::map<int, std::string> Configured<NextsimPhysics>::keyMap = {
     { NextsimPhysics::DRAGOCEANQ_KEY, "nextsim_thermo.drag_ocean_q" },
@@ -60,26 +86,37 @@ const std::map<int, std::string> Configured<NextsimPhysics>::keyMap = {
 void NextsimPhysics::configure()
 {
     ModuleLoader& loader = ModuleLoader::getLoader();
+    Context& context = *m_context;
+
+    // New instances, so that the modules of different contexts are configured independently
+    context.iceOceanHeatFluxImpl = loader.getInstance<IIceOceanHeatFlux>();
+    tryConfigure(context.iceOceanHeatFluxImpl.get());
 
-    iceOceanHeatFluxImpl = &loader.getImplementation<IIceOceanHeatFlux>();
-    tryConfigure(iceOceanHeatFluxImpl);
+    context.iIceAlbedoImpl = loader.getInstance<IIceAlbedo>();
+    tryConfigure(context.iIceAlbedoImpl.get());
 
-    iIceAlbedoImpl = &loader.getImplementation<IIceAlbedo>();
-    tryConfigure(iIceAlbedoImpl);
+    context.iThermo = loader.getInstance<IThermodynamics>();
+    tryConfigure(context.iThermo.get());
 
-    iThermo = &loader.getImplementation<IThermodynamics>();
-    tryConfigure(iThermo);
+    context.iConcentrationModelImpl = loader.getInstance<IConcentrationModel>();
+    tryConfigure(context.iConcentrationModelImpl.get());
 
-    iConcentrationModelImpl = &loader.getImplementation<IConcentrationModel>();
-    tryConfigure(iConcentrationModelImpl);
+    context.dragOcean_q = Configured::getConfiguration(keyMap.at(DRAGOCEANQ_KEY), 1.5e-3);
+    context.dragOcean_t = Configured::getConfiguration(keyMap.at(DRAGOCEANT_KEY), 0.83e-3);
+    context.dragIce_t = Configured::getConfiguration(keyMap.at(DRAGICET_KEY), 1.3e-3);
+    context.oceanAlbedo = Configured::getConfiguration(keyMap.at(OCEANALBEDO_KEY), 0.07);
+    context.I0 = configuredI0();
+    context.minc = Configured::getConfiguration(keyMap.at(MINC_KEY), 1e-12);
+    context.minh = Configured::getConfiguration(keyMap.at(MINH_KEY), 0.01);
 
-    dragOcean_q = Configured::getConfiguration(keyMap.at(DRAGOCEANQ_KEY), 1.5e-3);
-    dragOcean_t = Configured::getConfiguration(keyMap.at(DRAGOCEANT_KEY), 0.83e-3);
-    dragIce_t = Configured::getConfiguration(keyMap.at(DRAGICET_KEY), 1.3e-3);
-    m_oceanAlbedo = Configured::getConfiguration(keyMap.at(OCEANALBEDO_KEY), 0.07);
-    m_I0 = Configured::getConfiguration(keyMap.at(I0_KEY), 0.17);
-    minc = Configured::getConfiguration(keyMap.at(MINC_KEY), 1e-12);
-    minh = Configured::getConfiguration(keyMap.at(MINH_KEY), 0.01);
+    context.fusable = dynamic_cast<ThermoIce0*>(context.iThermo.get())
+        && dynamic_cast<BasicIceOceanHeatFlux*>(context.iceOceanHeatFluxImpl.get())
+        && dynamic_cast<HiblerConcentration*>(context.iConcentrationModelImpl.get());
+}
+
+double NextsimPhysics::configuredI0()
+{
+    return Configured::getConfiguration(keyMap.at(I0_KEY), 0.17);
 }
 
 void NextsimPhysics::updateSpecificHumidityAir(const ExternalData& exter, PhysicsData& phys)
@@ -113,8 +150,145 @@ void NextsimPhysics::updateHeatCapacityWetAir(const ExternalData& exter, Physics
     phys.heatCapacityWetAir() = Air::cp + phys.specificHumidityAir() * Vapour::cp;
 };
 
+void NextsimPhysics::updateDerivedData(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+{
+    Reproducibility::Scope reproducible(prog.context().reproducible());
+    IPhysics1d::updateDerivedData(prog, exter, phys);
+}
+
 void NextsimPhysics::calculate(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+{
+    Reproducibility::Scope reproducible(prog.context().reproducible());
+    calculateFluxes(prog, exter, phys);
+    m_context->iThermo->calculate(prog, exter, phys, *this);
+    // Ice momentum fluxes are handled by the dynamics
+    massFluxIceOcean(prog, exter, phys);
+    storeCouplingFluxes(phys);
+}
+
+void NextsimPhysics::calculate(const std::vector<Column>& columns)
+{
+    if (columns.empty())
+        return;
+    // All the elements of a batch belong to the same model, so its setting
+    // is read once for the batch
+    Reproducibility::Scope reproducible(columns.front().prog->context().reproducible());
+
+    // Reused by each thread, so that calculating a block allocates nothing
+    // once the first block of its size has been calculated
+    thread_local std::vector<double> albedo;
+    albedo.resize(columns.size());
+    blockAlbedo(columns, albedo.data());
+    std::vector<IThermodynamics::Column> thermoColumns;
+    thermoColumns.reserve(columns.size());
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        const Column& column = columns[i];
+        NextsimPhysics& nsphys = dynamic_cast<NextsimPhysics&>(*column.impl);
+        nsphys.calculateFluxes(*column.prog, *column.exter, *column.phys, albedo[i]);
+        thermoColumns.push_back({ column.prog, column.exter, column.phys, &nsphys });
+    }
+
+    m_context->iThermo->calculate(thermoColumns);
+
+    for (auto& column : columns) {
+        NextsimPhysics* nsphys = static_cast<NextsimPhysics*>(column.impl);
+        nsphys->massFluxIceOcean(*column.prog, *column.exter, *column.phys);
+        nsphys->storeCouplingFluxes(*column.phys);
+    }
+}
+
+void NextsimPhysics::blockAlbedo(const std::vector<Column>& columns, double* albedo) const
+{
+    const std::size_t n = columns.size();
+    // Reused by each thread for all of its blocks
+    thread_local std::vector<double> temperature;
+    thread_local std::vector<double> snowThickness;
+    temperature.resize(n);
+    snowThickness.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        temperature[i] = columns[i].prog->iceTemperature(0);
+        snowThickness[i] = albedoSnowThickness(*columns[i].prog);
+    }
+    m_context->iIceAlbedoImpl->blockAlbedo(temperature.data(), snowThickness.data(), albedo, n);
+}
+
+void NextsimPhysics::storeCouplingFluxes(PhysicsData& phys) const
+{
+    phys.iceOceanHeatFlux() = m_Qio;
+    phys.evaporationRate() = m_evap;
+    phys.newIceThickness() = m_newice;
+}
+
+void NextsimPhysics::calculateFused(const std::vector<Column>& columns)
+{
+    const Context& context = *m_context;
+    if (!context.fusable) {
+        IPhysics1d::calculateFused(columns);
+        return;
+    }
+    if (columns.empty())
+        return;
+    Reproducibility::Scope reproducible(columns.front().prog->context().reproducible());
+
+    // The modules are of known classes, so that their calculations for each
+    // element can be inlined rather than called through the interfaces
+    const ThermoIce0& thermo = static_cast<const ThermoIce0&>(*context.iThermo);
+    const HiblerConcentration& concentration
+        = static_cast<const HiblerConcentration&>(*context.iConcentrationModelImpl);
+
+    // Reused by each thread for all of its tiles
+    thread_local std::vector<double> albedo;
+    albedo.resize(columns.size());
+    blockAlbedo(columns, albedo.data());
+
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        const Column& column = columns[i];
+        const PrognosticData& prog = *column.prog;
+        const ExternalData& exter = *column.exter;
+        PhysicsData& phys = *column.phys;
+        NextsimPhysics& nsphys = static_cast<NextsimPhysics&>(*column.impl);
+
+        nsphys.IPhysics1d::updateDerivedData(prog, exter, phys);
+        nsphys.calculateSurfaceFluxes(prog, exter, phys, albedo[i]);
+        // The ice-ocean heat flux, as heatFluxIceOcean()
+        nsphys.m_Qio = BasicIceOceanHeatFlux::flux(prog.seaSurfaceTemperature(),
+            prog.freezingPoint(), exter.mixedLayerBulkHeatCapacity(), prog.timestep());
+        thermo.calculateColumn(prog, exter, phys, nsphys);
+
+        // The mass flux, as massFluxIceOcean()
+        nsphys.newIceFormation(prog, exter, phys);
+        double del_c = concentration.freeze(nsphys.m_newice);
+        if (phys.updatedIceTrueThickness() < prog.iceTrueThickness()) {
+            del_c += concentration.melt(
+                prog.iceConcentration(), prog.iceTrueThickness(), phys.updatedIceTrueThickness());
+        }
+        nsphys.updateConcentration(prog, phys, del_c);
+        nsphys.applyLowerLimits(prog, phys);
+
+        nsphys.storeCouplingFluxes(phys);
+    }
+}
+
+void NextsimPhysics::calculateFluxes(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+{
+    calculateFluxes(prog, exter, phys,
+        m_context->iIceAlbedoImpl->albedo(prog.iceTemperature(0), albedoSnowThickness(prog)));
+}
+
+void NextsimPhysics::calculateFluxes(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys, double albedo)
+{
+    calculateSurfaceFluxes(prog, exter, phys, albedo);
+
+    // The mass flux is driven by the heat flux, so that is called first
+    heatFluxIceOcean(prog, exter, phys);
+}
+
+void NextsimPhysics::calculateSurfaceFluxes(
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys, double albedo)
 {
     massFluxOpenWater(phys);
     momentumFluxOpenWater(phys);
@@ -122,18 +296,16 @@ void NextsimPhysics::calculate(
 
     massFluxIceAtmosphere(prog, phys);
     // Ice momentum fluxes are handled by the dynamics
-    heatFluxIceAtmosphere(prog, exter, phys);
+    heatFluxIceAtmosphere(prog, exter, phys, albedo);
 
-    // The mass flux is driven by the heat flux, so that is called first
-    heatFluxIceOcean(prog, exter, phys);
-    // Ice momentum fluxes are handled by the dynamics
-    massFluxIceOcean(prog, exter, phys);
+    m_hifroms = 0;
 }
 
 void NextsimPhysics::massFluxOpenWater(PhysicsData& phys)
 {
     double specificHumidityDifference = phys.specificHumidityWater() - phys.specificHumidityAir();
-    m_evap = dragOcean_q * phys.airDensity() * phys.windSpeed() * specificHumidityDifference;
+    m_evap = m_context->dragOcean_q * phys.airDensity() * phys.windSpeed()
+        * specificHumidityDifference;
 }
 
 void NextsimPhysics::momentumFluxOpenWater(PhysicsData& phys)
@@ -148,11 +320,11 @@ void NextsimPhysics::heatFluxOpenWater(
     m_Qlhow = m_evap * latentHeatWater(prog.seaSurfaceTemperature());
 
     // Sensible heat flux
-    m_Qshow = dragOcean_t * phys.airDensity() * phys.heatCapacityWetAir() * phys.windSpeed()
-        * (prog.seaSurfaceTemperature() - exter.airTemperature());
+    m_Qshow = m_context->dragOcean_t * phys.airDensity() * phys.heatCapacityWetAir()
+        * phys.windSpeed() * (prog.seaSurfaceTemperature() - exter.airTemperature());
 
     // Shortwave flux
-    m_Qswow = -exter.incomingShortwave() * (1 - m_oceanAlbedo);
+    m_Qswow = -exter.incomingShortwave() * (1 - m_context->oceanAlbedo);
 
     // Longwave flux
     m_Qlwow = stefanBoltzmannLaw(prog.seaSurfaceTemperature()) - exter.incomingLongwave();
@@ -163,13 +335,15 @@ void NextsimPhysics::heatFluxOpenWater(
 
 void NextsimPhysics::massFluxIceAtmosphere(const PrognosticData& prog, PhysicsData& phys)
 {
-    m_subl = dragIce_t * phys.airDensity() * phys.windSpeed()
+    m_subl = m_context->dragIce_t * phys.airDensity() * phys.windSpeed()
         * (phys.specificHumidityIce() - phys.specificHumidityAir());
 }
 
 void NextsimPhysics::heatFluxIceAtmosphere(
-    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
+    const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys, double albedo)
 {
+    const double dragIce_t = m_context->dragIce_t;
+
     // Latent heat flux from sublimation
     m_Qlhi = m_subl * latentHeatIce(prog.iceTemperature(0));
     double dmdot_dT = dragIce_t * phys.airDensity() * phys.windSpeed()
@@ -182,14 +356,12 @@ void NextsimPhysics::heatFluxIceAtmosphere(
     double dQsh_dT = dragIce_t * phys.airDensity() * phys.heatCapacityWetAir() * phys.windSpeed();
 
     // Shortwave flux
-    double albedoValue = iIceAlbedoImpl->albedo(prog.iceTemperature(0),
-        (prog.iceConcentration() > 0) ? (prog.snowThickness() / prog.iceConcentration()) : 0.);
-    m_Qswi = -exter.incomingShortwave() * (1. - m_I0) * (1 - albedoValue);
+    m_Qswi = -exter.incomingShortwave() * (1. - m_context->I0) * (1 - albedo);
 
     // Longwave flux
     m_Qlwi = stefanBoltzmannLaw(prog.iceTemperature(0)) - exter.incomingLongwave();
     double dQlw_dT
-        = 4 / kelvin(prog.iceTemperature(0)) * stefanBoltzmannLaw(prog.iceTemperatures()[0]);
+        = 4 / kelvin(prog.iceTemperature(0)) * stefanBoltzmannLaw(prog.iceTemperature(0));
 
     // Total flux
     m_Qia = m_Qlhi + m_Qshi + m_Qlwi + m_Qswi;
@@ -200,15 +372,19 @@ void NextsimPhysics::heatFluxIceAtmosphere(
 void NextsimPhysics::massFluxIceOcean(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
 {
-    m_hifroms = 0;
-
-    iThermo->calculate(prog, exter, phys, *this);
+    // The ice thermodynamics has already been calculated
     newIceFormation(prog, exter, phys);
 
     lateralGrowth(prog, exter, phys);
 
+    applyLowerLimits(prog, phys);
+}
+
+void NextsimPhysics::applyLowerLimits(const PrognosticData& prog, PhysicsData& phys)
+{
     // Apply the lower limit of concentration and thickness
-    if (phys.updatedIceConcentration() < minc || phys.updatedIceTrueThickness() < minh) {
+    if (phys.updatedIceConcentration() < m_context->minc
+        || phys.updatedIceTrueThickness() < m_context->minh) {
         m_Qow += phys.updatedIceConcentration() * Water::Lf
             * (phys.updatedIceTrueThickness() * Ice::rho
                 + phys.updatedSnowTrueThickness() * Ice::rhoSnow)
@@ -217,12 +393,16 @@ void NextsimPhysics::massFluxIceOcean(
         phys.updatedIceTrueThickness() = 0;
         phys.updatedSnowTrueThickness() = 0;
     }
+
+    // Heat lost by the open water and ice covered parts of the ocean
+    phys.oceanHeatFlux()
+        = (1 - prog.iceConcentration()) * m_Qow + prog.iceConcentration() * m_Qio;
 }
 
 void NextsimPhysics::heatFluxIceOcean(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
 {
-    m_Qio = iceOceanHeatFluxImpl->flux(prog, exter, phys, *this);
+    m_Qio = m_context->iceOceanHeatFluxImpl->flux(prog, exter, phys, *this);
 }
 
 void NextsimPhysics::newIceFormation(
@@ -240,7 +420,8 @@ void NextsimPhysics::newIceFormation(
     // Final temperature
     double t1 = t0 + deltaTml;
 
-    // deal with cooling below the freezing point
+    // No new ice unless the mixed layer cools below the freezing point
+    m_newice = 0;
     if (t1 < tf) {
         // Heat lost cooling the mixed layer to freezing point
         double sensibleFlux = (tf - t0) / deltaTml * coolingFlux;
@@ -263,17 +444,23 @@ void NextsimPhysics::lateralGrowth(
     const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
 {
     NextsimPhysics& nsphys = *this;
-    double del_c = 0; // Change in concentration due to lateral growth
-    del_c += iConcentrationModelImpl->freeze(prog, phys, nsphys);
+    const IConcentrationModel& concentrationModel = *m_context->iConcentrationModelImpl;
+    // Change in concentration due to lateral growth
+    double del_c = concentrationModel.freeze(prog, phys, nsphys);
     if (phys.updatedIceTrueThickness() < prog.iceTrueThickness()) {
-        del_c += iConcentrationModelImpl->melt(prog, phys, nsphys);
+        del_c += concentrationModel.melt(prog, phys, nsphys);
     }
+    updateConcentration(prog, phys, del_c);
+}
 
+void NextsimPhysics::updateConcentration(
+    const PrognosticData& prog, PhysicsData& phys, double del_c)
+{
     // Correct the ice thickness, snow thickness and open water flux based on the change in
     // concentration
     phys.updatedIceConcentration() = prog.iceConcentration() + del_c;
 
-    if (phys.updatedIceConcentration() >= minc) {
+    if (phys.updatedIceConcentration() >= m_context->minc) {
         // The updated ice thickness must conserve volume
         updateThickness(phys.updatedIceTrueThickness(), prog.iceConcentration(), del_c, m_newice);
 
@@ -358,12 +545,12 @@ double NextsimPhysics::SpecificHumidityIce::dq_dT(
 {
     double df_dT = 2 * m_bigC * m_bigB * temperature;
     double numerator = m_b * m_c * m_d - temperature * (2 * m_c + temperature);
-    double denominator = m_d * pow(m_c + temperature, 2);
+    double denominator = m_d * Reproducibility::pow(m_c + temperature, 2);
     double estCalc = est(temperature, 0);
     double fCalc = f(temperature, pressure);
     double dest_dT = numerator / denominator * estCalc;
     numerator = m_alpha * pressure * (fCalc * dest_dT + estCalc * df_dT);
-    denominator = pow(pressure - m_beta * estCalc * fCalc, 2);
+    denominator = Reproducibility::pow(pressure - m_beta * estCalc * fCalc, 2);
     return numerator / denominator;
 }
 
@@ -377,11 +564,12 @@ double NextsimPhysics::SpecificHumidity::f(const double temperature, const doubl
 double NextsimPhysics::SpecificHumidity::est(const double temperature, const double salinity) const
 {
     double salFactor = 1 - 5.37e-4 * salinity;
-    return m_a * exp((m_b - temperature / m_d) * temperature / (temperature + m_c)) * salFactor;
+    double exponent = (m_b - temperature / m_d) * temperature / (temperature + m_c);
+    return m_a * Reproducibility::exp(exponent) * salFactor;
 }
 
 double stefanBoltzmannLaw(double temperatureC)
 {
-    return Ice::epsilon * PhysicalConstants::sigma * std::pow(kelvin(temperatureC), 4);
+    return Ice::epsilon * PhysicalConstants::sigma * Reproducibility::pow(kelvin(temperatureC), 4);
 }
 } /* namespace Nextsim */
@@ -24,7 +24,23 @@ double SMU2IceAlbedo::albedo(double temperature, double snowThickness)
         return std::fmin(
             SNOW_ALBEDO, ICE_ALBEDO + (SNOW_ALBEDO - ICE_ALBEDO) * snowThickness / 0.2);
     } else {
-        return ICE_ALBEDO + 0.4 * (1 - ICE_ALBEDO) * NextsimPhysics::i0();
+        return ICE_ALBEDO + 0.4 * (1 - ICE_ALBEDO) * i0;
     }
 }
+
+void SMU2IceAlbedo::blockAlbedo(
+    const double*, const double* snowThickness, double* albedo, std::size_t n)
+{
+    const double bareIceAlbedo = ICE_ALBEDO + 0.4 * (1 - ICE_ALBEDO) * i0;
+    for (std::size_t i = 0; i < n; ++i) {
+        // Both branches are calculated and one selected. The comparison
+        // selects SNOW_ALBEDO for NaN, as std::fmin does.
+        const double snowAlbedo
+            = ICE_ALBEDO + (SNOW_ALBEDO - ICE_ALBEDO) * snowThickness[i] / 0.2;
+        const double limitedAlbedo = (snowAlbedo < SNOW_ALBEDO) ? snowAlbedo : SNOW_ALBEDO;
+        albedo[i] = (snowThickness[i] > 0.) ? limitedAlbedo : bareIceAlbedo;
+    }
+}
+
+void SMU2IceAlbedo::configure() { i0 = NextsimPhysics::configuredI0(); }
 }
@@ -21,7 +21,18 @@ double SMUIceAlbedo::albedo(double temperature, double snowThickness)
     if (snowThickness > 0.) {
         return SNOW_ALBEDO;
     } else {
-        return ICE_ALBEDO + 0.4 * (1 - ICE_ALBEDO) * NextsimPhysics::i0();
+        return ICE_ALBEDO + 0.4 * (1 - ICE_ALBEDO) * i0;
     }
 }
+
+void SMUIceAlbedo::blockAlbedo(
+    const double*, const double* snowThickness, double* albedo, std::size_t n)
+{
+    const double bareIceAlbedo = ICE_ALBEDO + 0.4 * (1 - ICE_ALBEDO) * i0;
+    for (std::size_t i = 0; i < n; ++i) {
+        albedo[i] = (snowThickness[i] > 0.) ? SNOW_ALBEDO : bareIceAlbedo;
+    }
+}
+
+void SMUIceAlbedo::configure() { i0 = NextsimPhysics::configuredI0(); }
 }
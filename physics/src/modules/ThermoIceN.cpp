@@ -0,0 +1,363 @@
+/*!
+ * @file ThermoIceN.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include "include/ThermoIceN.hpp"
+#include "include/Arena.hpp"
+
+#include "include/ExternalData.hpp"
+#include "include/NextsimPhysics.hpp"
+#include "include/PhysicsData.hpp"
+#include "include/PrognosticData.hpp"
+#include "include/TridiagonalSolver.hpp"
+
+#include "include/constants.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Nextsim {
+
+const int ThermoIceN::batchSize;
+
+// True constants
+static const double freezingPointIce = -Water::mu * Ice::s;
+static const double bulkLHFusionSnow = Water::Lf * Ice::rhoSnow;
+static const double bulkLHFusionIce = Water::Lf * Ice::rho;
+
+template <>
+const std::map<int, std::string> Configured<ThermoIceN>::keyMap = {
+    { ThermoIceN::KS_KEY, "thermoicen.ks" },
+    { ThermoIceN::FLOODING_KEY, "thermoicen.flooding" },
+};
+
+void ThermoIceN::configure()
+{
+    k_s = Configured::getConfiguration(keyMap.at(KS_KEY), 0.3096);
+    doFlooding = Configured::getConfiguration(keyMap.at(FLOODING_KEY), true);
+}
+
+// Sets the updated values for an element without ice
+static void setNoIce(PhysicsData& phys)
+{
+    phys.updatedIceTrueThickness() = 0;
+    phys.updatedSnowTrueThickness() = 0;
+    for (std::size_t i = 0; i < phys.updatedIceTemperatures().size(); ++i) {
+        phys.updatedIceTemperature(i) = freezingPointIce;
+    }
+}
+
+// Removes a thickness of ice from the top or the bottom of the sections
+static void removeThickness(
+    std::vector<ThermoIceN::Section>& sections, double thickness, bool fromTop)
+{
+    while (thickness > 0 && !sections.empty()) {
+        ThermoIceN::Section& section = fromTop ? sections.front() : sections.back();
+        if (section.thickness > thickness) {
+            section.thickness -= thickness;
+            return;
+        }
+        thickness -= section.thickness;
+        if (fromTop) {
+            sections.erase(sections.begin());
+        } else {
+            sections.pop_back();
+        }
+    }
+}
+
+void ThermoIceN::calculate(const PrognosticData& prog, const ExternalData& exter,
+    PhysicsData& phys, NextsimPhysics& nsphys)
+{
+    Column column = { &prog, &exter, &phys, &nsphys };
+    calculate(std::vector<Column>(1, column));
+}
+
+void ThermoIceN::calculate(const std::vector<Column>& columns)
+{
+    // Gather the ice covered elements into batches with the same number of layers
+    std::vector<Column> batch;
+    batch.reserve(std::min<std::size_t>(columns.size(), batchSize));
+    int batchLayers = 0;
+    for (auto& column : columns) {
+        const PrognosticData& prog = *column.prog;
+        if (prog.iceThickness() == 0 || prog.iceConcentration() == 0) {
+            setNoIce(*column.phys);
+            continue;
+        }
+        int nLayers = prog.nIceLayers();
+        if (!batch.empty() && (nLayers != batchLayers || batch.size() == batchSize)) {
+            calculateIceBatch(batch, batchLayers);
+            batch.clear();
+        }
+        batchLayers = nLayers;
+        batch.push_back(column);
+    }
+    if (!batch.empty()) {
+        calculateIceBatch(batch, batchLayers);
+    }
+}
+
+void ThermoIceN::calculateIceBatch(const std::vector<Column>& columns, int nLayers)
+{
+    const std::size_t nc = columns.size();
+    const int nIce = nLayers - 1; // Number of ice layers with heat capacity
+
+    /*
+     * The conductances between the temperature points, stored layer-major.
+     * Element k of a column is the conductance between point k and point k+1,
+     * with the point after the last being the base of the ice.
+     */
+    // The temporary arrays of the batch, from the scratch memory of the
+    // arena of this thread
+    ArenaAllocator<double> scratch(Arena::local(), Arena::scratch);
+    std::vector<double, ArenaAllocator<double>> conductance(nLayers * nc, 0., scratch);
+    // The heat capacity of each ice layer per unit time [W m⁻² K⁻¹]
+    std::vector<double, ArenaAllocator<double>> heatCapacity(nc, 0., scratch);
+    std::vector<double, ArenaAllocator<double>> meltingLimit(nc, 0., scratch);
+    std::vector<char, ArenaAllocator<char>> isMelting(nc, false, scratch);
+
+    for (std::size_t i = 0; i < nc; ++i) {
+        const PrognosticData& prog = *columns[i].prog;
+        double hice = prog.iceTrueThickness();
+        double hsnow = prog.snowTrueThickness();
+        if (nIce > 0) {
+            double layerThickness = hice / nIce;
+            conductance[i] = 1. / (hsnow / k_s + 0.5 * layerThickness / Ice::kappa);
+            for (int k = 1; k < nIce; ++k) {
+                conductance[k * nc + i] = Ice::kappa / layerThickness;
+            }
+            conductance[nIce * nc + i] = 2 * Ice::kappa / layerThickness;
+            heatCapacity[i] = Ice::rho * Ice::cp * layerThickness / prog.timestep();
+        } else {
+            // A single slab of snow and ice
+            conductance[i] = k_s * Ice::kappa / (k_s * hice + Ice::kappa * hsnow);
+        }
+        meltingLimit[i] = (hsnow > 0.) ? 0 : freezingPointIce;
+    }
+
+    BasicTridiagonalBatch<ArenaAllocator<double>> system(scratch);
+    // Fills the implicit heat conduction equations. The surface temperature
+    // of a melting element is fixed at the melting point.
+    auto fillSystem = [&]() {
+        system.resize(nLayers, nc);
+        for (std::size_t i = 0; i < nc; ++i) {
+            const PrognosticData& prog = *columns[i].prog;
+            const NextsimPhysics& nsphys = *columns[i].nsphys;
+            double g0 = conductance[i];
+            double tSurf = prog.iceTemperature(0);
+            double dQ_dT = nsphys.QDerivativeWRTTemperature();
+
+            // Linearized surface energy balance
+            system.lower(0, i) = 0;
+            if (isMelting[i]) {
+                system.diag(0, i) = 1;
+                system.upper(0, i) = 0;
+                system.rhs(0, i) = meltingLimit[i];
+            } else {
+                system.diag(0, i) = g0 + dQ_dT;
+                system.upper(0, i) = (nIce > 0) ? -g0 : 0;
+                system.rhs(0, i) = -nsphys.QIceAtmosphere() + dQ_dT * tSurf
+                    + ((nIce > 0) ? 0 : g0 * prog.freezingPoint());
+            }
+        }
+        for (int k = 1; k <= nIce; ++k) {
+            for (std::size_t i = 0; i < nc; ++i) {
+                double gAbove = conductance[(k - 1) * nc + i];
+                double gBelow = conductance[k * nc + i];
+                system.lower(k, i) = -gAbove;
+                system.diag(k, i) = heatCapacity[i] + gAbove + gBelow;
+                system.upper(k, i) = (k < nIce) ? -gBelow : 0;
+                system.rhs(k, i) = heatCapacity[i] * columns[i].prog->iceTemperature(k)
+                    + ((k < nIce) ? 0 : gBelow * columns[i].prog->freezingPoint());
+            }
+        }
+    };
+
+    fillSystem();
+    system.solve();
+
+    // Resolve the elements whose surface would be above the melting point
+    bool anyMelting = false;
+    for (std::size_t i = 0; i < nc; ++i) {
+        if (system.solution(0, i) > meltingLimit[i]) {
+            isMelting[i] = true;
+            anyMelting = true;
+        }
+    }
+    if (anyMelting) {
+        fillSystem();
+        system.solve();
+    }
+
+    // The sections and the remapped layers of a column, reused for every column
+    std::vector<Section> sections;
+    sections.reserve(nIce + 2);
+    std::vector<double> layers(nIce);
+    for (std::size_t i = 0; i < nc; ++i) {
+        const PrognosticData& prog = *columns[i].prog;
+        PhysicsData& phys = *columns[i].phys;
+        const NextsimPhysics& nsphys = *columns[i].nsphys;
+
+        double tSurf = system.solution(0, i);
+        double tFreeze = prog.freezingPoint();
+        double tBelowSurface = (nIce > 0) ? system.solution(1, i) : tFreeze;
+        double tAboveBase = system.solution(nIce, i);
+
+        // Energy left over at the surface after the surface temperature is
+        // limited to the melting point. Zero when the surface is not melting.
+        double surfaceExcessFlux = 0;
+        if (isMelting[i]) {
+            surfaceExcessFlux = conductance[i] * (tBelowSurface - tSurf)
+                - (nsphys.QIceAtmosphere()
+                    + nsphys.QDerivativeWRTTemperature() * (tSurf - prog.iceTemperature(0)));
+        }
+        double QIceConduction = conductance[nIce * nc + i] * (tFreeze - tAboveBase);
+
+        int nPhysLayers = std::min<int>(nLayers, phys.updatedIceTemperatures().size());
+        for (int k = 0; k < nPhysLayers; ++k) {
+            phys.updatedIceTemperature(k) = system.solution(k, i);
+        }
+
+        // The ice layers, with any heat above the melting point melting ice
+        sections.clear();
+        for (int k = 1; k <= nIce; ++k) {
+            sections.push_back({ prog.iceTrueThickness() / nIce, system.solution(k, i) });
+        }
+        phys.updatedIceTrueThickness() -= meltInterior(sections);
+
+        ThicknessChange change = updateThickness(columns[i], surfaceExcessFlux, QIceConduction);
+
+        if (nIce == 0 || nPhysLayers < nLayers || phys.updatedIceTrueThickness() <= 0)
+            continue;
+        // Apply the thickness changes to the sections, then remap them onto
+        // equal layers. New ice at the base forms at the freezing point, and
+        // flooded snow takes the temperature of the top of the ice.
+        removeThickness(sections, -change.surfaceMelt, true);
+        if (change.base >= 0) {
+            sections.push_back({ change.base, tFreeze });
+        } else {
+            removeThickness(sections, -change.base, false);
+        }
+        if (change.flooding > 0) {
+            double tTop = sections.empty() ? tFreeze : sections.front().temperature;
+            sections.insert(sections.begin(), { change.flooding, tTop });
+        }
+        remapLayers(sections, layers);
+        for (int k = 1; k <= nIce; ++k) {
+            phys.updatedIceTemperature(k) = layers[k - 1];
+        }
+    }
+}
+
+double ThermoIceN::meltInterior(std::vector<Section>& sections)
+{
+    double melted = 0;
+    for (auto& section : sections) {
+        if (section.temperature > freezingPointIce) {
+            // A section cannot melt more than its own ice
+            double melt = std::min(section.thickness,
+                section.thickness * Ice::cp * (section.temperature - freezingPointIce)
+                    / Water::Lf);
+            section.thickness -= melt;
+            section.temperature = freezingPointIce;
+            melted += melt;
+        }
+    }
+    return melted;
+}
+
+void ThermoIceN::remapLayers(
+    const std::vector<Section>& sections, std::vector<double>& temperatures)
+{
+    double total = 0;
+    for (auto& section : sections) {
+        total += section.thickness;
+    }
+    const std::size_t nLayers = temperatures.size();
+    if (total <= 0 || nLayers == 0)
+        return;
+    const double layerThickness = total / nLayers;
+    for (std::size_t l = 0; l < nLayers; ++l) {
+        double top = l * layerThickness;
+        double bottom = (l == nLayers - 1) ? total : (l + 1) * layerThickness;
+        // Integrate the temperature over the overlap of each section with the layer
+        double integral = 0;
+        double sectionTop = 0;
+        for (auto& section : sections) {
+            double sectionBottom = sectionTop + section.thickness;
+            double overlap = std::min(bottom, sectionBottom) - std::max(top, sectionTop);
+            if (overlap > 0)
+                integral += overlap * section.temperature;
+            sectionTop = sectionBottom;
+        }
+        temperatures[l] = integral / (bottom - top);
+    }
+}
+
+ThermoIceN::ThicknessChange ThermoIceN::updateThickness(
+    const Column& column, double surfaceExcessFlux, double QIceConduction)
+{
+    ThicknessChange change = { 0, 0, 0 };
+    const PrognosticData& prog = *column.prog;
+    const ExternalData& exter = *column.exter;
+    PhysicsData& phys = *column.phys;
+    NextsimPhysics& nsphys = *column.nsphys;
+
+    // Top melt. Melting rate is non-positive.
+    double snowMeltRate = std::min(-surfaceExcessFlux, 0.) / bulkLHFusionSnow; // [m s⁻¹]
+    double snowSublRate = nsphys.sublimationRate() / Ice::rhoSnow; // [m s⁻¹]
+
+    phys.updatedSnowTrueThickness() += (snowMeltRate - snowSublRate) * prog.timestep();
+    // Use excess flux to melt ice. Non-positive value
+    double excessIceMelt
+        = std::min(phys.updatedSnowTrueThickness(), 0.) * bulkLHFusionSnow / bulkLHFusionIce;
+    // With the excess flux noted, clamp the snow thickness to a minimum of zero.
+    phys.updatedSnowTrueThickness() = std::max(phys.updatedSnowTrueThickness(), 0.);
+    // Then add snowfall back on top
+    phys.updatedSnowTrueThickness() += exter.snowfall() * prog.timestep() / Ice::rhoSnow;
+
+    // Bottom melt or growth
+    double iceBottomChange
+        = (QIceConduction - nsphys.QIceOceanHeat()) * prog.timestep() / bulkLHFusionIce;
+    // Total thickness change
+    double iceThicknessChange = excessIceMelt + iceBottomChange;
+    phys.updatedIceTrueThickness() += iceThicknessChange;
+    change.surfaceMelt = excessIceMelt;
+    change.base = iceBottomChange;
+
+    // Snow to ice conversion
+    double iceDraught = (phys.updatedIceTrueThickness() * Ice::rho
+                            + phys.updatedSnowTrueThickness() * Ice::rhoSnow)
+        / Water::rhoOcean;
+    if (doFlooding && iceDraught > phys.updatedIceTrueThickness()) {
+        // Keep a running total of the ice formed from flooded snow
+        double newIce = iceDraught - phys.updatedIceTrueThickness();
+        nsphys.incrementTotalIceFromSnow(newIce);
+
+        // Convert all the submerged snow to ice
+        phys.updatedIceTrueThickness() = iceDraught;
+        phys.updatedSnowTrueThickness() -= newIce * Ice::rho / Ice::rhoSnow;
+        change.flooding = newIce;
+    }
+
+    if (phys.updatedIceTrueThickness() < nsphys.minimumIceThickness()) {
+        // No snow was converted to ice
+        nsphys.zeroTotalIceFromSnow();
+
+        // The ice-ocean flux includes all the latent heat
+        double deltaQio = phys.updatedIceTrueThickness() * bulkLHFusionIce / prog.timestep()
+            + phys.updatedSnowTrueThickness() * bulkLHFusionSnow / prog.timestep();
+        nsphys.incrementQIceOceanHeat(deltaQio);
+
+        // No ice, no snow and the ice temperature is the melting point of ice
+        setNoIce(phys);
+    }
+    return change;
+}
+
+} /* namespace Nextsim */
@@ -28,6 +28,25 @@ public:
      * (constant).
      */
     double flux(const PrognosticData&, const ExternalData&, const PhysicsData&, const NextsimPhysics&) override;
+
+    /*!
+     * @brief Calculate the basic ice-ocean heat flux from the values of one
+     * element, as used by flux() and the single pass kernel of
+     * NextsimPhysics.
+     *
+     * @param sst Sea surface temperature [˚C].
+     * @param tf Freezing point of the sea surface water [˚C].
+     * @param mlHeatCapacity Bulk heat capacity of the mixed layer [J K⁻¹ m⁻²].
+     * @param dt Timestep [s].
+     */
+    static inline double flux(double sst, double tf, double mlHeatCapacity, double dt)
+    {
+        // The ice bottom temperature is the freezing point of the surface seawater
+        double tDiff = sst - tf;
+
+        // Transfer rate depends on the mixed layer depth an d a timescale. Here, it is the timestep
+        return tDiff * mlHeatCapacity / dt;
+    }
 };
 
 } /* namespace Nextsim */
@@ -16,6 +16,8 @@ namespace Nextsim {
 //! The implementation class for the CCSM calculation of ice surface albedo.
 class CCSMIceAlbedo : public IIceAlbedo, public Configured<CCSMIceAlbedo> {
 public:
+    CCSMIceAlbedo();
+
     /*!
      * @brief Calculates the CCSM ice surface short wave albedo.
      *
@@ -23,12 +25,15 @@ public:
      * @param snowThickness The true snow thickness on top of the ice.
      */
     double albedo(double temperature, double snowThickness) override;
+    //! Calculates the albedos of a block of ice surfaces, as albedo().
+    void blockAlbedo(const double* temperature, const double* snowThickness, double* albedo,
+        std::size_t n) override;
 
     void configure() override;
 
 private:
-    static double iceAlbedo;
-    static double snowAlbedo;
+    double iceAlbedo;
+    double snowAlbedo;
 };
 
 }
@@ -16,7 +16,12 @@ namespace Nextsim {
 //! The implementation class of Hibler's model of ice concentration.
 class HiblerConcentration : public IConcentrationModel, public Configured<HiblerConcentration> {
 public:
-    HiblerConcentration() = default;
+    HiblerConcentration()
+        : h0(0)
+        , ooh0(0)
+        , phiM(0)
+    {
+    }
     virtual ~HiblerConcentration() = default;
 
     //! Configure the parameters of the model.
@@ -45,16 +50,50 @@ public:
      */
     double melt(const PrognosticData&, PhysicsData&, NextsimPhysics&) const override;
 
+    /*!
+     * @brief Calculates the change in concentration due to freezing from the
+     * values of one element, as used by freeze() and the single pass kernel
+     * of NextsimPhysics.
+     *
+     * @param newIce The thickness of new ice formed on open water [m].
+     */
+    inline double freeze(double newIce) const { return newIce * ooh0; }
+    /*!
+     * @brief Calculates the change in concentration due to melting from the
+     * values of one element, as used by melt() and the single pass kernel of
+     * NextsimPhysics.
+     *
+     * @param cice Ice concentration at the start of the timestep [1].
+     * @param hiOld Ice true thickness at the start of the timestep [m].
+     * @param hi Updated ice true thickness [m].
+     */
+    inline double melt(double cice, double hiOld, double hi) const
+    {
+        if (cice >= 1)
+            return 0;
+        double del_hi = hi - hiOld;
+        return del_hi * cice * phiM / hiOld;
+    }
+
     /*!
      * @brief Sets the value of the h0 parameter.
      *
      * @param h0_in The value of the h0 parameter to be set.
      */
-    inline static void setH0(double h0_in) { h0 = h0_in; };
+    inline void setH0(double h0_in)
+    {
+        h0 = h0_in;
+        ooh0 = 1. / h0;
+    };
+    //! Returns the thickness of newly formed ice, the h0 parameter [m].
+    inline double getH0() const { return h0; };
+    //! Returns the melt shape parameter phiM [1].
+    inline double getPhiM() const { return phiM; };
 
 private:
-    static double h0;
-    static double phiM;
+    double h0;
+    double ooh0; // The reciprocal of h0, calculated when h0 is set
+    double phiM;
 };
 
 } /* namespace Nextsim */
@@ -8,6 +8,8 @@
 #ifndef SRC_INCLUDE_IICEALBEDO_HPP
 #define SRC_INCLUDE_IICEALBEDO_HPP
 
+#include <cstddef>
+
 namespace Nextsim {
 //! The interface class for ice albedo calculation.
 class IIceAlbedo {
@@ -21,6 +23,26 @@ public:
      * @param snowThickness The true snow thickness on top of the ice.
      */
     virtual double albedo(double temperature, double snowThickness) = 0;
+    /*!
+     * @brief Calculates the ice surface short wave albedo of a block of
+     * surfaces.
+     *
+     * @details The default implementation calls albedo() for each surface.
+     * Implementations override it with a loop without branches or calls,
+     * which the compiler can vectorize, giving the same values as albedo().
+     *
+     * @param temperature The temperatures of the ice surfaces.
+     * @param snowThickness The true snow thicknesses on top of the ice.
+     * @param albedo The albedos of the surfaces, written by the function.
+     * @param n The number of surfaces.
+     */
+    virtual void blockAlbedo(
+        const double* temperature, const double* snowThickness, double* albedo, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            albedo[i] = this->albedo(temperature[i], snowThickness[i]);
+        }
+    }
 };
 }
 #endif /* SRC_INCLUDE_IICEALBEDO_HPP */
@@ -11,6 +11,9 @@
 #include "include/PhysicsData.hpp"
 #include "include/PrognosticData.hpp"
 
+#include <cstddef>
+#include <vector>
+
 namespace Nextsim {
 
 class ExternalData;
@@ -20,11 +23,26 @@ class IPhysics1d {
 public:
     virtual ~IPhysics1d() = default;
 
+    /*!
+     * @brief The data of one element, as used in a batch calculation.
+     *
+     * @details impl is the physics implementation instance of the element,
+     * which holds the per-element intermediate values of the calculation.
+     */
+    struct Column {
+        const PrognosticData* prog;
+        const ExternalData* exter;
+        PhysicsData* phys;
+        IPhysics1d* impl;
+    };
+
     /*!
      * @brief Updates any derived quantities in PhysicsData.
      *
      * @details This function is declared virtual to be overridden if the implementing class needs to update
-     * any class specific derived data.
+     * any class specific derived data. The quantities which depend only on
+     * the external data (air specific humidity, air density and heat
+     * capacity) are only recalculated when the external data has changed.
      *
      * @param prog PrognosticData for this element (constant).
      * @param exter ExternalData for this element (constant).
@@ -33,13 +51,15 @@ public:
     virtual void updateDerivedData(
         const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys)
     {
-        updateSpecificHumidityAir(exter, phys);
+        if (phys.externalDataChanged(exter)) {
+            updateSpecificHumidityAir(exter, phys);
+            updateAirDensity(exter, phys);
+            updateHeatCapacityWetAir(exter, phys);
+            phys.setExternalDataCurrent(exter);
+        }
         updateSpecificHumidityWater(prog, exter, phys);
         updateSpecificHumidityIce(prog, exter, phys);
 
-        updateAirDensity(exter, phys);
-        updateHeatCapacityWetAir(exter, phys);
-
         phys.updatedSnowTrueThickness() = prog.snowTrueThickness();
         phys.updatedIceTrueThickness() = prog.iceTrueThickness();
     };
@@ -56,6 +76,77 @@ public:
      */
     virtual void calculate(const PrognosticData&, const ExternalData&, PhysicsData&) = 0;
 
+    /*!
+     * @brief Performs the 1d physics calculation for a batch of elements.
+     *
+     * @details The default implementation calls calculate() on the
+     * implementation instance of each element in turn. All of the
+     * implementation instances in the batch must be of the same class as
+     * this instance.
+     *
+     * @param columns The data of the elements to be calculated.
+     */
+    virtual void calculate(const std::vector<Column>& columns)
+    {
+        for (auto& column : columns) {
+            column.impl->calculate(*column.prog, *column.exter, *column.phys);
+        }
+    }
+
+    /*!
+     * @brief Updates the derived data and performs the 1d physics calculation
+     * for a batch of elements in a single pass.
+     *
+     * @details The result is the same as calling updateDerivedData() on each
+     * element followed by calculate() on the batch. Implementations may
+     * override this to calculate each element completely while its data is
+     * in cache, which is worthwhile when the batch is a small tile of
+     * elements. The default implementation makes the separate calls.
+     *
+     * @param columns The data of the elements to be calculated.
+     */
+    virtual void calculateFused(const std::vector<Column>& columns)
+    {
+        for (auto& column : columns) {
+            column.impl->updateDerivedData(*column.prog, *column.exter, *column.phys);
+        }
+        calculate(columns);
+    }
+
+    //! Returns whether calculateFused() has a single pass implementation.
+    virtual bool hasFusedKernel() const { return false; }
+
+    /*!
+     * @brief Returns the size in bytes of a new instance of the implementing
+     * class, or zero if the class cannot be constructed by constructAt().
+     *
+     * @details Implementations which can be constructed in place allow the
+     * per-element instances to be allocated from an arena rather than
+     * separately from the heap.
+     */
+    virtual std::size_t instanceSize() const { return 0; }
+
+    /*!
+     * @brief Constructs a new default instance of the implementing class in
+     * the given memory.
+     *
+     * @param storage At least instanceSize() bytes of memory with the
+     * alignment of std::max_align_t.
+     * @return The new instance, or nullptr if instanceSize() is zero.
+     */
+    virtual IPhysics1d* constructAt(void* /*storage*/) const { return nullptr; }
+
+    /*!
+     * @brief Gives this instance a configuration of its own.
+     *
+     * @details Implementations whose instances share their parameters and
+     * modules override this, so that the configuration of this instance is
+     * independent of that of any existing instance. The instances
+     * constructed from this one by constructAt() share the new
+     * configuration. The default implementation does nothing.
+     */
+    virtual void detachContext() { }
+
 protected:
     /*!
      * @brief A virtual function that calculates the specific humidity in the
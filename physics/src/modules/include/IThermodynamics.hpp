@@ -8,6 +8,8 @@
 #ifndef SRC_INCLUDE_ITHERMODYNAMICS_HPP
 #define SRC_INCLUDE_ITHERMODYNAMICS_HPP
 
+#include <vector>
+
 namespace Nextsim {
 class PrognosticData;
 class PhysicsData;
@@ -19,6 +21,14 @@ class IThermodynamics {
 public:
     virtual ~IThermodynamics() = default;
 
+    //! The data of one element, as used in a batch calculation.
+    struct Column {
+        const PrognosticData* prog;
+        const ExternalData* exter;
+        PhysicsData* phys;
+        NextsimPhysics* nsphys;
+    };
+
     /*!
      * @brief Calculate the ice thermodynamics.
      *
@@ -30,6 +40,22 @@ public:
     virtual void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys,
         NextsimPhysics& nsphys)
         = 0;
+
+    /*!
+     * @brief Calculate the ice thermodynamics for a batch of elements.
+     *
+     * @details The default implementation calculates the elements one at a
+     * time. Implementations which can share work between elements, such as
+     * solving many columns at once, should override this function.
+     *
+     * @param columns The data of the elements to be calculated.
+     */
+    virtual void calculate(const std::vector<Column>& columns)
+    {
+        for (auto& column : columns) {
+            calculate(*column.prog, *column.exter, *column.phys, *column.nsphys);
+        }
+    }
 };
 
 }
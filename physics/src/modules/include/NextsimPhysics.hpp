@@ -7,6 +7,8 @@
 #ifndef SRC_INCLUDE_NEXTSIMPHYSICS_HPP
 #define SRC_INCLUDE_NEXTSIMPHYSICS_HPP
 #include <memory>
+#include <new>
+#include <vector>
 
 #include "include/BaseElementData.hpp"
 #include "include/Configured.hpp"
@@ -29,6 +31,14 @@ class ElementData;
 
 class NextsimPhysics;
 
+/*!
+ * @brief The NeXtSIM column physics.
+ *
+ * @details The parameters and the module instances are held in a context
+ * shared by the instance from which the per-element instances are
+ * constructed and those instances. Instances constructed directly share a
+ * default context, so that configuring any of them configures them all.
+ */
 class NextsimPhysics : public BaseElementData,
                        public Configured<NextsimPhysics>,
                        public IPhysics1d {
@@ -46,7 +56,56 @@ public:
         MINH_KEY,
     };
 
+    /*!
+     * @brief Updates any derived quantities in PhysicsData.
+     *
+     * @details As IPhysics1d::updateDerivedData(), with the reproducibility
+     * setting of the model of the element. The same setting applies to each
+     * of the calculations below.
+     */
+    void updateDerivedData(
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys) override;
     void calculate(const PrognosticData&, const ExternalData&, PhysicsData&) override;
+    /*!
+     * @brief Performs the 1d physics calculation for a batch of elements.
+     *
+     * @details The surface fluxes of all elements are calculated first, then
+     * the ice thermodynamics is calculated for the whole batch at once, then
+     * the new ice formation and lateral growth of each element.
+     *
+     * @param columns The data of the elements. Every impl must be a
+     * NextsimPhysics instance.
+     */
+    void calculate(const std::vector<Column>& columns) override;
+    /*!
+     * @brief Updates the derived data and performs the 1d physics calculation
+     * for a batch of elements in a single pass.
+     *
+     * @details Each element is calculated from the derived data through the
+     * fluxes, thermodynamics and lateral growth to the updated values before
+     * moving to the next. This is a specialization for ThermoIce0,
+     * BasicIceOceanHeatFlux and HiblerConcentration, whose calculations for
+     * a single element are called directly rather than through their
+     * interfaces. The calculation of each element is otherwise that of the
+     * modular calculation, including the intermediate values held by the
+     * instances, so the results are identical. With any other modules the
+     * modular calculation is used.
+     *
+     * @param columns The data of the elements. Every impl must be a
+     * NextsimPhysics instance.
+     */
+    void calculateFused(const std::vector<Column>& columns) override;
+    //! Returns whether the configured modules allow the single pass calculation.
+    bool hasFusedKernel() const override { return m_context->fusable; }
+
+    std::size_t instanceSize() const override { return sizeof(NextsimPhysics); }
+    //! Constructs an instance sharing the context of this instance.
+    IPhysics1d* constructAt(void* storage) const override
+    {
+        return new (storage) NextsimPhysics(m_context);
+    }
+    //! Gives this instance a new, unconfigured, context.
+    void detachContext() override;
 
     //! Calculate the new ice formed this timestep on open water
     void newIceFormation(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
@@ -74,11 +133,13 @@ public:
     inline void incrementTotalIceFromSnow(double delta_hifroms) { m_hifroms += delta_hifroms; };
 
     //! Minimum ice concentration [1]
-    static double minimumIceConcentration() { return minc; };
+    double minimumIceConcentration() const { return m_context->minc; };
     //! Minimum ice thickness [m]
-    static double minimumIceThickness() { return minh; };
+    double minimumIceThickness() const { return m_context->minh; };
     //! I0 parameter
-    static double i0() { return m_I0; };
+    double i0() const { return m_context->I0; };
+    //! Returns the configured value of the I0 parameter, as used by the albedo schemes.
+    static double configuredI0();
 
     // A class encapsulating the calculation of specific humidity.
     class SpecificHumidity {
@@ -204,6 +265,44 @@ protected:
     void updateHeatCapacityWetAir(const ExternalData& exter, PhysicsData& phys) override;
 
 private:
+    // The parameters and modules shared by the instances of one model
+    struct Context {
+        Context();
+
+        double dragOcean_q;
+        double dragOcean_t;
+        double dragIce_t;
+        double oceanAlbedo;
+        double I0;
+        double minc; // minimum ice concentration
+        double minh; // minimum ice true thickness [m]
+
+        // Ice-ocean heat flux
+        std::unique_ptr<IIceOceanHeatFlux> iceOceanHeatFluxImpl;
+        std::unique_ptr<IIceAlbedo> iIceAlbedoImpl;
+        std::unique_ptr<IThermodynamics> iThermo;
+        std::unique_ptr<IConcentrationModel> iConcentrationModelImpl;
+
+        // Whether the configured modules are those built into calculateFused()
+        bool fusable;
+    };
+
+    NextsimPhysics(const std::shared_ptr<Context>& context);
+    // The context of directly constructed instances
+    static const std::shared_ptr<Context>& defaultContext();
+
+    void calculateFluxes(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+    void calculateFluxes(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys,
+        double albedo);
+    // The open water and ice-atmosphere fluxes, without the ice-ocean flux
+    void calculateSurfaceFluxes(const PrognosticData& prog, const ExternalData& exter,
+        PhysicsData& phys, double albedo);
+    // Calculates the ice albedo of each column by the block interface of the
+    // albedo module, into an array of one value per column
+    void blockAlbedo(const std::vector<Column>& columns, double* albedo) const;
+    // Copies the fluxes passed to a coupled ocean to the PhysicsData
+    void storeCouplingFluxes(PhysicsData& phys) const;
+
     void massFluxOpenWater(PhysicsData& phys);
     void momentumFluxOpenWater(PhysicsData& phys);
     void heatFluxOpenWater(
@@ -211,10 +310,15 @@ private:
 
     void massFluxIceAtmosphere(const PrognosticData& prog, PhysicsData& phys);
     void heatFluxIceAtmosphere(
-        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+        const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys, double albedo);
     void massFluxIceOcean(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
     void heatFluxIceOcean(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
     void lateralGrowth(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys);
+    // Updates the concentration and thicknesses for a change in concentration
+    void updateConcentration(const PrognosticData& prog, PhysicsData& phys, double del_c);
+    // Removes ice below the minimum concentration or thickness, and
+    // calculates the heat flux out of the ocean
+    void applyLowerLimits(const PrognosticData& prog, PhysicsData& phys);
 
     // Phase change rates
     double m_evap;
@@ -244,33 +348,19 @@ private:
     // Thickness of ice generated from flooding of snow [m]
     double m_hifroms;
 
-    static double dragOcean_q;
-    static double dragOcean_m(double windSpeed);
-    static double dragOcean_t;
-    static double dragIce_t;
-
-    static double m_oceanAlbedo;
-
-    // Ice-ocean heat flux
-    static IIceOceanHeatFlux* iceOceanHeatFluxImpl;
     // New ice created by cooling below freezing
     double m_newice;
 
-    static IConcentrationModel* iConcentrationModelImpl;
+    std::shared_ptr<Context> m_context;
 
-    static double m_I0;
+    static double dragOcean_m(double windSpeed);
 
     static double latentHeatWater(double temperature);
     static double latentHeatIce(double temperature);
 
-    static double minc; // minimum ice concentration
-    static double minh; // minimum ice true thickness [m]
-
-    static SpecificHumidity specHumWater;
-    static SpecificHumidityIce specHumIce;
-
-    static IIceAlbedo* iIceAlbedoImpl;
-    static IThermodynamics* iThermo;
+    // Constant after construction, so shared by all contexts
+    static const SpecificHumidity specHumWater;
+    static const SpecificHumidityIce specHumIce;
 };
 
 } /* namespace Nextsim */
@@ -8,13 +8,24 @@
 #ifndef SRC_INCLUDE_SMU2ICEALBEDO_HPP
 #define SRC_INCLUDE_SMU2ICEALBEDO_HPP
 
+#include "include/Configured.hpp"
 #include "IIceAlbedo.hpp"
 
 namespace Nextsim {
 
 //! The implementation class for the SMU calculation of ice surface albedo
 // with variable snow albedo.
-class SMU2IceAlbedo : public IIceAlbedo {
+class SMU2IceAlbedo : public IIceAlbedo, public Configured<SMU2IceAlbedo> {
+public:
+    SMU2IceAlbedo()
+        : i0(0)
+    {
+    }
+
+    //! Configures the I0 parameter of the physics, on which the bare ice albedo depends.
+    void configure() override;
+
+private:
     /*!
      * @brief Calculates the SMU ice surface short wave albedo with constant
      * snow albedo.
@@ -23,6 +34,11 @@ class SMU2IceAlbedo : public IIceAlbedo {
      * @param snowThickness The true snow thickness on top of the ice.
      */
     double albedo(double temperature, double snowThickness);
+    //! Calculates the albedos of a block of ice surfaces, as albedo().
+    void blockAlbedo(const double* temperature, const double* snowThickness, double* albedo,
+        std::size_t n) override;
+
+    double i0;
 };
 
 }
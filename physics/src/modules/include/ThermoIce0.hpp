@@ -9,19 +9,25 @@
 #define SRC_INCLUDE_THERMOICE0_HPP_
 
 #include "include/Configured.hpp"
+#include "include/ExternalData.hpp"
+#include "include/NextsimPhysics.hpp"
+#include "include/PhysicsData.hpp"
+#include "include/PrognosticData.hpp"
+#include "include/constants.hpp"
 #include "IThermodynamics.hpp"
 
-namespace Nextsim {
+#include <algorithm>
 
-class PrognosticData;
-class PhysicsData;
-class ExternalData;
-class NextsimPhysics;
+namespace Nextsim {
 
 //! The implementation class for the NeXtSIM therm0 ice thermodynamics.
 class ThermoIce0 : public IThermodynamics, public Configured<ThermoIce0> {
 public:
-    ThermoIce0() = default;
+    ThermoIce0()
+        : k_s(0)
+        , doFlooding(true)
+    {
+    }
     virtual ~ThermoIce0() = default;
 
     void configure() override;
@@ -41,11 +47,131 @@ public:
     void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys,
         NextsimPhysics& nsphys) override;
 
+    /*!
+     * @brief Calculate the NeXtSIM thermo0 ice thermodynamics of one element.
+     *
+     * @details The calculation of calculate(), defined here so that it can
+     * be inlined into the single pass kernel of NextsimPhysics.
+     *
+     * @param prog PrognosticData for this element (constant)
+     * @param exter ExternalData for this element (constant)
+     * @param phys PhysicsData for this element
+     * @param nsphys Nextsim physics implementation data for this element.
+     */
+    inline void calculateColumn(const PrognosticData& prog, const ExternalData& exter,
+        PhysicsData& phys, NextsimPhysics& nsphys) const;
+
+    //! Thermal conductivity of snow [W m⁻¹ K⁻¹]
+    double snowConductivity() const { return k_s; }
+    //! Whether snow submerged below the waterline is converted to ice
+    bool flooding() const { return doFlooding; }
+
 private:
-    static double k_s;
-    static bool doFlooding;
+    double k_s;
+    bool doFlooding;
 };
 
+void ThermoIce0::calculateColumn(const PrognosticData& prog, const ExternalData& exter,
+    PhysicsData& phys, NextsimPhysics& nsphys) const
+{
+    // True constants
+    const double freezingPointIce = -Water::mu * Ice::s;
+    const double bulkLHFusionSnow = Water::Lf * Ice::rhoSnow;
+    const double bulkLHFusionIce = Water::Lf * Ice::rho;
+
+    // Initialize the updated snow thickness
+    // phys.updatedSnowTrueThickness() = prog.snowTrueThickness();
+
+    if (prog.iceThickness() == 0 || prog.iceConcentration() == 0) {
+        phys.updatedIceTrueThickness() = 0;
+        phys.updatedSnowTrueThickness() = 0;
+        phys.updatedIceSurfaceTemperature() = freezingPointIce;
+
+        return;
+    }
+
+    double oldIceThickness = prog.iceTrueThickness();
+
+    double iceTemperature = prog.iceTemperature(0);
+    double tBot = prog.freezingPoint();
+    // Heat transfer coefficient
+    double k_lSlab = k_s * Ice::kappa
+        / (k_s * prog.iceTrueThickness() + Ice::kappa * prog.snowTrueThickness());
+    double QIceConduction = k_lSlab * (tBot - iceTemperature);
+    double remainingFlux = QIceConduction - nsphys.QIceAtmosphere();
+    phys.updatedIceSurfaceTemperature()
+        = iceTemperature + remainingFlux / (k_lSlab + nsphys.QDerivativeWRTTemperature());
+
+    // Clamp the maximum temperature of the ice to the melting point of ice or snow
+    double meltingLimit = (prog.snowTrueThickness() > 0.) ? 0 : freezingPointIce;
+    phys.updatedIceSurfaceTemperature()
+        = std::min(meltingLimit, phys.updatedIceSurfaceTemperature());
+
+    // Top melt. Melting rate is non-positive.
+    double snowMeltRate = std::min(-remainingFlux, 0.) / bulkLHFusionSnow; // [m³ s⁻¹]
+    double snowSublRate = nsphys.sublimationRate() / Ice::rhoSnow; // [m³ s⁻¹]
+
+    phys.updatedSnowTrueThickness() += (snowMeltRate - snowSublRate) * prog.timestep();
+    // Use excess flux to melt ice. Non-positive value
+    double excessIceMelt
+        = std::min(phys.updatedSnowTrueThickness(), 0.) * bulkLHFusionSnow / bulkLHFusionIce;
+    // With the excess flux noted, clamp the snow thickness to a minimum of zero.
+    phys.updatedSnowTrueThickness() = std::max(phys.updatedSnowTrueThickness(), 0.);
+    // Then add snowfall back on top
+    phys.updatedSnowTrueThickness() += exter.snowfall() * prog.timestep() / Ice::rhoSnow;
+
+    // Bottom melt or growth
+    double iceBottomChange
+        = (QIceConduction - nsphys.QIceOceanHeat()) * prog.timestep() / bulkLHFusionIce;
+    // Total thickness change
+    double iceThicknessChange = excessIceMelt + iceBottomChange;
+    phys.updatedIceTrueThickness() += iceThicknessChange;
+
+    // Amount of melting (only) at the top and bottom of the ice
+    double topMelt = std::min(excessIceMelt, 0.);
+    double botMelt = std::min(iceBottomChange, 0.);
+
+    // Snow to ice conversion
+    double iceDraught = (phys.updatedIceTrueThickness() * Ice::rho
+                            + phys.updatedSnowTrueThickness() * Ice::rhoSnow)
+        / Water::rhoOcean;
+    if (doFlooding && iceDraught > phys.updatedIceTrueThickness()) {
+        // Keep a running total of the ice formed from flooded snow
+        double newIce = iceDraught - phys.updatedIceTrueThickness();
+        nsphys.incrementTotalIceFromSnow(newIce);
+
+        // Convert all the submerged snow to ice
+        phys.updatedIceTrueThickness() = iceDraught;
+        phys.updatedSnowTrueThickness() -= newIce * Ice::rho / Ice::rhoSnow;
+    }
+
+    if (phys.updatedIceTrueThickness() < nsphys.minimumIceThickness()) {
+        // Reduce the melting to reach zero thickness, while keeping the
+        // between top and bottom melting
+        if (iceThicknessChange < 0) {
+            double scaling = -oldIceThickness / iceThicknessChange;
+            topMelt *= scaling;
+            botMelt *= scaling;
+        }
+
+        // No snow was converted to ice
+        nsphys.zeroTotalIceFromSnow();
+
+        // Change in thickness is all of the old thickness
+        iceThicknessChange = -oldIceThickness;
+
+        // The ice-ocean flux includes all the latent heat
+        double deltaQio = phys.updatedIceTrueThickness() * bulkLHFusionIce / prog.timestep()
+            + phys.updatedSnowTrueThickness() * bulkLHFusionSnow / prog.timestep();
+        nsphys.incrementQIceOceanHeat(deltaQio);
+
+        // No ice, no snow and the surface temperature is the melting point of ice
+        phys.updatedIceTrueThickness() = 0;
+        phys.updatedSnowTrueThickness() = 0;
+        phys.updatedIceSurfaceTemperature() = freezingPointIce;
+    }
+}
+
 } /* namespace Nextsim */
 
 #endif /* SRC_INCLUDE_THERMOICE0_HPP_ */
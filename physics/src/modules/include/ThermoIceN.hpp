@@ -0,0 +1,138 @@
+/*!
+ * @file ThermoIceN.hpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#ifndef SRC_INCLUDE_THERMOICEN_HPP
+#define SRC_INCLUDE_THERMOICEN_HPP
+
+#include "include/Configured.hpp"
+#include "IThermodynamics.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+class PrognosticData;
+class PhysicsData;
+class ExternalData;
+class NextsimPhysics;
+
+/*!
+ * @brief The implementation class for multi-layer ice thermodynamics.
+ *
+ * @details A Winton-style layered ice model. With n ice temperature layers,
+ * element 0 of the ice temperatures is the temperature of the (snow or ice)
+ * surface, which has no heat capacity, and elements 1 to n-1 are the
+ * temperatures at the centres of n-1 ice layers of equal thickness. The base
+ * of the ice is at the freezing point of the sea water. Heat conduction
+ * through the snow and ice is calculated implicitly, with the surface energy
+ * balance linearized about the current surface temperature. The surface
+ * temperature is limited to the melting point, with any excess energy
+ * melting snow and then ice. The interior layers are limited to the melting
+ * point of ice, with the excess heat melting the layer. After the surface
+ * melt, basal growth or melt and snow-ice formation, the layer temperatures
+ * are remapped onto equal layers of the new thickness, conserving the
+ * enthalpy of the column. A single layer reduces to a zero-layer slab, as in
+ * ThermoIce0.
+ *
+ * The tridiagonal systems of many elements are solved at once when the
+ * elements are calculated as a batch.
+ */
+class ThermoIceN : public IThermodynamics, public Configured<ThermoIceN> {
+public:
+    ThermoIceN()
+        : k_s(0)
+        , doFlooding(true)
+    {
+    }
+    virtual ~ThermoIceN() = default;
+
+    void configure() override;
+    enum {
+        KS_KEY,
+        FLOODING_KEY,
+    };
+
+    /*!
+     * @brief Calculate the multi-layer ice thermodynamics of one element.
+     *
+     * @param prog PrognosticData for this element (constant)
+     * @param exter ExternalData for this element (constant)
+     * @param phys PhysicsData for this element
+     * @param nsphys Nextsim physics implementation data for this element.
+     */
+    void calculate(const PrognosticData& prog, const ExternalData& exter, PhysicsData& phys,
+        NextsimPhysics& nsphys) override;
+
+    /*!
+     * @brief Calculate the multi-layer ice thermodynamics of a batch of
+     * elements, solving the heat conduction of the elements together.
+     *
+     * @param columns The data of the elements to be calculated.
+     */
+    void calculate(const std::vector<Column>& columns) override;
+
+    //! The maximum number of elements whose heat conduction is solved together.
+    static const int batchSize = 256;
+
+    //! A section of the ice of a column, of uniform temperature.
+    struct Section {
+        double thickness; //!< The thickness of the section [m]
+        double temperature; //!< The temperature of the section [˚C]
+    };
+
+    /*!
+     * @brief Limits the temperature of each section to the melting point of
+     * ice, melting the ice of the section with the excess heat.
+     *
+     * @details The enthalpy of ice at temperature T, relative to water at the
+     * melting point T_m, is ρ(c_p(T - T_m) - L_f) per unit volume, so a
+     * section of thickness h above the melting point melts a thickness of
+     * h c_p (T - T_m) / L_f and is left at the melting point. Together with
+     * the meltwater at the melting point, the enthalpy is unchanged.
+     *
+     * @param sections The sections of the column, from top to bottom.
+     * @return The total thickness of ice melted [m].
+     */
+    static double meltInterior(std::vector<Section>& sections);
+
+    /*!
+     * @brief Remaps sections of a column onto layers of equal thickness,
+     * conserving the enthalpy of the column.
+     *
+     * @details With a constant density and heat capacity of the ice, the
+     * temperature of each layer is the thickness weighted mean temperature of
+     * the parts of the sections which it overlaps.
+     *
+     * @param sections The sections of the column, from top to bottom.
+     * @param temperatures The temperatures of the layers, from top to bottom.
+     * The size sets the number of layers.
+     */
+    static void remapLayers(
+        const std::vector<Section>& sections, std::vector<double>& temperatures);
+
+private:
+    // Calculates a batch of ice-covered columns with the same number of layers
+    void calculateIceBatch(const std::vector<Column>& columns, int nLayers);
+    // The changes of the ice thickness of a column over a timestep [m]
+    struct ThicknessChange {
+        double surfaceMelt; // Ice melted at the surface, non-positive
+        double base; // Growth (positive) or melt (negative) at the base
+        double flooding; // Snow converted to ice at the surface, non-negative
+    };
+
+    // Updates the snow and ice thicknesses from the fluxes at the ice
+    // surfaces, returning the changes of the ice thickness
+    ThicknessChange updateThickness(
+        const Column& column, double surfaceExcessFlux, double QIceConduction);
+
+    double k_s;
+    bool doFlooding;
+};
+
+} /* namespace Nextsim */
+
+#endif /* SRC_INCLUDE_THERMOICEN_HPP */
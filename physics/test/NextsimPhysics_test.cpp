@@ -8,12 +8,19 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch.hpp>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "include/ConfiguredModule.hpp"
 #include "include/ElementData.hpp"
 #include "include/IIceAlbedo.hpp"
+#include "include/CCSMIceAlbedo.hpp"
 #include "include/ModuleLoader.hpp"
 #include "include/NextsimPhysics.hpp"
+#include "include/Reproducibility.hpp"
+#include "include/SMU2IceAlbedo.hpp"
+#include "include/SMUIceAlbedo.hpp"
+#include "include/ThermoIceN.hpp"
 #include "include/constants.hpp"
 
 namespace Nextsim {
@@ -36,12 +43,14 @@ TEST_CASE("Minimum ice & i0", "[NextsimPhysics]")
     std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
     Configurator::addStream(std::move(pcstream));
 
+    // The physics creates instances of its modules as it is configured
+    ModuleLoader::getLoader().setAllDefaults();
     NextsimPhysics nsphys;
     nsphys.configure();
 
-    REQUIRE(NextsimPhysics::minimumIceConcentration() == minConc);
-    REQUIRE(NextsimPhysics::minimumIceThickness() == minThck);
-    REQUIRE(NextsimPhysics::i0() == i0);
+    REQUIRE(nsphys.minimumIceConcentration() == minConc);
+    REQUIRE(nsphys.minimumIceThickness() == minThck);
+    REQUIRE(nsphys.i0() == i0);
 }
 
 TEST_CASE("Update derived data", "[NextsimPhysics]")
@@ -63,9 +72,9 @@ TEST_CASE("Update derived data", "[NextsimPhysics]")
     double cice = 0.5;
 
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(0.).tice(tice);
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
 
     NextsimPhysics nsData;
     nsData.updateDerivedData(data, data, data);
@@ -75,6 +84,19 @@ TEST_CASE("Update derived data", "[NextsimPhysics]")
     REQUIRE(0.00349446 == Approx(data.specificHumidityWater()).epsilon(1e-4));
     REQUIRE(0.00323958 == Approx(data.specificHumidityIce()).epsilon(1e-4));
     REQUIRE(1011.81 == Approx(data.heatCapacityWetAir()).epsilon(1e-4));
+
+    // Without a change in the external data, the air values are not
+    // recalculated, even when it has been read through a non-const reference
+    data.airDensity() = 0;
+    REQUIRE(data.airPressure() == pair);
+    nsData.updateDerivedData(data, data, data);
+    REQUIRE(data.airDensity() == 0);
+    REQUIRE(0.00349446 == Approx(data.specificHumidityWater()).epsilon(1e-4));
+
+    // Setting any external value recalculates them
+    data.setAirPressure(pair);
+    nsData.updateDerivedData(data, data, data);
+    REQUIRE(1.29253 == Approx(data.airDensity()).epsilon(1e-4));
 }
 
 TEST_CASE("New ice formation", "[NextsimPhysics]")
@@ -105,12 +127,12 @@ TEST_CASE("New ice formation", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(0.).tice(tice);
     data.setTimestep(86400.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 0;
-    data.incomingShortwave() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(0);
+    data.setIncomingShortwave(0);
 
     NextsimPhysics nsphys;
     nsphys.configure();
@@ -144,12 +166,12 @@ TEST_CASE("Drag pressure", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(0.).tice(tice);
     data.setTimestep(86400.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 0;
-    data.incomingShortwave() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(0);
+    data.setIncomingShortwave(0);
 
     NextsimPhysics nsphys;
 
@@ -209,13 +231,13 @@ TEST_CASE("Melting conditions", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(hsnow).tice(tice);
     data.setTimestep(600.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 330;
-    data.incomingShortwave() = 50;
-    data.snowfall() = 0;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(330);
+    data.setIncomingShortwave(50);
+    data.setSnowfall(0);
 
     data.windSpeed() = 5;
 
@@ -278,13 +300,13 @@ TEST_CASE("Freezing conditions", "[NextsimPhysics]")
     data = PrognosticGenerator().hice(hice).cice(cice).sst(sst).sss(sss).hsnow(hsnow).tice(tice);
     data.setTimestep(600.); // s. Very long TS to get below freezing
 
-    data.airTemperature() = tair;
-    data.dewPoint2m() = tdew;
-    data.airPressure() = pair;
-    data.mixedLayerDepth() = dml;
-    data.incomingLongwave() = 265;
-    data.incomingShortwave() = 0;
-    data.snowfall() = 1e-3;
+    data.setAirTemperature(tair);
+    data.setDewPoint2m(tdew);
+    data.setAirPressure(pair);
+    data.setMixedLayerDepth(dml);
+    data.setIncomingLongwave(265);
+    data.setIncomingShortwave(0);
+    data.setSnowfall(1e-3);
 
     data.windSpeed() = 5;
 
@@ -310,4 +332,363 @@ TEST_CASE("Freezing conditions", "[NextsimPhysics]")
 
 
 }
+TEST_CASE("Multi-layer thermodynamics", "[NextsimPhysics]")
+{
+    Configurator::clear();
+    std::stringstream config;
+    config << "[Modules]" << std::endl;
+    config << "Nextsim::IFreezingPoint = Nextsim::UnescoFreezing" << std::endl;
+    config << "Nextsim::IThermodynamics = Nextsim::ThermoIceN" << std::endl;
+
+    std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+    Configurator::addStream(std::move(pcstream));
+
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+
+    // Surface temperature and two ice layers
+    const int nLayers = 3;
+    const double sss = 32; // PSU
+    const std::vector<double> hice = { 0.5, 1.0, 2.0, 0.25, 0.8 }; // m
+    const std::vector<double> hsnow = { 0., 0.1, 0.2, 0.05, 0. }; // m
+    // Full ice cover, so that there is no lateral growth
+    const double cice = 1.;
+
+    // An ocean at the freezing point, so that there is no ocean heat flux
+    ElementData probe;
+    probe.configure();
+    probe = PrognosticGenerator().sss(sss);
+    const double sst = probe.freezingPoint(); //˚C
+
+    // Two identical sets of elements, one calculated element by element and
+    // one calculated as a batch
+    std::vector<ElementData> single;
+    std::vector<ElementData> batch;
+    for (std::size_t i = 0; i < hice.size(); ++i) {
+        for (auto dataSet : { &single, &batch }) {
+            dataSet->emplace_back(nLayers);
+            ElementData& data = dataSet->back();
+            data.configure();
+            data = PrognosticGenerator()
+                       .hice(hice[i] * cice)
+                       .cice(cice)
+                       .sst(sst)
+                       .sss(sss)
+                       .hsnow(hsnow[i] * cice)
+                       .tice({ -20., -12., -4. });
+            data.setAirTemperature(-25);
+            data.setDewPoint2m(-26);
+            data.setAirPressure(101000);
+            data.setMixedLayerDepth(10);
+            data.setIncomingLongwave(180);
+            data.setIncomingShortwave(0);
+            data.setSnowfall(0);
+            data.windSpeed() = 5;
+        }
+    }
+    ModelContext::defaultContext().setTimestep(3600.);
+
+    std::vector<IPhysics1d::Column> columns;
+    for (std::size_t i = 0; i < hice.size(); ++i) {
+        single[i].updateDerivedData(single[i], single[i], single[i]);
+        single[i].calculate(single[i], single[i], single[i]);
+
+        batch[i].updateDerivedData(batch[i], batch[i], batch[i]);
+        columns.push_back(batch[i].physicsColumn());
+    }
+    columns.front().impl->calculate(columns);
+
+    for (std::size_t i = 0; i < hice.size(); ++i) {
+        REQUIRE(single[i].updatedIceTrueThickness()
+            == Approx(batch[i].updatedIceTrueThickness()).epsilon(1e-12));
+        REQUIRE(single[i].updatedSnowTrueThickness()
+            == Approx(batch[i].updatedSnowTrueThickness()).epsilon(1e-12));
+        for (int k = 0; k < nLayers; ++k) {
+            REQUIRE(single[i].updatedIceTemperatures()[k]
+                == Approx(batch[i].updatedIceTemperatures()[k]).epsilon(1e-12));
+        }
+
+        // In cold conditions, the ice grows and is colder at the top
+        const std::vector<double>& tice = batch[i].updatedIceTemperatures();
+        REQUIRE(batch[i].updatedIceTrueThickness() > hice[i]);
+        REQUIRE(tice[0] < tice[1]);
+        REQUIRE(tice[1] < tice[2]);
+        REQUIRE(tice[2] < batch[i].freezingPoint());
+    }
+
+    // Warm conditions melt the snow at the surface
+    ElementData& data = single[1];
+    data = PrognosticGenerator()
+               .hice(hice[1] * cice)
+               .cice(cice)
+               .sst(sst)
+               .sss(sss)
+               .hsnow(hsnow[1] * cice)
+               .tice({ -1., -1., -1. });
+    data.setAirTemperature(5);
+    data.setDewPoint2m(4);
+    data.setIncomingLongwave(330);
+    data.setIncomingShortwave(300);
+    data.updateDerivedData(data, data, data);
+    data.calculate(data, data, data);
+    REQUIRE(data.updatedIceSurfaceTemperature() == 0.);
+    REQUIRE(data.updatedSnowTrueThickness() < hsnow[1]);
+}
+
+TEST_CASE("Conservation in the ice layers", "[NextsimPhysics]")
+{
+    typedef ThermoIceN::Section Section;
+    const double tMelt = -Water::mu * Ice::s;
+
+    // Remapping uneven sections onto equal layers conserves the thickness and
+    // the heat content, and keeps each layer within the range of the sections
+    const std::vector<Section> sections
+        = { { 0.1, -10. }, { 0.3, -5. }, { 0.05, -2. }, { 0.6, -1.8 } };
+    double thickness = 0;
+    double heat = 0;
+    for (auto& section : sections) {
+        thickness += section.thickness;
+        heat += section.thickness * section.temperature;
+    }
+    std::vector<double> layers(3);
+    ThermoIceN::remapLayers(sections, layers);
+    double remappedHeat = 0;
+    for (double temperature : layers) {
+        remappedHeat += thickness / layers.size() * temperature;
+        REQUIRE(temperature >= -10.);
+        REQUIRE(temperature <= -1.8);
+    }
+    REQUIRE(remappedHeat == Approx(heat).epsilon(1e-12));
+    REQUIRE(layers[0] < layers[1]);
+    REQUIRE(layers[1] < layers[2]);
+
+    // Melting inside the ice conserves the enthalpy, with the melt water at
+    // the melting point, and leaves no ice above the melting point
+    std::vector<Section> warm = { { 0.5, -1. }, { 0.5, tMelt + 0.5 }, { 0.2, tMelt + 5. } };
+    auto enthalpy = [tMelt](const std::vector<Section>& column, double melted) {
+        double total = Ice::rho * melted * Water::Lf;
+        for (auto& section : column) {
+            total += Ice::rho * section.thickness * Ice::cp * (section.temperature - tMelt);
+        }
+        return total;
+    };
+    double before = enthalpy(warm, 0);
+    double melted = ThermoIceN::meltInterior(warm);
+    REQUIRE(melted > 0);
+    REQUIRE(enthalpy(warm, melted) == Approx(before).epsilon(1e-12));
+    REQUIRE(warm[0].temperature == -1.);
+    REQUIRE(warm[0].thickness == 0.5);
+    REQUIRE(warm[1].temperature == tMelt);
+    REQUIRE(warm[2].temperature == tMelt);
+
+    // A section cannot melt more than its thickness
+    std::vector<Section> hot = { { 0.1, tMelt + 1000. } };
+    REQUIRE(ThermoIceN::meltInterior(hot) == 0.1);
+    REQUIRE(hot[0].thickness == 0.);
+}
+
+// Calculates the same elements of the given model with the modular and the
+// fused kernels, and requires the results to be identical
+void requireFusedEqualsModular(ModelContext& context)
+{
+    Configurator::clear();
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+
+    ElementData probe(1, context);
+    probe.configure();
+    REQUIRE(probe.physicsColumn().impl->hasFusedKernel());
+
+    // Open water that freezes, growing and melting ice with and without
+    // snow, and ice thin enough to melt completely
+    const std::vector<double> hice = { 0., 0.5, 1.0, 0.0035, 0.3, 2.0 }; // m
+    const std::vector<double> cice = { 0., 0.5, 0.9, 0.3, 1.0, 0.95 };
+    const std::vector<double> hsnow = { 0., 0.05, 0.1, 0., 0.02, 0.3 }; // m
+    const std::vector<double> tair = { -30., -20., 5., 10., -2., 0. }; // ˚C
+    // The open water starts at the freezing point
+    probe = PrognosticGenerator().sss(32.);
+    const std::vector<double> sst = { probe.freezingPoint(), -1.5, -1.5, -1.5, -1.5, -1.5 }; // ˚C
+
+    std::vector<ElementData> modular;
+    std::vector<ElementData> fused;
+    for (std::size_t i = 0; i < hice.size(); ++i) {
+        for (auto dataSet : { &modular, &fused }) {
+            dataSet->emplace_back(1, context);
+            ElementData& data = dataSet->back();
+            data = PrognosticGenerator()
+                       .hice(hice[i])
+                       .cice(cice[i])
+                       .sst(sst[i])
+                       .sss(32.)
+                       .hsnow(hsnow[i])
+                       .tice({ std::min(tair[i], -1.) });
+            data.setAirTemperature(tair[i]);
+            data.setDewPoint2m(tair[i] - 1);
+            data.setAirPressure(101000);
+            data.setMixedLayerDepth(10);
+            data.setIncomingLongwave(250);
+            data.setIncomingShortwave(100);
+            data.setSnowfall(1e-5);
+            data.windSpeed() = 5;
+        }
+    }
+    context.setTimestep(3600.);
+
+    std::vector<IPhysics1d::Column> modularColumns;
+    std::vector<IPhysics1d::Column> fusedColumns;
+    for (std::size_t i = 0; i < hice.size(); ++i) {
+        modular[i].updateDerivedData(modular[i], modular[i], modular[i]);
+        modularColumns.push_back(modular[i].physicsColumn());
+        fusedColumns.push_back(fused[i].physicsColumn());
+    }
+    modularColumns.front().impl->calculate(modularColumns);
+    fusedColumns.front().impl->calculateFused(fusedColumns);
+
+    // The same calculation, so the results are identical
+    for (std::size_t i = 0; i < hice.size(); ++i) {
+        REQUIRE(fused[i].updatedIceConcentration() == modular[i].updatedIceConcentration());
+        REQUIRE(fused[i].updatedIceTrueThickness() == modular[i].updatedIceTrueThickness());
+        REQUIRE(fused[i].updatedSnowTrueThickness() == modular[i].updatedSnowTrueThickness());
+        REQUIRE(fused[i].updatedIceSurfaceTemperature()
+            == modular[i].updatedIceSurfaceTemperature());
+        REQUIRE(fused[i].oceanHeatFlux() == modular[i].oceanHeatFlux());
+        REQUIRE(fused[i].dragPressure() == modular[i].dragPressure());
+        // The fluxes passed to a coupled ocean
+        REQUIRE(fused[i].iceOceanHeatFlux() == modular[i].iceOceanHeatFlux());
+        REQUIRE(fused[i].evaporationRate() == modular[i].evaporationRate());
+        REQUIRE(fused[i].newIceThickness() == modular[i].newIceThickness());
+        // The intermediate values held by the instances
+        const NextsimPhysics& nsphys
+            = dynamic_cast<const NextsimPhysics&>(*modular[i].physicsColumn().impl);
+        const NextsimPhysics& fusedPhys
+            = dynamic_cast<const NextsimPhysics&>(*fused[i].physicsColumn().impl);
+        REQUIRE(modular[i].iceOceanHeatFlux() == nsphys.QIceOceanHeat());
+        REQUIRE(modular[i].newIceThickness() == nsphys.newIce());
+        REQUIRE(fusedPhys.QIceOceanHeat() == nsphys.QIceOceanHeat());
+        REQUIRE(fusedPhys.newIce() == nsphys.newIce());
+        REQUIRE(fusedPhys.totalIceFromSnow() == nsphys.totalIceFromSnow());
+    }
+    REQUIRE(fused[0].newIceThickness() > 0);
+    // The open water element forms new ice and the thin ice melts completely
+    REQUIRE(fused[0].updatedIceConcentration() > 0);
+    REQUIRE(fused[3].updatedIceConcentration() == 0);
+}
+
+TEST_CASE("Fused column kernel", "[NextsimPhysics]")
+{
+    requireFusedEqualsModular(ModelContext::defaultContext());
+}
+
+TEST_CASE("Reproducible fused column kernel", "[NextsimPhysics]")
+{
+    ModelContext reproducibleModel;
+    reproducibleModel.setReproducible(true);
+    requireFusedEqualsModular(reproducibleModel);
+    // The setting of the model applies only within its calculations
+    REQUIRE(!Reproducibility::isEnabled());
+    REQUIRE(!ModelContext::defaultContext().reproducible());
+}
+
+TEST_CASE("Block albedo", "[NextsimPhysics]")
+{
+    const std::vector<double> temperature = { -20., -5., -1.5, -1., -0.5, 0., -2., -1.2 };
+    const std::vector<double> snowThickness = { 0., 0.01, 0.05, 0.1, 0.2, 0.3, 0., 1. };
+    const std::size_t n = temperature.size();
+
+    SMUIceAlbedo smu;
+    SMU2IceAlbedo smu2;
+    CCSMIceAlbedo ccsm;
+    for (IIceAlbedo* scheme : std::vector<IIceAlbedo*>({ &smu, &smu2, &ccsm })) {
+        std::vector<double> albedo(n);
+        scheme->blockAlbedo(temperature.data(), snowThickness.data(), albedo.data(), n);
+        // The block calculation gives the same values as the single values
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(albedo[i] == scheme->albedo(temperature[i], snowThickness[i]));
+        }
+    }
+}
+
+TEST_CASE("Independent model contexts", "[NextsimPhysics]")
+{
+    // Configures the context of a model with the given freezing point and minimum thickness
+    auto configureModel = [](ModelContext& context, const std::string& freezer, double minThck) {
+        Configurator::clearStreams();
+        std::stringstream config;
+        config << "[Modules]" << std::endl;
+        config << "Nextsim::IFreezingPoint = " << freezer << std::endl;
+        config << "[nextsim_thermo]" << std::endl;
+        config << "min_thick = " << minThck << std::endl;
+        std::unique_ptr<std::istream> pcstream(new std::stringstream(config.str()));
+        Configurator::addStream(std::move(pcstream));
+
+        ModuleLoader::getLoader().setAllDefaults();
+        ConfiguredModule::parseConfigurator();
+        ElementData configureMe(1, context);
+        configureMe.configure();
+    };
+
+    // The models are configured one after another
+    ModelContext linearModel;
+    ModelContext unescoModel;
+    configureModel(linearModel, "Nextsim::LinearFreezing", 0.02);
+    configureModel(unescoModel, "Nextsim::UnescoFreezing", 0.05);
+
+    std::vector<ElementData> elements;
+    elements.emplace_back(3, linearModel);
+    elements.emplace_back(3, unescoModel);
+    for (auto& data : elements) {
+        data = PrognosticGenerator().hice(0.1).cice(0.5).sst(-1.5).sss(32).hsnow(0.).tice(
+            { -2., -2., -2. });
+        data.setAirTemperature(-3);
+        data.setDewPoint2m(0.1);
+        data.setAirPressure(100000);
+        data.setMixedLayerDepth(10);
+        data.setIncomingLongwave(0);
+        data.setIncomingShortwave(0);
+        data.setSnowfall(0);
+        data.windSpeed() = 5;
+    }
+    linearModel.setTimestep(86400.);
+    unescoModel.setTimestep(3600.);
+
+    // Each element has the configuration of its own model
+    REQUIRE(elements[0].timestep() == 86400.);
+    REQUIRE(elements[1].timestep() == 3600.);
+    REQUIRE(elements[0].freezingPoint() == -Water::mu * 32);
+    REQUIRE(elements[1].freezingPoint() != elements[0].freezingPoint());
+    auto physics = [&elements](int i) {
+        return static_cast<const NextsimPhysics*>(elements[i].physicsColumn().impl);
+    };
+    REQUIRE(physics(0)->minimumIceThickness() == 0.02);
+    REQUIRE(physics(1)->minimumIceThickness() == 0.05);
+
+    // Calculating the models concurrently gives the same results as one after another
+    std::vector<ElementData> serial(elements);
+    for (auto& data : serial) {
+        data.updateDerivedData(data, data, data);
+        data.calculate(data, data, data);
+    }
+    std::vector<std::thread> threads;
+    for (auto& data : elements) {
+        threads.emplace_back([&data]() {
+            data.updateDerivedData(data, data, data);
+            data.calculate(data, data, data);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+        REQUIRE(elements[i].updatedIceTrueThickness() == serial[i].updatedIceTrueThickness());
+        REQUIRE(elements[i].updatedIceConcentration() == serial[i].updatedIceConcentration());
+        REQUIRE(elements[i].updatedIceSurfaceTemperature()
+            == serial[i].updatedIceSurfaceTemperature());
+    }
+    // The longer timestep of the first model forms more new ice
+    REQUIRE(physics(0)->newIce() > physics(1)->newIce());
+
+    Configurator::clearStreams();
+    ModuleLoader::getLoader().setAllDefaults();
+}
+
 } /* namespace Nextsim */
@@ -0,0 +1,74 @@
+/*!
+ * @file TridiagonalSolver_test.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "include/TridiagonalSolver.hpp"
+
+#include <vector>
+
+namespace Nextsim {
+
+TEST_CASE("Single system", "[TridiagonalSolver]")
+{
+    // The second difference operator, with the solution x = (1, 2, 3)
+    TridiagonalBatch system(3, 1);
+    for (int k = 0; k < 3; ++k) {
+        system.lower(k, 0) = -1;
+        system.diag(k, 0) = 2;
+        system.upper(k, 0) = -1;
+    }
+    system.rhs(0, 0) = 0;
+    system.rhs(1, 0) = 0;
+    system.rhs(2, 0) = 4;
+
+    system.solve();
+    REQUIRE(system.solution(0, 0) == Approx(1.));
+    REQUIRE(system.solution(1, 0) == Approx(2.));
+    REQUIRE(system.solution(2, 0) == Approx(3.));
+}
+
+TEST_CASE("Batch of systems", "[TridiagonalSolver]")
+{
+    const int nRows = 5;
+    const int nColumns = 37;
+    TridiagonalBatch system(nRows, nColumns);
+
+    // Diagonally dominant systems with different coefficients in each column,
+    // each with the known solution x(k) = k - i / 10
+    std::vector<double> a(nRows * nColumns);
+    std::vector<double> b(nRows * nColumns);
+    std::vector<double> c(nRows * nColumns);
+    auto x = [](int k, int i) { return k - 0.1 * i; };
+    for (int k = 0; k < nRows; ++k) {
+        for (int i = 0; i < nColumns; ++i) {
+            int ii = k * nColumns + i;
+            a[ii] = (k > 0) ? -1. - 0.01 * i : 0;
+            c[ii] = (k < nRows - 1) ? -0.5 - 0.02 * k : 0;
+            b[ii] = 3. + 0.1 * i;
+            system.lower(k, i) = a[ii];
+            system.diag(k, i) = b[ii];
+            system.upper(k, i) = c[ii];
+            double r = b[ii] * x(k, i);
+            if (k > 0)
+                r += a[ii] * x(k - 1, i);
+            if (k < nRows - 1)
+                r += c[ii] * x(k + 1, i);
+            system.rhs(k, i) = r;
+        }
+    }
+
+    system.solve();
+    for (int k = 0; k < nRows; ++k) {
+        for (int i = 0; i < nColumns; ++i) {
+            REQUIRE(system.solution(k, i) == Approx(x(k, i)).margin(1e-12));
+        }
+    }
+}
+
+} /* namespace Nextsim */
@@ -0,0 +1,288 @@
+/*!
+ * @file NextsimModule.cpp
+ *
+ * @date Oct 19, 2026
+ * @author agent <agent@local>
+ */
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "include/Configurator.hpp"
+#include "include/ConfiguredModule.hpp"
+#include "include/DevGrid.hpp"
+#include "include/FieldRegistry.hpp"
+#include "include/Model.hpp"
+#include "include/ModuleLoader.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace Nextsim {
+
+/*!
+ * @brief The model as seen from Python.
+ *
+ * @details The fields are returned as NumPy arrays which alias the element
+ * data of the model, with the size of an element as the stride between
+ * consecutive values. The arrays hold a reference to the model, so that the
+ * memory they alias remains valid for as long as they exist. Configuring
+ * the model reallocates the element data, so the model cannot be configured
+ * while arrays from an earlier configuration exist. On a grid with a land
+ * mask, only the ocean cells have elements, and the cell of each element is
+ * given by elementCells().
+ */
+class PyModel {
+public:
+    PyModel()
+        : m_writableExternal(false)
+    {
+    }
+
+    void configure()
+    {
+        // The element data aliased by the arrays is about to be reallocated
+        checkNoArrays();
+        m_writableExternal = false;
+        m_model.configure();
+    }
+    void run() { m_model.run(); }
+    void start() { m_model.start(); }
+    int step(int nSteps)
+    {
+        // Writable arrays of the external data may have been written since
+        // the last timestep, without the data being marked as modified
+        if (m_writableExternal) {
+            IStructure& structure = checkedStructure();
+            for (structure.cursor = 0; structure.cursor; ++structure.cursor) {
+                structure.cursor->markModified();
+            }
+        }
+        // Let other Python threads run while the model calculates
+        py::gil_scoped_release release;
+        return m_model.step(nSteps);
+    }
+    void stop() { m_model.stop(); }
+    void finalize() { m_model.finalize(); }
+    py::dict drainRestart()
+    {
+        Model::RestartStatus status;
+        {
+            // Let other Python threads run while the restart file is written
+            py::gil_scoped_release release;
+            status = m_model.drainRestart();
+        }
+        py::dict result;
+        result["success"] = status.success;
+        result["file"] = status.filePath;
+        result["checksum"] = status.checksum;
+        result["error"] = status.error;
+        return result;
+    }
+    int time() const { return m_model.time(); }
+    bool finished() const { return m_model.finished(); }
+
+    static std::vector<std::string> fieldNames()
+    {
+        std::vector<std::string> names;
+        for (auto& field : FieldRegistry::fields()) {
+            names.push_back(field.name);
+        }
+        return names;
+    }
+
+    /*
+     * Returns an array aliasing the named field. Fields without layers are
+     * one dimensional, indexed by element. Layered fields are two
+     * dimensional, indexed by element and layer.
+     */
+    static py::array field(py::object self, const std::string& name, bool writable)
+    {
+        PyModel& pyModel = self.cast<PyModel&>();
+        ElementVector* storage = pyModel.checkedStructure().elementStorage();
+        if (!storage) {
+            throw std::runtime_error(
+                "The data structure of the model does not hold its elements contiguously");
+        }
+        const FieldRegistry::Field& description = FieldRegistry::field(name);
+
+        double* base;
+        std::size_t size;
+        int nLayers;
+        if (writable) {
+            FieldView<double> view = FieldRegistry::mutableView(*storage, name);
+            base = view.data();
+            size = view.size();
+            nLayers = view.nLayers();
+            if (description.group == FieldRegistry::Group::EXTERNAL)
+                pyModel.m_writableExternal = true;
+        } else {
+            FieldView<const double> view = FieldRegistry::view(*storage, name);
+            base = const_cast<double*>(view.data());
+            size = view.size();
+            nLayers = view.nLayers();
+        }
+
+        std::vector<py::ssize_t> shape = { static_cast<py::ssize_t>(size) };
+        std::vector<py::ssize_t> strides = { sizeof(ElementData) };
+        if (description.dimensions == FieldRegistry::Dimensions::LAYERED) {
+            shape.push_back(nLayers);
+            strides.push_back(sizeof(double));
+        }
+        // The model is the base object of the array, which is not copied
+        py::array_t<double> array(shape, strides, base, self);
+        if (!writable)
+            array.attr("setflags")(py::arg("write") = false);
+        // Forget the arrays which no longer exist, then track the new one
+        std::vector<py::weakref>& arrays = pyModel.m_arrays;
+        arrays.erase(std::remove_if(arrays.begin(), arrays.end(),
+                         [](const py::weakref& ref) { return ref().is_none(); }),
+            arrays.end());
+        arrays.push_back(py::weakref(array));
+        return array;
+    }
+
+    /*
+     * Returns the cell of each element in the rows of the grid held by this
+     * process, indexed by x then y, so that the field of an element is placed
+     * in the grid by its cell.
+     */
+    py::array_t<std::int64_t> elementCells()
+    {
+        const LandMask& mask = checkedMask();
+        py::array_t<std::int64_t> cells(static_cast<py::ssize_t>(mask.nOcean()));
+        std::int64_t* out = cells.mutable_data();
+        for (std::size_t element = 0; element < mask.nOcean(); ++element) {
+            out[element] = mask.cell(element);
+        }
+        return cells;
+    }
+
+    // Returns the mask of the rows held, 1 for ocean and 0 for land, indexed by x then y
+    py::array_t<int> oceanMask()
+    {
+        const LandMask& mask = checkedMask();
+        std::vector<int> values = mask.values();
+        py::array_t<int> array(std::vector<py::ssize_t> { mask.nxLocal(), mask.ny() });
+        std::copy(values.begin(), values.end(), array.mutable_data());
+        return array;
+    }
+
+    // Returns the x index of the first row of the grid held by this process
+    int xStart() { return checkedGrid().xStart(); }
+
+private:
+    /*
+     * Throws if any array returned by field() still exists. Views of an array
+     * keep it alive, so they are included.
+     */
+    void checkNoArrays()
+    {
+        for (auto& ref : m_arrays) {
+            if (!ref().is_none()) {
+                throw std::runtime_error("The model cannot be configured while arrays returned "
+                                         "by field() exist, as they alias the element data. "
+                                         "Delete them and fetch new arrays after configuring.");
+            }
+        }
+        m_arrays.clear();
+    }
+
+    const DevGrid& checkedGrid()
+    {
+        const DevGrid* grid = dynamic_cast<const DevGrid*>(&checkedStructure());
+        if (!grid) {
+            throw std::runtime_error("The data structure of the model is not a grid");
+        }
+        return *grid;
+    }
+    const LandMask& checkedMask() { return checkedGrid().landMask(); }
+
+    IStructure& checkedStructure()
+    {
+        IStructure* structure = m_model.structure();
+        if (!structure) {
+            throw std::runtime_error("The model has not been configured");
+        }
+        return *structure;
+    }
+
+    Model m_model;
+    bool m_writableExternal;
+    // Weak references to the arrays returned by field()
+    std::vector<py::weakref> m_arrays;
+};
+
+/*
+ * Sets the configuration from files and text in the format of the config
+ * files, and loads the configured modules, as done by main().
+ */
+static void configureFromSources(const std::vector<std::string>& files, const std::string& text)
+{
+    Configurator::clear();
+    Configurator::addFiles(files);
+    if (!text.empty()) {
+        Configurator::addStream(std::unique_ptr<std::istream>(new std::stringstream(text)));
+    }
+    ModuleLoader::getLoader().setAllDefaults();
+    ConfiguredModule::parseConfigurator();
+}
+
+} /* namespace Nextsim */
+
+PYBIND11_MODULE(pynextsim, m)
+{
+    using Nextsim::PyModel;
+
+    m.doc() = "Runs the neXtSIM_DG model step by step, with the model fields as NumPy arrays "
+              "aliasing the model memory.";
+
+    m.def("configure", &Nextsim::configureFromSources,
+        py::arg("files") = std::vector<std::string>(), py::arg("text") = std::string(),
+        "Sets the configuration from config files and config text, and loads the configured "
+        "modules. Call before configuring a Model.");
+    m.def("field_names", &PyModel::fieldNames, "The names of the registered model fields.");
+
+    py::class_<PyModel>(m, "Model")
+        .def(py::init<>())
+        .def("configure", &PyModel::configure,
+            "Applies the configuration and initializes the model data. Raises RuntimeError if "
+            "arrays returned by field() still exist, as the model data is reallocated.")
+        .def("run", &PyModel::run, "Runs the model from the start to the stop time.")
+        .def("start", &PyModel::start, "Starts a run, which is then advanced by step().")
+        .def("step", &PyModel::step, py::arg("n") = 1,
+            "Advances the run by n timesteps, or to the stop time. Returns the number of "
+            "timesteps performed.")
+        .def("stop", &PyModel::stop, "Stops the run.")
+        .def("finalize", &PyModel::finalize,
+            "Starts writing the restart file in the background from a snapshot of the model "
+            "state.")
+        .def("drain_restart", &PyModel::drainRestart,
+            "Waits for the restart file started by finalize(). Returns a dict of success, "
+            "file, checksum and error.")
+        .def_property_readonly("time", &PyModel::time, "The model time reached by the run.")
+        .def_property_readonly(
+            "finished", &PyModel::finished, "Whether the run has reached the stop time.")
+        .def("field", &PyModel::field, py::arg("name"), py::arg("writable") = false,
+            "Returns a NumPy array aliasing the named field of all the elements, without "
+            "copying. Layered fields have a second dimension of the ice layers. The array is "
+            "read-only unless writable is True. On a grid with a land mask, only the ocean "
+            "cells have elements, placed in the grid by element_cells().")
+        .def("element_cells", &PyModel::elementCells,
+            "Returns the cell of each element in the rows of the grid held by this process, "
+            "indexed by x then y, so that grid.flat[model.element_cells()] = model.field(name) "
+            "places a field in a grid of the shape of ocean_mask().")
+        .def("ocean_mask", &PyModel::oceanMask,
+            "Returns the land mask of the rows of the grid held by this process, 1 for ocean "
+            "and 0 for land, with the shape of the rows and the cells of each row.")
+        .def_property_readonly("x_start", &PyModel::xStart,
+            "The x index of the first row of the grid held by this process.");
+}
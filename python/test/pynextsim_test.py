@@ -0,0 +1,60 @@
+# Smoke test of the pynextsim module. Runs the dev1 configuration step by
+# step and checks that the field arrays follow the model data.
+#
+# Usage: python3 pynextsim_test.py <module directory> <run directory>
+import os
+import sys
+import unittest
+
+sys.path.insert(0, sys.argv[1])
+RUN_DIR = sys.argv[2]
+
+import numpy
+import pynextsim
+
+CONFIG = """[model]
+init_file = {}
+start = 0
+stop = 2
+time_step = 1
+""".format(os.path.join(RUN_DIR, "dev1.res.nc"))
+
+
+class PyNextsimTest(unittest.TestCase):
+    def setUp(self):
+        pynextsim.configure(text=CONFIG)
+        self.model = pynextsim.Model()
+        self.model.configure()
+
+    def test_fields_alias_the_model(self):
+        hice = self.model.field("hice")
+        self.assertEqual(hice.shape, self.model.element_cells().shape)
+        self.assertFalse(hice.flags.writeable)
+        with self.assertRaises(ValueError):
+            hice[0] = 1.
+        self.model.start()
+        while not self.model.finished:
+            self.model.step()
+            numpy.testing.assert_array_equal(hice, self.model.field("hice"))
+        self.model.stop()
+
+    def test_writable_fields(self):
+        hsnow = self.model.field("hsnow", writable=True)
+        hsnow[:] = 0.
+        self.assertEqual(self.model.field("hsnow").max(), 0.)
+
+    def test_reconfigure_with_live_arrays(self):
+        hice = self.model.field("hice")
+        first_row = hice[:1]
+        del hice
+        # A view keeps the array, and so the old element data, in use
+        with self.assertRaises(RuntimeError):
+            self.model.configure()
+        del first_row
+        self.model.configure()
+        hice = self.model.field("hice")
+        self.assertTrue(numpy.all(numpy.isfinite(hice)))
+
+
+if __name__ == "__main__":
+    unittest.main(argv=sys.argv[:1])
@@ -0,0 +1,23 @@
+# Runs the dev1 configuration step by step, printing the mean ice state
+# between the timesteps without writing any files. Copy or link the
+# pynextsim module here from a build configured with -DENABLE_PYTHON=ON.
+import numpy
+import pynextsim
+
+pynextsim.configure(["dev1.cfg"])
+model = pynextsim.Model()
+model.configure()
+# The arrays alias the model memory, so they follow the model state
+hice = model.field("hice")
+cice = model.field("cice")
+tice = model.field("tice")
+model.start()
+while not model.finished:
+    model.step()
+    print(model.time, hice.mean(), cice.mean(), tice[:, 0].min())
+model.stop()
+# With a land mask, the fields hold only the ocean cells, which are placed
+# in the grid by their cells
+gridded = numpy.full(model.ocean_mask().shape, numpy.nan)
+gridded.flat[model.element_cells()] = hice
+print(gridded)